@@ -6,11 +6,17 @@
 #include <Wire.h>
 #include <string>
 
+#include "src/SparkBenchmark.h"
 #include "src/SparkButtonHandler.h"
+#include "src/SparkCaptureReplay.h"
 #include "src/SparkDataControl.h"
 #include "src/SparkDisplayControl.h"
+#include "src/SparkHeapAudit.h"
 #include "src/SparkLEDControl.h"
+#include "src/SparkLatencyTrace.h"
+#include "src/SparkLoopProfiler.h"
 #include "src/SparkPresetControl.h"
+#include "src/SparkSoakTest.h"
 
 using namespace std;
 
@@ -43,6 +49,7 @@ void setup() {
     Serial.begin(115200);
     while (!Serial)
         ;
+    SPARK_LOG.begin();
 
     Serial.println("Initializing");
     if (!LittleFS.begin(true)) {
@@ -77,12 +84,90 @@ void setup() {
     spark_bh.setDataControl(&spark_dc);
     // Initializing control classes
     spark_led.setDataControl(&spark_dc);
+    SparkCaptureReplay::getInstance().setPacketHandler(SparkDataControl::processReplayedData,
+                                                       SparkDataControl::isTransportConnected);
 
     Serial.println("Initialization done.");
+    if (operationMode != SPARK_MODE_APP) {
+        // No handshake with an amp needed
+        HEAP_AUDIT_STEADY_STATE();
+    }
+#ifdef BENCHMARK_FIRMWARE
+    SparkBenchmark::getInstance().runAll(&sparkDisplay, &spark_led);
+#endif
+    SOAK_TEST_BEGIN();
+}
+
+// Diagnostic reports and protocol capture on request
+void processSerialCommands() {
+    while (Serial.available() > 0) {
+        switch (Serial.read()) {
+        case 'c':
+            SparkCapture::getInstance().setEnabled(!SparkCapture::getInstance().isEnabled());
+            Serial.printf("Capture %s\n", SparkCapture::getInstance().isEnabled() ? "on" : "off");
+            break;
+        case 'd':
+            SparkCapture::getInstance().dump();
+            break;
+        case 'w':
+            SparkCapture::getInstance().save();
+            break;
+        case 'r':
+            if (SparkCaptureReplay::getInstance().load()) {
+                SparkCaptureReplay::getInstance().start(REPLAY_REAL_TIME);
+            }
+            break;
+        case 'R':
+            if (SparkCaptureReplay::getInstance().load()) {
+                SparkCaptureReplay::getInstance().start(REPLAY_FULL_SPEED);
+            }
+            break;
+        case 'o':
+            sparkDisplay.reportStats();
+            break;
+#ifdef PROFILE_LOOP
+        case 'p':
+            SparkLoopProfiler::getInstance().requestReport();
+            break;
+#endif
+#ifdef TRACE_LATENCY
+        case 't':
+            SparkLatencyTrace::getInstance().dump();
+            break;
+#endif
+#ifdef BENCHMARK
+        case 'b':
+#ifdef BENCHMARK_FIRMWARE
+            SparkBenchmark::getInstance().runAll(&sparkDisplay, &spark_led);
+#else
+            SparkBenchmark::getInstance().runAll();
+#endif
+            break;
+#endif
+#ifdef SOAK_TEST
+        case 'k':
+            SparkSoakTest::getInstance().report();
+            break;
+#endif
+#ifdef SIMULATE_AMP
+        case 's':
+            SparkAmpSimulator::getInstance().report();
+            break;
+#endif
+        default:
+            break;
+        }
+    }
 }
 
 void loop() {
 
+#ifdef BENCHMARK_FIRMWARE
+    // Benchmarks run on boot, only repeated on request
+    processSerialCommands();
+    return;
+#endif
+
     // Methods to call only in APP mode
     if (operationMode == SPARK_MODE_APP) {
         while (!(spark_dc.checkBLEConnection())) {
@@ -102,23 +187,41 @@ void loop() {
             // delay(100);
             // spark_dc.getCurrentPresetFromSpark();
             spark_dc.isInitBoot() = false;
+            HEAP_AUDIT_STEADY_STATE();
             // spark_dc.configureLooper();
         }
     }
 
+    PROFILE_LOOP_BEGIN();
     // Check if presets have been updated (not needed in Keyboard mode)
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DATA);
     if (operationMode != SPARK_MODE_KEYBOARD) {
+        SparkCaptureReplay::getInstance().update();
         spark_dc.checkForUpdates();
+        SOAK_TEST_UPDATE(spark_dc);
     }
+    PROFILE_STAGE_END(LOOP_STAGE_UPDATES);
     // Reading button input
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_BUTTONS);
     spark_bh.configureButtons();
     spark_bh.readButtons();
+    PROFILE_STAGE_END(LOOP_STAGE_BUTTONS);
 #ifdef ENABLE_BATTERY_STATUS_INDICATOR
     // Update battery level
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DATA);
     spark_dc.updateBatteryLevel();
+    PROFILE_STAGE_END(LOOP_STAGE_BATTERY);
 #endif
     // Update LED status
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_LEDS);
     spark_led.updateLEDs();
+    PROFILE_STAGE_END(LOOP_STAGE_LEDS);
     // Update display
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DISPLAY);
     sparkDisplay.update();
+    PROFILE_STAGE_END(LOOP_STAGE_DISPLAY);
+
+    PROFILE_LOOP_END();
+    HEAP_AUDIT_REPORT();
+    processSerialCommands();
 }
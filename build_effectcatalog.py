@@ -0,0 +1,138 @@
+import csv
+import glob
+import json
+import os
+
+try:
+    Import("env")
+except NameError:
+    # Script can also be run without PlatformIO: python3 build_effectcatalog.py
+    env = None
+
+referenceFile = "reference/EffectReference.csv"
+outputFile = "src/SparkEffectCatalog.h"
+# Presets shipped with the firmware, some effects have more parameters than the reference lists
+presetFiles = "data/*.json"
+
+
+# Maps the effect type of the reference to the pedal slot in a preset (FxType)
+fxTypes = {
+    "Noise Gate": "INDEX_FX_NOISEGATE",
+    "Compressor": "INDEX_FX_COMP",
+    "Drive": "INDEX_FX_DRIVE",
+    "Amp": "INDEX_FX_AMP",
+    "Modulation": "INDEX_FX_MOD",
+    "Delay": "INDEX_FX_DELAY",
+    "Reverb": "INDEX_FX_REVERB",
+}
+
+numberOfParameterColumns = 7
+
+
+def read_effects(fileName):
+    effects = {}
+    with open(fileName, newline='') as csvFile:
+        for row in csv.DictReader(csvFile):
+            name = row['Technical Name'].strip()
+            if not name:
+                continue
+            effectType = row['Type'].strip()
+            if effectType not in fxTypes:
+                print(f"ERROR: Unknown effect type {effectType} for effect {name}. Exiting.")
+                assert(0)
+            numParameters = 0
+            for i in range(numberOfParameterColumns):
+                if row['Parameter ' + str(i)].strip():
+                    numParameters = i + 1
+            if name in effects:
+                # Some effects (e.g. bias.reverb) are listed once per mode
+                if effects[name]['numParameters'] != numParameters:
+                    print(f"WARNING: Effect {name} listed with different number of parameters.")
+                # App names differ per mode then, so the effect type is used as name
+                effects[name]['appName'] = effectType
+                continue
+            effects[name] = {
+                'name': name,
+                'appName': row['App Name'].strip(),
+                'fxType': fxTypes[effectType],
+                'numParameters': numParameters,
+            }
+    # Sorted by byte order so the firmware can use binary search (strcmp)
+    return [effects[name] for name in sorted(effects)]
+
+
+def read_preset_parameters(pattern):
+    # Highest number of parameters per effect found in the presets
+    numParameters = {}
+    for fileName in sorted(glob.glob(pattern)):
+        try:
+            with open(fileName) as presetFile:
+                preset = json.load(presetFile)
+        except (ValueError, UnicodeDecodeError):
+            continue
+        if not isinstance(preset, dict):
+            continue
+        for pedal in preset.get('Pedals', []):
+            name = pedal.get('Name')
+            count = len(pedal.get('Parameters', []))
+            numParameters[name] = max(numParameters.get(name, 0), count)
+    return numParameters
+
+
+def add_preset_parameters(effects, presetParameters):
+    # The reference has 7 parameter columns, e.g. bias.reverb has 8 parameters in the presets
+    for effect in effects:
+        count = presetParameters.get(effect['name'], 0)
+        if count > effect['numParameters']:
+            print(f"Effect {effect['name']}: {count} parameters in presets, {effect['numParameters']} in reference")
+            effect['numParameters'] = count
+
+
+def write_catalog(effects, fileName):
+    maxParameters = max(effect['numParameters'] for effect in effects)
+    with open(fileName, 'w') as out:
+        out.write("/*\n")
+        out.write(" * SparkEffectCatalog.h\n")
+        out.write(" *\n")
+        out.write(" * Generated by build_effectcatalog.py from " + referenceFile + ".\n")
+        out.write(" * Do not edit manually, run the script again when the reference changes.\n")
+        out.write(" */\n\n")
+        out.write("#ifndef SPARK_EFFECT_CATALOG_H\n")
+        out.write("#define SPARK_EFFECT_CATALOG_H\n\n")
+        out.write("#include \"SparkEffects.h\"\n\n")
+        out.write("// Number of effects known from the reference, IDs 1 to NUMBER_OF_KNOWN_EFFECTS\n")
+        out.write("constexpr int NUMBER_OF_KNOWN_EFFECTS = " + str(len(effects)) + ";\n")
+        out.write("// Highest number of parameters of a known effect, see MAX_PEDAL_PARAMETERS\n")
+        out.write("constexpr int MAX_KNOWN_EFFECT_PARAMETERS = " + str(maxParameters) + ";\n\n")
+        out.write("// Known effects, sorted by technical name to allow binary search.\n")
+        out.write("// Index + 1 is the effect ID, 0 is used for no effect.\n")
+        out.write("constexpr SparkEffectInfo KNOWN_EFFECTS[NUMBER_OF_KNOWN_EFFECTS] = {\n")
+        for effect in effects:
+            out.write("    {\"" + effect['name'] + "\", \"" + effect['appName'] + "\", "
+                      + effect['fxType'] + ", " + str(effect['numParameters']) + "},\n")
+        out.write("};\n\n")
+        out.write("#endif\n")
+
+
+def build_effect_catalog(*args, **kwargs):
+    if not os.path.exists(referenceFile):
+        print(f"ERROR: File {referenceFile} not found. Exiting.")
+        assert(0)
+    effects = read_effects(referenceFile)
+    add_preset_parameters(effects, read_preset_parameters(presetFiles))
+    write_catalog(effects, outputFile)
+    print(f"Effect catalog with {len(effects)} effects written to {outputFile}")
+
+
+if env is not None:
+    env.AddCustomTarget(
+        name="buildeffectcatalog",
+        dependencies=None,
+        actions=[
+            build_effect_catalog
+        ],
+        title="Build effect catalog from effect reference",
+        description="Generates the effect catalog header from reference/EffectReference.csv"
+    )
+else:
+    build_effect_catalog()
@@ -0,0 +1,98 @@
+/*
+ * HostApp.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "HostApp.h"
+
+#include "SparkHeapAudit.h"
+#include "SparkLog.h"
+
+HostApp &HostApp::getInstance() {
+    static HostApp INSTANCE;
+    return INSTANCE;
+}
+
+HostApp::HostApp() : display_(new SparkDisplayControl()) {
+}
+
+void HostApp::begin(const SimulatedAmpConfig &config) {
+    hostSuppressTask("LooperTimer");
+    hostSuppressTask("HWpresets");
+    amp().configure(config);
+
+    dataControl_.init(SPARK_MODE_APP);
+    display_->setDataControl(&dataControl_);
+    dataControl_.setDisplayControl(display_);
+    display_->init(SPARK_MODE_APP);
+    leds_.setDataControl(&dataControl_);
+    lastHWPresetCheck_ = millis();
+}
+
+void HostApp::loop() {
+    if (!dataControl_.checkBLEConnection()) {
+        // Waiting for the connection
+        display_->update(dataControl_.isInitBoot());
+        leds_.updateLEDs();
+        return;
+    }
+    if (dataControl_.isInitBoot()) {
+        dataControl_.getSerialNumber();
+        dataControl_.isInitBoot() = false;
+        HEAP_AUDIT_STEADY_STATE();
+    }
+
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DATA);
+    dataControl_.checkForUpdates();
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_LEDS);
+    leds_.updateLEDs();
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DISPLAY);
+    display_->update();
+    HEAP_AUDIT_REPORT();
+    SPARK_LOG.drainNow();
+}
+
+void HostApp::step() {
+    loop();
+    SparkLooperControl::update();
+    if (millis() - lastHWPresetCheck_ >= hwPresetCheckInterval) {
+        // The task waits between the requests, the main loop goes on meanwhile
+        hostSetDelayHandler(&HostApp::runWhileTaskWaits);
+        SparkPresetControl::getInstance().getMissingHWPresets();
+        hostSetDelayHandler(nullptr);
+        lastHWPresetCheck_ = millis();
+    }
+    hostAdvanceTime(1000);
+}
+
+void HostApp::runWhileTaskWaits(unsigned long ms) {
+    // delay() in the main loop moves the clock as usual
+    hostSetDelayHandler(nullptr);
+    HostApp &app = getInstance();
+    for (unsigned long i = 0; i < ms; i++) {
+        app.loop();
+        SparkLooperControl::update();
+        hostAdvanceTime(1000);
+    }
+    hostSetDelayHandler(&HostApp::runWhileTaskWaits);
+}
+
+void HostApp::runFor(unsigned long ms) {
+    for (unsigned long i = 0; i < ms; i++) {
+        step();
+    }
+}
+
+bool HostApp::runUntilReady(unsigned long timeout) {
+    SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+    for (unsigned long i = 0; i < timeout; i++) {
+        if (!dataControl_.isInitBoot() && presetControl.allHWPresetsAvailable()
+            && !presetControl.activePreset().isEmpty) {
+            return true;
+        }
+        step();
+    }
+    return false;
+}
@@ -0,0 +1,68 @@
+/*
+ * HostApp.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_APP_H
+#define HOST_APP_H
+
+#include "SparkAmpSimulator.h"
+#include "SparkDataControl.h"
+#include "SparkDisplayControl.h"
+#include "SparkLEDControl.h"
+
+class HostApp {
+    // Ignitron in APP mode on the host
+    // --------------------------------
+    // SparkDataControl with SparkPresetControl, looper control, display and LEDs, set up
+    // and driven like setup() and loop() of Ignitron.ino do it. The transport is
+    // SparkAmpSimulator (SIMULATE_AMP), so the firmware code talks to the simulated amp
+    // through the same receive buffer and message handling as on the device.
+    // The FreeRTOS tasks of APP mode (looper timer, check for missing HW presets) loop on
+    // the clock and would run the virtual clock away as threads. They are not started,
+    // step() runs their work on the main thread instead, once per virtual millisecond. While
+    // that work waits in delay(), the main loop runs, like it does on the device.
+    // The presets are read from the file system, e.g. a copy of data/.
+    // SparkDataControl keeps its state in static members, so there is one app per process.
+
+public:
+    static HostApp &getInstance();
+
+    HostApp(const HostApp &) = delete;
+    HostApp &operator=(const HostApp &) = delete;
+
+    // setup() of Ignitron.ino in APP mode, connects the amp configured by config
+    void begin(const SimulatedAmpConfig &config);
+    // One pass of loop() of Ignitron.ino, button input excluded
+    void loop();
+    // loop() and the tasks, then the virtual clock moves on by 1 ms
+    void step();
+    void runFor(unsigned long ms);
+    // Runs until the handshake with the amp is done and all HW presets are known,
+    // returns false if this takes longer than timeout ms
+    bool runUntilReady(unsigned long timeout);
+
+    SparkDataControl &dataControl() { return dataControl_; }
+    SparkDisplayControl &display() { return *display_; }
+    SparkLEDControl &leds() { return leds_; }
+    SparkAmpSimulator &amp() { return SparkAmpSimulator::getInstance(); }
+
+private:
+    HostApp();
+
+    // Delay handler while the work of a task runs, see hostSetDelayHandler()
+    static void runWhileTaskWaits(unsigned long ms);
+
+    // Interval of the task checking for missing HW presets
+    static const unsigned long hwPresetCheckInterval = 1000;
+
+    SparkDataControl dataControl_;
+    // Deleted by SparkDataControl
+    SparkDisplayControl *display_;
+    SparkLEDControl leds_;
+    unsigned long lastHWPresetCheck_ = 0;
+};
+
+#endif
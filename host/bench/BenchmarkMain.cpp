@@ -0,0 +1,22 @@
+/*
+ * BenchmarkMain.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Arduino.h>
+
+int main(int argc, char **argv) {
+    // Log output of the code under test would be mixed into the report
+    Serial.setOutputEnabled(false);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
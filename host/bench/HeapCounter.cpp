@@ -0,0 +1,51 @@
+/*
+ * HeapCounter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "HeapCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+static std::atomic<size_t> inUse{0};
+static std::atomic<size_t> peak{0};
+
+size_t heapInUse() {
+    return inUse.load();
+}
+
+size_t heapPeak() {
+    return peak.load();
+}
+
+void resetHeapPeak() {
+    peak = inUse.load();
+}
+
+void *operator new(size_t size) {
+    void *memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    size_t current = inUse += malloc_usable_size(memory);
+    size_t previousPeak = peak.load();
+    while (current > previousPeak && !peak.compare_exchange_weak(previousPeak, current)) {
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    if (memory != nullptr) {
+        inUse -= malloc_usable_size(memory);
+        free(memory);
+    }
+}
+
+void operator delete(void *memory, size_t size) noexcept {
+    operator delete(memory);
+}
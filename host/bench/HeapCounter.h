@@ -0,0 +1,20 @@
+/*
+ * HeapCounter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_HEAP_COUNTER_H
+#define HOST_HEAP_COUNTER_H
+
+// Heap used through operator new of the benchmark binary, including the peak
+// since the last reset. Allocations of the C library (e.g. FILE buffers) are not counted.
+
+#include <cstddef>
+
+size_t heapInUse();
+size_t heapPeak();
+void resetHeapPeak();
+
+#endif
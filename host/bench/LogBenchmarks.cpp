@@ -0,0 +1,77 @@
+/*
+ * LogBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Stall of the main loop when a processed preset is logged (handleAppModeResponse),
+// with the UART model of the Serial shim (115200 baud, 128 byte FIFO):
+//   log/presetMessage/direct:    SparkLog writes straight to Serial, as before user-038
+//   log/presetMessage/buffered:  SparkLog writes to its ring buffer, which is drained
+//                                outside of the measurement
+// stall_p50_us, stall_p99_us and stall_max_us are the time of the whole logging step
+// (DurationHistogram, like SparkLoopProfiler), max_write_us the longest single write as
+// measured by SparkLog::maxWriteTime(). They include the time the UART model blocks the
+// writer, the benchmark time does not. The maximum also contains scheduling noise of the host.
+
+#include <benchmark/benchmark.h>
+
+#include "DurationHistogram.h"
+#include "HostTestSupport.h"
+#include "SparkLog.h"
+#include "SparkMessage.h"
+#include "SparkStreamReader.h"
+
+namespace {
+
+void logPresetMessage(benchmark::State &state, bool isDirect) {
+    SparkMessage sparkMessage;
+    SparkStreamReader reader;
+    for (ByteVector &block : messageBlocks(sparkMessage.changePreset(examplePreset("Logged"), DIR_FROM_SPARK, 1))) {
+        reader.processBlock(block);
+    }
+    if (!reader.hasJson()) {
+        state.SkipWithError("Preset not decoded");
+        return;
+    }
+
+    SparkLog &log = SPARK_LOG;
+    log.drainNow();
+    log.setDirect(isDirect);
+    log.resetMaxWriteTime();
+    Serial.setUartModel(true);
+    DurationHistogram stalls;
+    for (auto _ : state) {
+        unsigned long startTime = micros();
+        LOG_INFO("Message processed:\n");
+        reader.writeJson(log);
+        LOG_INFO("\n");
+        stalls.add(micros() - startTime);
+
+        state.PauseTiming();
+        log.drainNow();
+        // Rest of the loop, the UART is idle again at the next message
+        hostAdvanceTime(100000);
+        state.ResumeTiming();
+    }
+    Serial.setUartModel(false);
+    log.setDirect(false);
+    state.counters["stall_p50_us"] = stalls.percentile(50);
+    state.counters["stall_p99_us"] = stalls.percentile(99);
+    state.counters["stall_max_us"] = stalls.max();
+    state.counters["max_write_us"] = log.maxWriteTime();
+    state.counters["dropped"] = log.droppedCount();
+}
+
+void logPresetMessageDirect(benchmark::State &state) {
+    logPresetMessage(state, true);
+}
+BENCHMARK(logPresetMessageDirect)->Name("log/presetMessage/direct")->Iterations(1000);
+
+void logPresetMessageBuffered(benchmark::State &state) {
+    logPresetMessage(state, false);
+}
+BENCHMARK(logPresetMessageBuffered)->Name("log/presetMessage/buffered")->Iterations(1000);
+
+} // namespace
@@ -0,0 +1,94 @@
+/*
+ * PresetIndexBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Scaling of the preset index with the number of presets (100, 1,000 and 5,000):
+//   presetIndex/build:  first boot, the index is written from the preset list
+//   presetIndex/open:   later boots, the index is current and only opened
+//   presetIndex/getRecord, presetIndex/findUUID: lookups of random presets
+// heap_bytes is the heap held by an open index, heap_peak_bytes the maximum heap
+// used while building or opening (UUID records are sorted in RAM when building).
+
+#include <benchmark/benchmark.h>
+
+#include "HeapCounter.h"
+#include "HostTestSupport.h"
+#include "SparkPresetIndex.h"
+
+#include <memory>
+
+namespace {
+
+const char *listFileName = "/PresetList.txt";
+const char *indexFileName = "/PresetIndex.bin";
+
+// Measures the heap held by an index after build() and the peak while building
+void measureBuild(benchmark::State &state, bool isIndexCurrent) {
+    ScratchFileSystem fileSystem;
+    fileSystem.writeFile(listFileName, presetList(state.range(0)));
+    {
+        SparkPresetIndex index;
+        index.build(listFileName);
+    }
+    size_t heapBytes = 0;
+    size_t heapPeakBytes = 0;
+    for (auto _ : state) {
+        if (!isIndexCurrent) {
+            state.PauseTiming();
+            LittleFS.remove(indexFileName);
+            state.ResumeTiming();
+        }
+        size_t heapBefore = heapInUse();
+        resetHeapPeak();
+        std::unique_ptr<SparkPresetIndex> index(new SparkPresetIndex());
+        benchmark::DoNotOptimize(index->build(listFileName));
+        heapBytes = heapInUse() - heapBefore;
+        heapPeakBytes = heapPeak() - heapBefore;
+    }
+    state.counters["heap_bytes"] = heapBytes;
+    state.counters["heap_peak_bytes"] = heapPeakBytes;
+}
+
+void presetIndexBuild(benchmark::State &state) {
+    measureBuild(state, false);
+}
+BENCHMARK(presetIndexBuild)->Name("presetIndex/build")->Arg(100)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+void presetIndexOpen(benchmark::State &state) {
+    measureBuild(state, true);
+}
+BENCHMARK(presetIndexOpen)->Name("presetIndex/open")->Arg(100)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+void presetIndexGetRecord(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    fileSystem.writeFile(listFileName, presetList(state.range(0)));
+    SparkPresetIndex index;
+    index.build(listFileName);
+    PresetIndexRecord record;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.getRecord(random(state.range(0)), record));
+    }
+}
+BENCHMARK(presetIndexGetRecord)->Name("presetIndex/getRecord")->Arg(100)->Arg(1000)->Arg(5000);
+
+void presetIndexFindUUID(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    fileSystem.writeFile(listFileName, presetList(state.range(0)));
+    SparkPresetIndex index;
+    index.build(listFileName);
+    vector<string> uuids;
+    for (int i = 0; i < 64; i++) {
+        uuids.push_back(presetUUID(random(state.range(0))));
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.findUUID(uuids[next]));
+        next = (next + 1) % uuids.size();
+    }
+}
+BENCHMARK(presetIndexFindUUID)->Name("presetIndex/findUUID")->Arg(100)->Arg(1000)->Arg(5000);
+
+} // namespace
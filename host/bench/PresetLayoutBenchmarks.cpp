@@ -0,0 +1,161 @@
+/*
+ * PresetLayoutBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Memory footprint of one preset, the layout before user-030 against the current one:
+//   presetLayout/legacy:  effect names as strings, pedals and parameters in vectors and
+//                         the text, raw and JSON renderings kept with every preset
+//   presetLayout/compact: interned effect names, inline pedals and parameters, JSON on demand
+// size_bytes is sizeof, heap_bytes all heap held by one preset including the object itself.
+// The time is the time to copy a preset, as done when presets are passed around.
+
+#include <benchmark/benchmark.h>
+
+#include "HeapCounter.h"
+#include "HostTestSupport.h"
+
+#include <memory>
+
+namespace {
+
+// Preset layout before user-030
+struct LegacyParameter {
+    int number = 0;
+    string special;
+    float value = 0.0;
+};
+
+struct LegacyPedal {
+    string name;
+    boolean isOn = false;
+    vector<LegacyParameter> parameters;
+};
+
+struct LegacyPreset {
+    boolean isEmpty = true;
+    string json;
+    string raw;
+    string text;
+    int presetNumber = 0;
+    string uuid;
+    string name;
+    string version;
+    string description;
+    string icon;
+    float bpm = 0.0;
+    vector<LegacyPedal> pedals;
+    byte checksum = 0x00;
+};
+
+// Renderings as built by the StringBuilder before user-030
+class LegacyRenderer {
+public:
+    void addStr(const string &title, const string &str) {
+        raw += str + " ";
+        char add[200];
+        snprintf(add, sizeof add, "%-20s: %s \n", title.c_str(), str.c_str());
+        text += add;
+        json += "\"" + title + "\": \"" + str + "\"";
+    }
+    void addInt(const string &title, int value) {
+        char add[100];
+        snprintf(add, sizeof add, "%d ", value);
+        raw += add;
+        snprintf(add, sizeof add, "%-20s: %d\n", title.c_str(), value);
+        text += add;
+        snprintf(add, sizeof add, "\"%s\": %d", title.c_str(), value);
+        json += add;
+    }
+    void addFloat(const string &title, float value) {
+        char add[100];
+        snprintf(add, sizeof add, "%2.4f ", value);
+        raw += add;
+        text += add;
+        snprintf(add, sizeof add, "\"%s\": %2.4f", title.c_str(), value);
+        json += add;
+    }
+    void addBool(const string &title, bool value) {
+        const char *str = value ? "true" : "false";
+        raw += string(str) + " ";
+        char add[100];
+        snprintf(add, sizeof add, "%s: %-20s\n", title.c_str(), str);
+        text += add;
+        json += "\"" + title + "\": " + str;
+    }
+
+    string text;
+    string raw;
+    string json;
+};
+
+LegacyPreset legacyPreset(const Preset &preset) {
+    LegacyPreset legacy;
+    LegacyRenderer renderer;
+    legacy.isEmpty = preset.isEmpty;
+    legacy.presetNumber = preset.presetNumber;
+    legacy.uuid = preset.uuid;
+    legacy.name = preset.name;
+    legacy.version = preset.version;
+    legacy.description = preset.description;
+    legacy.icon = preset.icon;
+    legacy.bpm = preset.bpm;
+    legacy.checksum = preset.checksum;
+    renderer.addInt("PresetNumber", preset.presetNumber);
+    renderer.addStr("UUID", preset.uuid);
+    renderer.addStr("Name", preset.name);
+    renderer.addStr("Version", preset.version);
+    renderer.addStr("Description", preset.description);
+    renderer.addStr("Icon", preset.icon);
+    renderer.addFloat("BPM", preset.bpm);
+    for (const Pedal &pedal : preset.pedals) {
+        LegacyPedal legacyPedal;
+        legacyPedal.name = pedal.name.str();
+        legacyPedal.isOn = pedal.isOn;
+        renderer.addStr("Name", legacyPedal.name);
+        renderer.addBool("IsOn", pedal.isOn);
+        for (const Parameter &parameter : pedal.parameters) {
+            LegacyParameter legacyParameter;
+            legacyParameter.number = parameter.number;
+            legacyParameter.special = SparkHelper::intToHex(parameter.special);
+            legacyParameter.value = parameter.value;
+            legacyPedal.parameters.push_back(legacyParameter);
+            renderer.addFloat("Value", parameter.value);
+        }
+        legacy.pedals.push_back(legacyPedal);
+    }
+    renderer.addStr("Checksum", SparkHelper::intToHex(preset.checksum));
+    legacy.text = renderer.text;
+    legacy.raw = renderer.raw;
+    // The JSON format did not change
+    legacy.json = preset.getJson();
+    return legacy;
+}
+
+// Heap held by a copy of the preset, including the preset itself
+template <typename PresetType>
+void measureLayout(benchmark::State &state, const PresetType &preset) {
+    size_t heapBytes = 0;
+    for (auto _ : state) {
+        size_t heapBefore = heapInUse();
+        std::unique_ptr<PresetType> copy(new PresetType(preset));
+        heapBytes = heapInUse() - heapBefore;
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.counters["size_bytes"] = sizeof(PresetType);
+    state.counters["heap_bytes"] = heapBytes;
+}
+
+void presetLayoutLegacy(benchmark::State &state) {
+    measureLayout(state, legacyPreset(examplePreset("Legacy layout")));
+}
+BENCHMARK(presetLayoutLegacy)->Name("presetLayout/legacy");
+
+void presetLayoutCompact(benchmark::State &state) {
+    measureLayout(state, examplePreset("Compact layout"));
+}
+BENCHMARK(presetLayoutCompact)->Name("presetLayout/compact");
+
+} // namespace
@@ -0,0 +1,78 @@
+/*
+ * PresetParseBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Parsing a preset file with SparkPresetBuilder:
+//   storage/getPresetFromJson/readWholeFile: file read into a string first, then parsed
+//                                            (how presets were read before)
+//   storage/getPresetFromJson/file:          parsed from the file through a small buffer
+//   storage/getPresetFromJson/string:        parsed from JSON already in RAM
+// heap_peak_bytes is the maximum heap used while reading one preset.
+
+#include <benchmark/benchmark.h>
+
+#include "HeapCounter.h"
+#include "HostTestSupport.h"
+#include "SparkPresetBuilder.h"
+
+namespace {
+
+const char *presetFileName = "/Preset.json";
+
+std::string presetJson() {
+    return examplePreset("Benchmark").getJson();
+}
+
+void reportHeapPeak(benchmark::State &state, size_t heapBefore) {
+    state.counters["heap_peak_bytes"] = heapPeak() - heapBefore;
+}
+
+void parseReadWholeFile(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    fileSystem.writeFile(presetFileName, presetJson());
+    SparkPresetBuilder presetBuilder;
+    size_t heapBefore = heapInUse();
+    resetHeapPeak();
+    for (auto _ : state) {
+        File file = LittleFS.open(presetFileName);
+        std::string json;
+        json.resize(file.size());
+        file.readBytes(&json[0], json.size());
+        file.close();
+        benchmark::DoNotOptimize(presetBuilder.getPresetFromJson(json.c_str()));
+    }
+    reportHeapPeak(state, heapBefore);
+}
+BENCHMARK(parseReadWholeFile)->Name("storage/getPresetFromJson/readWholeFile");
+
+void parseFile(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    fileSystem.writeFile(presetFileName, presetJson());
+    SparkPresetBuilder presetBuilder;
+    size_t heapBefore = heapInUse();
+    resetHeapPeak();
+    for (auto _ : state) {
+        File file = LittleFS.open(presetFileName);
+        benchmark::DoNotOptimize(presetBuilder.getPresetFromJson(file));
+        file.close();
+    }
+    reportHeapPeak(state, heapBefore);
+}
+BENCHMARK(parseFile)->Name("storage/getPresetFromJson/file");
+
+void parseString(benchmark::State &state) {
+    std::string json = presetJson();
+    SparkPresetBuilder presetBuilder;
+    size_t heapBefore = heapInUse();
+    resetHeapPeak();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(presetBuilder.getPresetFromJson(json.c_str()));
+    }
+    reportHeapPeak(state, heapBefore);
+}
+BENCHMARK(parseString)->Name("storage/getPresetFromJson/string");
+
+} // namespace
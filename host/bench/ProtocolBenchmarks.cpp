@@ -0,0 +1,40 @@
+/*
+ * ProtocolBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Encode and decode workloads of SparkBenchmarkWorkloads on the host, the same code and
+// messages as on the device. Names match the ones of the device report, so both can be
+// compared with the Google Benchmark tools.
+
+#include <benchmark/benchmark.h>
+
+#include "SparkBenchmarkWorkloads.h"
+
+namespace {
+
+void runWorkload(benchmark::State &state, SparkBenchmarkWorkloads::Workload workload) {
+    SparkBenchmarkWorkloads workloads;
+    for (auto _ : state) {
+        workloads.run(workload);
+    }
+    if (workload != &SparkBenchmarkWorkloads::decodeMalformed) {
+        return;
+    }
+    const SparkStreamReader &sparkSsr = workloads.reader();
+    state.counters["rejected_chunks"] = sparkSsr.rejectedChunks();
+    state.counters["resyncs"] = sparkSsr.resyncs();
+}
+
+int registerWorkloads() {
+    for (const SparkBenchmarkWorkloads::Definition &definition : SparkBenchmarkWorkloads::workloads()) {
+        benchmark::RegisterBenchmark(definition.name, &runWorkload, definition.workload);
+    }
+    return 0;
+}
+
+const int registered = registerWorkloads();
+
+} // namespace
@@ -0,0 +1,60 @@
+/*
+ * StorageBenchmarks.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Storage workloads of SparkBenchmark on the host, on a scratch file system:
+//   storage/getPreset:                  loads the presets of the preset list in turn
+//   storage/storePreset+deletePreset:   appends a preset to the list and deletes it again,
+//                                       the journal is compacted every few iterations
+
+#include <benchmark/benchmark.h>
+
+#include "HostTestSupport.h"
+#include "SparkPresetBuilder.h"
+
+namespace {
+
+const int numberOfPresets = 8;
+
+// Preset files and preset list as on the device
+void writePresets(ScratchFileSystem &fileSystem) {
+    for (int num = 0; num < numberOfPresets; num++) {
+        std::string fileName = "/" + presetFilename(num);
+        fileSystem.writeFile(fileName.c_str(), examplePreset("Preset " + std::to_string(num), presetUUID(num)).getJson());
+    }
+    fileSystem.writeFile("/PresetListUUIDs.txt", presetList(numberOfPresets));
+}
+
+void storageGetPreset(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    writePresets(fileSystem);
+    SparkPresetBuilder presetBuilder;
+    presetBuilder.init();
+    int position = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(presetBuilder.getPreset(position / PRESETS_PER_BANK + 1, position % PRESETS_PER_BANK + 1));
+        position = (position + 1) % numberOfPresets;
+    }
+}
+BENCHMARK(storageGetPreset)->Name("storage/getPreset");
+
+void storageStoreDeletePreset(benchmark::State &state) {
+    ScratchFileSystem fileSystem;
+    writePresets(fileSystem);
+    SparkPresetBuilder presetBuilder;
+    presetBuilder.init();
+    Preset preset = examplePreset("Benchmark");
+    for (auto _ : state) {
+        int lastPosition = presetBuilder.numberOfPresets();
+        int bank = lastPosition / PRESETS_PER_BANK + 1;
+        int pre = lastPosition % PRESETS_PER_BANK + 1;
+        presetBuilder.storePreset(preset, bank, pre);
+        presetBuilder.deletePreset(bank, pre);
+    }
+}
+BENCHMARK(storageStoreDeletePreset)->Name("storage/storePreset+deletePreset");
+
+} // namespace
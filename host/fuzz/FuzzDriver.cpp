@@ -0,0 +1,208 @@
+/*
+ * FuzzDriver.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Driver for the fuzz target when libFuzzer is not available (GCC)
+// -----------------------------------------------------------------
+//   ignitron_fuzz_stream_reader [--runs=N] [--seeds=DIR]
+//                                                 seeds built from SparkMessage (and the
+//                                                 files in DIR, e.g. host/fuzz/corpus) and
+//                                                 N deterministic mutations of them
+//   ignitron_fuzz_stream_reader FILE|DIR...       runs each file, e.g. a crash or corpus
+//   ignitron_fuzz_stream_reader --write-corpus=DIR  writes the seeds as a libFuzzer corpus
+// A finding aborts through the sanitizers.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "HostTestSupport.h"
+#include "SparkMessage.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+namespace {
+
+typedef std::vector<uint8_t> FuzzInput;
+
+// Blocks in the input format of the fuzz target: length byte, then the block
+void appendMessage(FuzzInput &input, const std::vector<CmdData> &message) {
+    for (const ByteVector &block : messageBlocks(message)) {
+        input.push_back(block.size());
+        input.insert(input.end(), block.begin(), block.end());
+    }
+}
+
+std::vector<FuzzInput> seeds() {
+    SparkMessage sparkMessage;
+    std::vector<FuzzInput> result;
+    std::vector<std::vector<CmdData>> messages = {
+        sparkMessage.changePreset(examplePreset("Fuzz"), DIR_FROM_SPARK, 1),
+        sparkMessage.changePreset(examplePreset("Fuzz"), DIR_TO_SPARK, 2),
+        sparkMessage.sendSerialNumber(3),
+        sparkMessage.sendAmpName(4, "Spark MINI"),
+        sparkMessage.sendFirmwareVersion(5),
+        sparkMessage.sendHWChecksums(6, {0x12, 0x34, 0x56, 0x78}),
+        sparkMessage.sendHWPresetNumber(7, 2),
+        sparkMessage.sendTunerOutput(8, 7, 0.25),
+        sparkMessage.sendLooperSettings(9, LooperSetting()),
+        sparkMessage.changeEffectParameter(10, "Twin", 2, 0.5),
+        sparkMessage.changeEffect(11, "Twin", "Rectifier"),
+        sparkMessage.turnEffectOnOff(12, "DelayMono", true),
+        sparkMessage.sendAck(13, 0x38, DIR_FROM_SPARK),
+    };
+    for (const std::vector<CmdData> &message : messages) {
+        FuzzInput input;
+        appendMessage(input, message);
+        result.push_back(input);
+    }
+    // Several messages in one input
+    FuzzInput all;
+    for (const FuzzInput &input : result) {
+        all.insert(all.end(), input.begin(), input.end());
+    }
+    result.push_back(all);
+    return result;
+}
+
+// Same kind of mutations as the decode/processBlock/malformed benchmark, on the whole input
+FuzzInput mutate(FuzzInput input, uint32_t &seed) {
+    auto random = [&seed](uint32_t range) {
+        seed = seed * 1103515245 + 12345;
+        return range == 0 ? 0 : (seed >> 16) % range;
+    };
+    int mutations = 1 + random(8);
+    for (int i = 0; i < mutations; i++) {
+        switch (random(4)) {
+        case 0: // bit flip
+            if (!input.empty()) {
+                input[random(input.size())] ^= 1 << random(8);
+            }
+            break;
+        case 1: // truncation
+            input.resize(random(input.size() + 1));
+            break;
+        case 2: // inserted byte
+            input.insert(input.begin() + random(input.size() + 1), random(256));
+            break;
+        default: // random byte
+            if (!input.empty()) {
+                input[random(input.size())] = random(256);
+            }
+            break;
+        }
+    }
+    return input;
+}
+
+bool readFile(const std::string &path, FuzzInput &input) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string data = content.str();
+    input.assign(data.begin(), data.end());
+    return true;
+}
+
+// Reads the file at path or all files of the directory at path, sorted by name
+bool readPath(const std::string &path, std::vector<FuzzInput> &inputs) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        inputs.push_back(FuzzInput());
+        return readFile(path, inputs.back());
+    }
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::vector<std::string> names;
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            names.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    bool isOk = true;
+    for (const std::string &name : names) {
+        inputs.push_back(FuzzInput());
+        isOk = readFile(path + "/" + name, inputs.back()) && isOk;
+    }
+    return isOk;
+}
+
+bool writeCorpus(const std::string &dir) {
+    std::vector<FuzzInput> inputs = seeds();
+    for (size_t i = 0; i < inputs.size(); i++) {
+        std::string path = dir + "/seed" + std::to_string(i);
+        std::ofstream file(path, std::ios::binary);
+        file.write((const char *)inputs[i].data(), inputs[i].size());
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", path.c_str());
+            return false;
+        }
+    }
+    printf("Wrote %d seeds to %s\n", (int)inputs.size(), dir.c_str());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // Diagnostics of the reader are expected for malformed input
+    Serial.setOutputEnabled(false);
+
+    long runs = 100000;
+    std::vector<FuzzInput> inputs = seeds();
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--runs=", 7) == 0) {
+            runs = atol(argv[i] + 7);
+        } else if (strncmp(argv[i], "--seeds=", 8) == 0) {
+            if (!readPath(argv[i] + 8, inputs)) {
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--write-corpus=", 15) == 0) {
+            return writeCorpus(argv[i] + 15) ? 0 : 1;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (!paths.empty()) {
+        std::vector<FuzzInput> files;
+        bool isOk = true;
+        for (const std::string &path : paths) {
+            isOk = readPath(path, files) && isOk;
+        }
+        for (const FuzzInput &input : files) {
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        return isOk ? 0 : 1;
+    }
+
+    for (const FuzzInput &input : inputs) {
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    uint32_t seed = 1;
+    for (long run = 0; run < runs; run++) {
+        FuzzInput input = mutate(inputs[run % inputs.size()], seed);
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    printf("Ran %d seeds and %ld mutated inputs\n", (int)inputs.size(), runs);
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * SparkStreamReaderFuzzer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Fuzz target for SparkStreamReader (libFuzzer interface)
+// ---------------------------------------------------------
+// The input is a sequence of blocks as they arrive over BLE or serial: a length byte
+// followed by up to that many bytes. Each block is processed like SparkBTControl does,
+// the results are read out like SparkDataControl does. Built with ASan and UBSan, see
+// host/fuzz/CMakeLists.txt.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SparkStreamReader.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    SparkStreamReader reader;
+    size_t pos = 0;
+    while (pos < size) {
+        size_t length = data[pos++];
+        if (length > size - pos) {
+            length = size - pos;
+        }
+        ByteVector block(data + pos, data + pos + length);
+        pos += length;
+
+        byte note;
+        float offset;
+        SparkStreamReader::readTunerFrame(block.data(), block.size(), note, offset);
+        reader.needsAck(block);
+        if (reader.processBlock(block) == MSG_PROCESS_RES_COMPLETE && reader.hasJson()) {
+            reader.getJson();
+        }
+        reader.getLastAckAndEmpty();
+        AckData corrupted;
+        reader.getCorruptedMessageAndEmpty(corrupted);
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+/*
+ * ScenarioRunner.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Amp simulator scenarios on the host
+// -----------------------------------
+//   ignitron_scenario SCRIPT
+// Runs the firmware in APP mode (HostApp: SparkDataControl with preset and looper control,
+// display and LEDs) against SparkAmpSimulator on the virtual clock. The firmware talks to
+// the simulator through SparkTransport like it talks to the amp over BLE, actions of the
+// script are the calls the button handler makes. The presets are a copy of data/. The
+// script has one command per line, '#' starts a comment:
+//
+//   amp NAME           amp type (before connect)
+//   latency MS         delay of each notification
+//   loss PERCENT       dropped notifications
+//   mtu SIZE           maximum notification size, 0 for the default of the amp type
+//   seed N             seed of the random numbers (loss)
+//   connect            connects the simulated amp, setup() of the firmware on the first call
+//   disconnect         disconnects the simulated amp
+//   wait MS            runs the main loop and the tasks of the firmware for MS ms
+//   preset N           preset button N
+//   bank up|down       bank buttons
+//   fx EFFECT          toggles an effect (gate, comp, drive, amp, mod, delay, reverb)
+//   tuner on|off       tuner mode
+//   looper             toggles between preset and looper mode
+//   looperBpm BPM      changes the BPM of the looper settings
+//   send REQUEST       request of SparkDataControl, see sendRequest()
+//   expect FIELD VALUE checks the state of the firmware or the simulator, see check()
+//   save FILE          saves the capture of the session (see SparkCapture.h)
+//
+// At the end the round trip percentiles of the simulator (request to the last notification
+// of the response) and the bytes per second in each direction are printed. The exit code
+// is 1 if an expectation failed or an action was not accepted.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "HostApp.h"
+#include "HostTestSupport.h"
+#include "SparkCapture.h"
+#include "SparkStatus.h"
+
+namespace {
+
+HostApp &app = HostApp::getInstance();
+SparkAmpSimulator &simulator = SparkAmpSimulator::getInstance();
+SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+SparkStatus &status = SparkStatus::getInstance();
+SimulatedAmpConfig ampConfig;
+
+bool isStarted = false;
+unsigned long connectTimestamp = 0;
+// Tuner updates at the start of the last wait
+uint8_t waitTunerUpdateCount = 0;
+
+const char *effectNames[] = {"gate", "comp", "drive", "amp", "mod", "delay", "reverb"};
+
+int effectIndex(const std::string &name) {
+    for (int i = 0; i < Preset::numberOfPedals; i++) {
+        if (name == effectNames[i]) {
+            return i;
+        }
+    }
+    return INDEX_FX_INVALID;
+}
+
+const char *subModeName(SubMode subMode) {
+    switch (subMode) {
+    case SUB_MODE_FX:
+        return "fx";
+    case SUB_MODE_PRESET:
+        return "preset";
+    case SUB_MODE_LOOPER:
+        return "looper";
+    case SUB_MODE_SPK_LOOPER:
+        return "ampLooper";
+    case SUB_MODE_LOOP_CONFIG:
+        return "loopConfig";
+    case SUB_MODE_LOOP_CONTROL:
+        return "loopControl";
+    case SUB_MODE_TUNER:
+        return "tuner";
+    }
+    return "unknown";
+}
+
+void connect() {
+    if (!isStarted) {
+        app.begin(ampConfig);
+        isStarted = true;
+        connectTimestamp = millis();
+        return;
+    }
+    simulator.configure(ampConfig);
+    simulator.begin();
+}
+
+// Returns false if the request is unknown, accepted is the return value of SparkDataControl
+bool sendRequest(std::istringstream &args, bool &accepted) {
+    std::string request;
+    args >> request;
+    SparkDataControl &dataControl = app.dataControl();
+
+    if (request == "getAmpName") {
+        accepted = SparkDataControl::getAmpName();
+    } else if (request == "getSerialNumber") {
+        accepted = SparkDataControl::getSerialNumber();
+    } else if (request == "getFirmwareVersion") {
+        accepted = SparkDataControl::getFirmwareVersion();
+    } else if (request == "getHWChecksums") {
+        accepted = SparkDataControl::getHWChecksums();
+    } else if (request == "getCurrentPresetNum") {
+        accepted = SparkDataControl::getCurrentPresetNum();
+    } else if (request == "getCurrentPreset") {
+        // Optional: number of the HW preset (1 based), the active preset otherwise
+        int presetNumber = -1;
+        args >> presetNumber;
+        accepted = dataControl.getCurrentPreset(presetNumber);
+    } else if (request == "getLooperConfig") {
+        accepted = dataControl.sparkLooperGetConfig();
+    } else if (request == "getLooperStatus") {
+        accepted = dataControl.sparkLooperGetStatus();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Returns false if the action is unknown, accepted is false if the firmware refused it
+bool runAction(const std::string &command, const std::string &arg, bool &accepted) {
+    SparkDataControl &dataControl = app.dataControl();
+    accepted = true;
+    if (command == "preset") {
+        accepted = dataControl.switchPreset(std::atoi(arg.c_str()), false);
+    } else if (command == "bank") {
+        if (arg == "up") {
+            presetControl.increaseBank();
+        } else if (arg == "down") {
+            presetControl.decreaseBank();
+        } else {
+            return false;
+        }
+    } else if (command == "fx") {
+        int index = effectIndex(arg);
+        if (index == INDEX_FX_INVALID) {
+            return false;
+        }
+        accepted = SparkDataControl::toggleEffect(index);
+    } else if (command == "tuner") {
+        // Like the button handler, the tuner is a sub mode
+        SparkDataControl::switchSubMode(arg == "on" ? SUB_MODE_TUNER : SUB_MODE_PRESET);
+    } else if (command == "looper") {
+        accepted = dataControl.toggleLooperAppMode();
+    } else if (command == "looperBpm") {
+        dataControl.looperControl().changeSettingBpm(std::atoi(arg.c_str()));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool saveCapture(const std::string &fileName) {
+    ByteVector image;
+    SparkCapture::getInstance().image(image);
+    std::ofstream file(fileName, std::ios::binary);
+    file.write((const char *)image.data(), image.size());
+    return (bool)file;
+}
+
+// Returns the current value of field, value (from the script) is needed for effects
+bool check(const std::string &field, const std::string &value, std::string &actual) {
+    SparkDataControl &dataControl = app.dataControl();
+    const Preset &activePreset = presetControl.activePreset();
+    if (field == "ready") {
+        bool isReady = SparkDataControl::isAmpConnected() && !dataControl.isInitBoot()
+                       && presetControl.allHWPresetsAvailable() && !activePreset.isEmpty;
+        actual = isReady ? "yes" : "no";
+    } else if (field == "ampName") {
+        actual = status.ampName();
+    } else if (field == "serialNumber") {
+        actual = status.ampSerialNumber();
+    } else if (field == "hwPresets") {
+        actual = std::to_string(presetControl.numberOfHWBanks() * PRESETS_PER_BANK);
+    } else if (field == "checksums") {
+        actual = std::to_string(status.hwChecksums().size());
+    } else if (field == "mtu") {
+        actual = std::to_string(simulator.config().mtu);
+    } else if (field == "bank") {
+        actual = std::to_string(presetControl.activeBank());
+    } else if (field == "hwBank") {
+        actual = std::to_string(presetControl.activeHWBank());
+    } else if (field == "presetNumber") {
+        actual = std::to_string(presetControl.activePresetNum());
+    } else if (field == "presetName") {
+        actual = activePreset.name;
+    } else if (field == "fx") {
+        // 'expect fx drive on'
+        std::istringstream args(value);
+        std::string effect;
+        args >> effect;
+        int index = effectIndex(effect);
+        if (index == INDEX_FX_INVALID) {
+            return false;
+        }
+        actual = effect + (activePreset.pedals[index].isOn ? " on" : " off");
+    } else if (field == "subMode") {
+        actual = subModeName(dataControl.subMode());
+    } else if (field == "tunerOutput") {
+        // Tuner output received during the last wait
+        actual = status.tunerUpdateCount() != waitTunerUpdateCount ? "yes" : "no";
+    } else if (field == "looperBpm") {
+        actual = std::to_string(dataControl.looperControl().bpm());
+    } else if (field == "pending") {
+        actual = std::to_string(simulator.pendingNotifications());
+    } else if (field == "unsupported") {
+        actual = std::to_string(simulator.unsupportedMessages());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void printStatistics(const char *script) {
+    const DurationHistogram &roundTrip = simulator.roundTrip();
+    unsigned long duration = millis() - connectTimestamp;
+    unsigned long seconds = duration > 0 ? duration : 1;
+    printf("%s: %s, %lu responses, round trip p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms\n", script,
+           simulator.config().ampName.c_str(), (unsigned long)roundTrip.count(), roundTrip.percentile(50) / 1000.0,
+           roundTrip.percentile(90) / 1000.0, roundTrip.percentile(99) / 1000.0, roundTrip.max() / 1000.0);
+    printf("%s: %lu bytes/s to the amp, %lu bytes/s from the amp (%lu ms)\n", script,
+           simulator.bytesReceived() * 1000 / seconds, simulator.bytesSent() * 1000 / seconds, duration);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s SCRIPT\n", argv[0]);
+        return 2;
+    }
+    std::ifstream script(argv[1]);
+    if (!script) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 2;
+    }
+    Serial.setOutputEnabled(false);
+    ScratchFileSystem fileSystem;
+    if (!fileSystem.copyFrom(IGNITRON_DATA_DIR)) {
+        fprintf(stderr, "Cannot copy the presets of %s\n", IGNITRON_DATA_DIR);
+        return 2;
+    }
+
+    int failures = 0;
+    int expectations = 0;
+    int lineNumber = 0;
+    std::string line;
+    while (std::getline(script, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream args(line);
+        std::string command;
+        if (!(args >> command)) {
+            continue;
+        }
+        std::string rest;
+        std::getline(args >> std::ws, rest);
+        rest.erase(rest.find_last_not_of(" \t\r") + 1);
+        std::istringstream restArgs(rest);
+
+        bool isValid = true;
+        bool accepted = true;
+        if (command == "amp") {
+            ampConfig.ampName = rest;
+        } else if (command == "latency") {
+            ampConfig.latency = std::strtoul(rest.c_str(), nullptr, 10);
+        } else if (command == "loss") {
+            ampConfig.lossPercent = std::atoi(rest.c_str());
+        } else if (command == "mtu") {
+            ampConfig.mtu = std::atoi(rest.c_str());
+        } else if (command == "seed") {
+            randomSeed(std::strtoul(rest.c_str(), nullptr, 10));
+        } else if (command == "connect") {
+            connect();
+        } else if (command == "disconnect") {
+            simulator.end();
+        } else if (command == "wait") {
+            waitTunerUpdateCount = status.tunerUpdateCount();
+            app.runFor(std::strtoul(rest.c_str(), nullptr, 10));
+        } else if (command == "send") {
+            isValid = sendRequest(restArgs, accepted);
+        } else if (command == "save") {
+            if (!saveCapture(rest)) {
+                fprintf(stderr, "%s:%d: cannot write %s\n", argv[1], lineNumber, rest.c_str());
+                return 2;
+            }
+        } else if (command == "expect") {
+            std::string field;
+            restArgs >> field;
+            std::string value;
+            std::getline(restArgs >> std::ws, value);
+            std::string actual;
+            isValid = check(field, value, actual);
+            if (isValid) {
+                expectations++;
+                if (actual != value) {
+                    failures++;
+                    fprintf(stderr, "%s:%d: expected %s '%s', got '%s'\n", argv[1], lineNumber, field.c_str(),
+                            value.c_str(), actual.c_str());
+                }
+            }
+        } else {
+            isValid = runAction(command, rest, accepted);
+        }
+        if (!isValid) {
+            fprintf(stderr, "%s:%d: invalid line '%s'\n", argv[1], lineNumber, line.c_str());
+            return 2;
+        }
+        if (!accepted) {
+            failures++;
+            fprintf(stderr, "%s:%d: '%s' not accepted by the firmware\n", argv[1], lineNumber, line.c_str());
+        }
+    }
+    Serial.setOutputEnabled(true);
+    simulator.report();
+    printStatistics(argv[1]);
+    printf("%s: %d of %d expectations met\n", argv[1], expectations - failures, expectations);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/*
+ * Adafruit_GFX.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "Adafruit_GFX.h"
+
+// Cell of a character of the built-in font at text size 1
+static const int16_t charWidth = 6;
+static const int16_t charHeight = 8;
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : rawWidth_(w), rawHeight_(h), width_(w), height_(h) {
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < h; i++) {
+        drawPixel(x, y + i, color);
+    }
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) {
+        drawPixel(x + i, y, color);
+    }
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = 0; i < w; i++) {
+        drawFastVLine(x + i, y, h, color);
+    }
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    fillRect(0, 0, width_, height_, color);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    // Midpoint circle algorithm
+    int16_t f = 1 - r;
+    int16_t ddFx = 1;
+    int16_t ddFy = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    drawPixel(x0, y0 + r, color);
+    drawPixel(x0, y0 - r, color);
+    drawPixel(x0 + r, y0, color);
+    drawPixel(x0 - r, y0, color);
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddFy += 2;
+            f += ddFy;
+        }
+        x++;
+        ddFx += 2;
+        f += ddFx;
+        drawPixel(x0 + x, y0 + y, color);
+        drawPixel(x0 - x, y0 + y, color);
+        drawPixel(x0 + x, y0 - y, color);
+        drawPixel(x0 - x, y0 - y, color);
+        drawPixel(x0 + y, y0 + x, color);
+        drawPixel(x0 - y, y0 + x, color);
+        drawPixel(x0 + y, y0 - x, color);
+        drawPixel(x0 - y, y0 - x, color);
+    }
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                                uint16_t color) {
+    // Fills the bounding box where the pixel is on the inner side of all three edges
+    int16_t minX = min(x0, min(x1, x2));
+    int16_t maxX = max(x0, max(x1, x2));
+    int16_t minY = min(y0, min(y1, y2));
+    int16_t maxY = max(y0, max(y1, y2));
+    long area = (long)(x1 - x0) * (y2 - y0) - (long)(y1 - y0) * (x2 - x0);
+    for (int16_t y = minY; y <= maxY; y++) {
+        for (int16_t x = minX; x <= maxX; x++) {
+            long e0 = (long)(x1 - x0) * (y - y0) - (long)(y1 - y0) * (x - x0);
+            long e1 = (long)(x2 - x1) * (y - y1) - (long)(y2 - y1) * (x - x1);
+            long e2 = (long)(x0 - x2) * (y - y2) - (long)(y0 - y2) * (x - x2);
+            bool isInside = area >= 0 ? (e0 >= 0 && e1 >= 0 && e2 >= 0) : (e0 <= 0 && e1 <= 0 && e2 <= 0);
+            if (isInside) {
+                drawPixel(x, y, color);
+            }
+        }
+    }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h,
+                              uint16_t color) {
+    int16_t byteWidth = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7))) {
+                drawPixel(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+void Adafruit_GFX::setRotation(uint8_t rotation) {
+    rotation_ = rotation & 3;
+    bool isPortrait = rotation_ & 1;
+    width_ = isPortrait ? rawHeight_ : rawWidth_;
+    height_ = isPortrait ? rawWidth_ : rawHeight_;
+}
+
+void Adafruit_GFX::getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1, int16_t *y1,
+                                 uint16_t *w, uint16_t *h) {
+    // Single line, no wrapping, as used by SparkDisplayControl
+    size_t length = strlen(string);
+    *x1 = x;
+    *y1 = y;
+    *w = length * charWidth * textSize_;
+    *h = length > 0 ? charHeight * textSize_ : 0;
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursorX_ = 0;
+        cursorY_ += charHeight * textSize_;
+        return 1;
+    }
+    if (c == '\r') {
+        return 1;
+    }
+    if (isWrapping_ && cursorX_ + charWidth * textSize_ > width_) {
+        cursorX_ = 0;
+        cursorY_ += charHeight * textSize_;
+    }
+    drawChar(cursorX_, cursorY_, c);
+    cursorX_ += charWidth * textSize_;
+    return 1;
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c) {
+    for (int16_t column = 0; column < charWidth; column++) {
+        // 5 columns of 7 rows like the built-in font, the last column is spacing
+        uint8_t bits = column < charWidth - 1 ? (uint8_t)((c * (column + 3) + column) & 0x7F) : 0;
+        for (int16_t row = 0; row < charHeight; row++) {
+            bool isSet = bits & (1 << row);
+            if (!isSet && textBackground_ == textColor_) {
+                continue;
+            }
+            fillRect(x + column * textSize_, y + row * textSize_, textSize_, textSize_,
+                     isSet ? textColor_ : textBackground_);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Adafruit_GFX.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+// Adafruit GFX for the host build
+// -------------------------------
+// Only the drawing functions used by SparkDisplayControl. Text uses the cell size of the
+// built-in 6x8 font, the glyphs are a pattern of the character code and not the real
+// font: frames change whenever the text changes, which is all the host build needs.
+
+#include "Arduino.h"
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    virtual void fillScreen(uint16_t color);
+    virtual void invertDisplay(bool i) {}
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color);
+
+    void setCursor(int16_t x, int16_t y) {
+        cursorX_ = x;
+        cursorY_ = y;
+    }
+    void setTextSize(uint8_t size) { textSize_ = size > 0 ? size : 1; }
+    void setTextColor(uint16_t color) { textColor_ = textBackground_ = color; }
+    void setTextColor(uint16_t color, uint16_t background) {
+        textColor_ = color;
+        textBackground_ = background;
+    }
+    void setTextWrap(bool wrap) { isWrapping_ = wrap; }
+    void setRotation(uint8_t rotation);
+    void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w,
+                       uint16_t *h);
+
+    int16_t width() const { return width_; }
+    int16_t height() const { return height_; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+protected:
+    const int16_t rawWidth_;
+    const int16_t rawHeight_;
+    int16_t width_;
+    int16_t height_;
+    uint8_t rotation_ = 0;
+
+private:
+    void drawChar(int16_t x, int16_t y, unsigned char c);
+
+    int16_t cursorX_ = 0;
+    int16_t cursorY_ = 0;
+    uint8_t textSize_ = 1;
+    uint16_t textColor_ = 0xFFFF;
+    uint16_t textBackground_ = 0xFFFF;
+    bool isWrapping_ = true;
+};
+
+#endif
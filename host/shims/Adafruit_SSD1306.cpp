@@ -0,0 +1,126 @@
+/*
+ * Adafruit_SSD1306.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "Adafruit_SSD1306.h"
+
+// Bytes per I2C transfer of the ESP32 Wire library, including the control byte
+static const size_t wireMax = 32;
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rstPin, uint32_t clkDuring,
+                                   uint32_t clkAfter)
+    : Adafruit_GFX(w, h), wire_(twi), clkDuring_(clkDuring), clkAfter_(clkAfter) {
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() {
+    free(buffer_);
+}
+
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr, bool reset, bool periphBegin) {
+    if (buffer_ == nullptr) {
+        buffer_ = (uint8_t *)malloc(rawWidth_ * ((rawHeight_ + 7) / 8));
+        if (buffer_ == nullptr) {
+            return false;
+        }
+    }
+    clearDisplay();
+    if (i2caddr != 0) {
+        i2cAddress_ = i2caddr;
+    }
+    if (periphBegin) {
+        wire_->begin();
+    }
+    return true;
+}
+
+void Adafruit_SSD1306::display() {
+    sendCommand(SSD1306_PAGEADDR);
+    sendCommand(0);
+    sendCommand(0xFF);
+    sendCommand(SSD1306_COLUMNADDR);
+    sendCommand(0);
+    sendCommand(rawWidth_ - 1);
+
+    const uint8_t *data = buffer_;
+    size_t count = rawWidth_ * ((rawHeight_ + 7) / 8);
+    wire_->setClock(clkDuring_);
+    while (count > 0) {
+        size_t transferSize = min(count, wireMax - 1);
+        wire_->beginTransmission(i2cAddress_);
+        wire_->write((uint8_t)0x40);
+        wire_->write(data, transferSize);
+        wire_->endTransmission();
+        data += transferSize;
+        count -= transferSize;
+    }
+    wire_->setClock(clkAfter_);
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+    if (buffer_ != nullptr) {
+        memset(buffer_, 0, rawWidth_ * ((rawHeight_ + 7) / 8));
+    }
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+    ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (buffer_ == nullptr || x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return;
+    }
+    int16_t t;
+    switch (rotation_) {
+    case 1:
+        t = x;
+        x = rawWidth_ - y - 1;
+        y = t;
+        break;
+    case 2:
+        x = rawWidth_ - x - 1;
+        y = rawHeight_ - y - 1;
+        break;
+    case 3:
+        t = x;
+        x = y;
+        y = rawHeight_ - t - 1;
+        break;
+    }
+    uint8_t &pixels = buffer_[x + (y / 8) * rawWidth_];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+    case SSD1306_WHITE:
+        pixels |= bit;
+        break;
+    case SSD1306_BLACK:
+        pixels &= ~bit;
+        break;
+    case SSD1306_INVERSE:
+        pixels ^= bit;
+        break;
+    }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+    if (buffer_ == nullptr || x < 0 || y < 0 || x >= rawWidth_ || y >= rawHeight_) {
+        return false;
+    }
+    return buffer_[x + (y / 8) * rawWidth_] & (1 << (y & 7));
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+    wire_->setClock(clkDuring_);
+    sendCommand(c);
+    wire_->setClock(clkAfter_);
+}
+
+void Adafruit_SSD1306::sendCommand(uint8_t c) {
+    wire_->beginTransmission(i2cAddress_);
+    wire_->write((uint8_t)0x00); // Co = 0, D/C = 0: command follows
+    wire_->write(c);
+    wire_->endTransmission();
+}
@@ -0,0 +1,59 @@
+/*
+ * Adafruit_SSD1306.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+// Adafruit SSD1306 driver for the host build. The frame buffer has the layout of the
+// display (one byte per 8 rows of a column, page by page), display() and the commands
+// are written to the Wire shim in the same transfers as the library sends them.
+
+#include "Adafruit_GFX.h"
+#include "Wire.h"
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define BLACK SSD1306_BLACK
+#define WHITE SSD1306_WHITE
+#define INVERSE SSD1306_INVERSE
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_EXTERNALVCC 0x01
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define SSD1306_NORMALDISPLAY 0xA6
+#define SSD1306_INVERTDISPLAY 0xA7
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi = &Wire, int8_t rstPin = -1,
+                     uint32_t clkDuring = 400000UL, uint32_t clkAfter = 100000UL);
+    ~Adafruit_SSD1306();
+
+    // Allocates the frame buffer, the only allocation of the driver
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0, bool reset = true,
+               bool periphBegin = true);
+    void display();
+    void clearDisplay();
+    void invertDisplay(bool i) override;
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y);
+    uint8_t *getBuffer() { return buffer_; }
+    void ssd1306_command(uint8_t c);
+
+private:
+    void sendCommand(uint8_t c);
+
+    TwoWire *wire_;
+    uint8_t *buffer_ = nullptr;
+    uint8_t i2cAddress_ = 0x3C;
+    uint32_t clkDuring_;
+    uint32_t clkAfter_;
+};
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * Arduino.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "Arduino.h"
+
+#include <atomic>
+#include <chrono>
+#include <malloc.h>
+#include <pthread.h>
+#include <random>
+#include <set>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+HardwareSerial Serial;
+EspClass ESP;
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+    while (size-- > 0 && write(*buffer++) == 1) {
+        written++;
+    }
+    return written;
+}
+
+size_t Print::printf(const char *format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof line, format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    if (length < (int)sizeof line) {
+        return write((const uint8_t *)line, length);
+    }
+    // Longer output is formatted again into a buffer of the right size
+    std::string longLine(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&longLine[0], longLine.size(), format, args);
+    va_end(args);
+    return write((const uint8_t *)longLine.data(), length);
+}
+
+size_t Print::print(double value, int digits) {
+    char number[64];
+    snprintf(number, sizeof number, "%.*f", digits, value);
+    return write(number);
+}
+
+size_t Print::printSigned(long long value, int base) {
+    if (value < 0 && base == DEC) {
+        return print('-') + printNumber(-(unsigned long long)value, base);
+    }
+    return printNumber(value, base);
+}
+
+size_t Print::printNumber(unsigned long long value, int base) {
+    char digits[65];
+    char *pos = &digits[sizeof digits - 1];
+    *pos = '\0';
+    if (base < 2) {
+        base = DEC;
+    }
+    do {
+        int digit = value % base;
+        *--pos = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    } while (value > 0);
+    return write(pos);
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0 || c == terminator) {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    if (isUartModelEnabled_ && baud_ > 0) {
+        // 10 bits per byte (start, 8 data, stop). The writer waits until all but the
+        // last FIFO-sized part of the output has been sent.
+        uint64_t byteTime = 10000000ULL / baud_;
+        uint64_t now = micros();
+        txDoneAt_ = max(txDoneAt_, now) + size * byteTime;
+        uint64_t fifoTime = uartFifoSize * byteTime;
+        if (txDoneAt_ > now + fifoTime) {
+            hostAdvanceTime(txDoneAt_ - fifoTime - now);
+        }
+    }
+    if (isOutputEnabled_) {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+static std::atomic<uint64_t> timeOffset{0};
+
+static uint64_t steadyMicros() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long millis() {
+    return (steadyMicros() + timeOffset.load()) / 1000;
+}
+
+unsigned long micros() {
+    return steadyMicros() + timeOffset.load();
+}
+
+static thread_local HostDelayHandler delayHandler = nullptr;
+
+void hostSetDelayHandler(HostDelayHandler handler) {
+    delayHandler = handler;
+}
+
+void delay(unsigned long ms) {
+    if (delayHandler != nullptr) {
+        delayHandler(ms);
+        return;
+    }
+    hostAdvanceTime((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostAdvanceTime(us);
+}
+
+void hostAdvanceTime(uint64_t us) {
+    timeOffset += us;
+}
+
+static std::mt19937 &randomGenerator() {
+    static std::mt19937 generator(1);
+    return generator;
+}
+
+long random(long max) {
+    return max <= 0 ? 0 : std::uniform_int_distribution<long>(0, max - 1)(randomGenerator());
+}
+
+long random(long min, long max) {
+    return min >= max ? min : min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+    randomGenerator().seed(seed);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t value) {}
+int digitalRead(uint8_t pin) { return LOW; }
+uint16_t analogRead(uint8_t pin) { return 0; }
+
+static std::atomic<uint32_t> minFreeHeap{EspClass::hostHeapSize};
+
+uint32_t EspClass::getFreeHeap() {
+    size_t used = mallinfo2().uordblks;
+    uint32_t freeHeap = used < hostHeapSize ? hostHeapSize - used : 0;
+    if (freeHeap < minFreeHeap.load()) {
+        minFreeHeap = freeHeap;
+    }
+    return freeHeap;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    getFreeHeap();
+    return minFreeHeap.load();
+}
+
+uint32_t EspClass::getCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+void EspClass::restart() {
+    fflush(stdout);
+    exit(0);
+}
+
+static uint8_t baseMacAddress[6];
+
+esp_err_t esp_base_mac_addr_set(const uint8_t *mac) {
+    memcpy(baseMacAddress, mac, sizeof baseMacAddress);
+    return ESP_OK;
+}
+
+static std::set<std::string> &suppressedTasks() {
+    static std::set<std::string> names;
+    return names;
+}
+
+void hostSuppressTask(const char *name) {
+    suppressedTasks().insert(name);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameter,
+                                   unsigned int priority, TaskHandle_t *handle, BaseType_t coreId) {
+    if (suppressedTasks().count(name) > 0) {
+        if (handle != nullptr) {
+            *handle = nullptr;
+        }
+        return pdPASS;
+    }
+    std::thread thread(task, parameter);
+    if (handle != nullptr) {
+        *handle = (TaskHandle_t)thread.native_handle();
+    }
+    thread.detach();
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return (TaskHandle_t)pthread_self();
+}
@@ -0,0 +1,194 @@
+/*
+ * Arduino.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Arduino core for the host build
+// -------------------------------
+// Only what the sources built on the host use: Print/Stream, Serial writing to stdout,
+// time, random, ESP heap statistics and the few FreeRTOS functions of the logger.
+// Time is virtual: millis()/micros() follow the steady clock, delay() does not sleep
+// but moves the clock forward, so simulated latencies cost no real time.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PROGMEM
+#define F(string_literal) (string_literal)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str == nullptr ? 0 : write((const uint8_t *)str, strlen(str)); }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char str[]) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return printNumber(value, base); }
+    size_t print(int value, int base = DEC) { return printSigned(value, base); }
+    size_t print(unsigned int value, int base = DEC) { return printNumber(value, base); }
+    size_t print(long value, int base = DEC) { return printSigned(value, base); }
+    size_t print(unsigned long value, int base = DEC) { return printNumber(value, base); }
+    size_t print(long long value, int base = DEC) { return printSigned(value, base); }
+    size_t print(unsigned long long value, int base = DEC) { return printNumber(value, base); }
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T value) { return print(value) + println(); }
+    template <typename T>
+    size_t println(T value, int format) { return print(value, format) + println(); }
+
+private:
+    size_t printSigned(long long value, int base);
+    size_t printNumber(unsigned long long value, int base);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    // There is no timeout on the host, reading stops as soon as no data is available
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    // The terminator is consumed, but not stored
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+    void setTimeout(unsigned long timeout) {}
+};
+
+class HardwareSerial : public Stream {
+    // Writes to stdout. With the UART model enabled, a write blocks (moves the virtual
+    // clock forward) like the ESP32 UART does when its FIFO is full at the given baud rate.
+
+public:
+    void begin(unsigned long baud) { baud_ = baud; }
+    void end() {}
+    operator bool() const { return true; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    int availableForWrite() { return uartFifoSize; }
+    void flush() { fflush(stdout); }
+
+    // Host only
+    void setUartModel(bool enabled) { isUartModelEnabled_ = enabled; }
+    void setOutputEnabled(bool enabled) { isOutputEnabled_ = enabled; }
+
+    static const size_t uartFifoSize = 128;
+
+private:
+    unsigned long baud_ = 115200;
+    bool isUartModelEnabled_ = false;
+    bool isOutputEnabled_ = true;
+    // Virtual time in us when the last byte has left the UART
+    uint64_t txDoneAt_ = 0;
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+// Host only: moves the virtual clock forward
+void hostAdvanceTime(uint64_t us);
+// Host only: delay() of the calling thread calls handler instead of moving the clock,
+// e.g. to run the main loop while the work of a task sleeps (see HostApp). nullptr resets it.
+typedef void (*HostDelayHandler)(unsigned long ms);
+void hostSetDelayHandler(HostDelayHandler handler);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+class EspClass {
+    // Heap statistics are taken from malloc, relative to a nominal heap of hostHeapSize
+
+public:
+    uint32_t getHeapSize() { return hostHeapSize; }
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+    // Time stamp counter of the host CPU
+    uint32_t getCycleCount();
+    // Unknown on the host
+    uint32_t getCpuFreqMHz() { return 0; }
+    void restart();
+
+    static const uint32_t hostHeapSize = 0x40000000;
+};
+
+extern EspClass ESP;
+
+typedef int esp_err_t;
+#define ESP_OK 0
+// The MAC address is only stored on the host
+esp_err_t esp_base_mac_addr_set(const uint8_t *mac);
+
+// FreeRTOS, tasks are threads on the host
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void *);
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define pdMS_TO_TICKS(ms) (ms)
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stackDepth, void *parameter,
+                                   unsigned int priority, TaskHandle_t *handle, BaseType_t coreId);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+// Host only: tasks with this name are not started. For tasks which loop on the virtual
+// clock, the host build calls their work from its own loop instead.
+void hostSuppressTask(const char *name);
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * BleKeyboard.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_BLE_KEYBOARD_H
+#define HOST_BLE_KEYBOARD_H
+
+// ESP32 BLE Keyboard (NimBLE mode) for the host build. begin() creates the BLE server
+// like the library does, no host connects to the keyboard, so keys are never sent.
+
+#include "Arduino.h"
+#include "NimBLEDevice.h"
+#include <string>
+
+const uint8_t KEY_LEFT_CTRL = 0x80;
+const uint8_t KEY_LEFT_SHIFT = 0x81;
+const uint8_t KEY_LEFT_ALT = 0x82;
+const uint8_t KEY_UP_ARROW = 0xDA;
+const uint8_t KEY_DOWN_ARROW = 0xD9;
+const uint8_t KEY_LEFT_ARROW = 0xD8;
+const uint8_t KEY_RIGHT_ARROW = 0xD7;
+
+class BleKeyboard : public Print {
+public:
+    BleKeyboard(std::string deviceName = "ESP32 Keyboard", std::string deviceManufacturer = "Espressif",
+                uint8_t batteryLevel = 100)
+        : deviceName_(deviceName) {}
+    virtual ~BleKeyboard() {}
+
+    void begin() {
+        NimBLEDevice::init(deviceName_);
+        NimBLEDevice::createServer();
+    }
+    void end() {}
+    void setName(std::string deviceName) { deviceName_ = deviceName; }
+    bool isConnected() { return false; }
+
+    size_t press(uint8_t k) { return 0; }
+    size_t release(uint8_t k) { return 0; }
+    void releaseAll() {}
+    size_t write(uint8_t c) override { return 0; }
+    using Print::write;
+
+private:
+    std::string deviceName_;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * BluetoothSerial.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "BluetoothSerial.h"
+
+static BluetoothSerial *lastInstance = nullptr;
+
+BluetoothSerial::BluetoothSerial() {
+    lastInstance = this;
+}
+
+BluetoothSerial::~BluetoothSerial() {
+    if (lastInstance == this) {
+        lastInstance = nullptr;
+    }
+}
+
+size_t BluetoothSerial::write(const uint8_t *buffer, size_t size) {
+    if (!hasClient_) {
+        return 0;
+    }
+    written_.append((const char *)buffer, size);
+    return size;
+}
+
+BluetoothSerial *BluetoothSerial::hostInstance() {
+    return lastInstance;
+}
+
+void BluetoothSerial::hostConnect(bool isConnected) {
+    hasClient_ = isConnected;
+    if (callback_ != nullptr) {
+        esp_spp_cb_param_t param = {};
+        callback_(isConnected ? ESP_SPP_SRV_OPEN_EVT : ESP_SPP_CLOSE_EVT, &param);
+    }
+}
+
+void BluetoothSerial::hostReceive(const uint8_t *data, size_t length) {
+    if (dataCallback_) {
+        dataCallback_(data, length);
+    }
+}
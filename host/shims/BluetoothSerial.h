@@ -0,0 +1,67 @@
+/*
+ * BluetoothSerial.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_BLUETOOTH_SERIAL_H
+#define HOST_BLUETOOTH_SERIAL_H
+
+// Bluetooth serial (SPP) of the ESP32 Arduino core for the host build. Nothing is
+// sent over the air; a test connects a client and feeds received data with the
+// host only functions, written data is collected.
+
+#include "Arduino.h"
+#include <functional>
+#include <string>
+
+enum esp_spp_cb_event_t {
+    ESP_SPP_INIT_EVT = 0,
+    ESP_SPP_CLOSE_EVT = 27,
+    ESP_SPP_SRV_OPEN_EVT = 34
+};
+
+union esp_spp_cb_param_t {
+    uint32_t handle;
+};
+
+typedef void (*esp_spp_cb_t)(esp_spp_cb_event_t event, esp_spp_cb_param_t *param);
+typedef std::function<void(const uint8_t *buffer, size_t size)> BluetoothSerialDataCb;
+
+class BluetoothSerial : public Stream {
+public:
+    BluetoothSerial();
+    ~BluetoothSerial();
+
+    bool begin(const std::string &localName = "ESP32", bool isMaster = false) { return true; }
+    void end() {}
+    bool hasClient() { return hasClient_; }
+    void register_callback(esp_spp_cb_t callback) { callback_ = callback; }
+    void onData(BluetoothSerialDataCb callback) { dataCallback_ = callback; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() {}
+
+    // Host only: most recently created instance
+    static BluetoothSerial *hostInstance();
+    // Host only: a client connects or disconnects
+    void hostConnect(bool isConnected);
+    // Host only: data received from the client, passed to the onData callback
+    void hostReceive(const uint8_t *data, size_t length);
+    // Host only: data written so far
+    std::string &hostWritten() { return written_; }
+
+private:
+    esp_spp_cb_t callback_ = nullptr;
+    BluetoothSerialDataCb dataCallback_;
+    bool hasClient_ = false;
+    std::string written_;
+};
+
+#endif
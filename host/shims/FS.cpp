@@ -0,0 +1,261 @@
+/*
+ * FS.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "FS.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace fs {
+
+class FileImpl {
+public:
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (file != nullptr) {
+            fclose(file);
+            file = nullptr;
+        }
+        isOpen = false;
+    }
+
+    FILE *file = nullptr;
+    bool isOpen = false;
+    bool isDirectory = false;
+    std::string path;
+    std::string hostPath;
+    // Directory entries, sorted so the order does not depend on the host file system
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+};
+
+static long writeBudget = -1;
+
+void hostSetWriteBudget(long units) {
+    writeBudget = units;
+}
+
+long hostWriteBudget() {
+    return writeBudget;
+}
+
+// Takes up to units from the write budget, returns the number of units granted
+static size_t useWriteBudget(size_t units) {
+    if (writeBudget < 0) {
+        return units;
+    }
+    size_t granted = std::min(units, (size_t)writeBudget);
+    writeBudget -= granted;
+    return granted;
+}
+
+size_t File::write(const uint8_t *buffer, size_t size) {
+    if (!impl_ || impl_->file == nullptr) {
+        return 0;
+    }
+    return fwrite(buffer, 1, useWriteBudget(size), impl_->file);
+}
+
+int File::available() {
+    if (!impl_ || impl_->file == nullptr) {
+        return 0;
+    }
+    size_t total = size();
+    size_t pos = position();
+    return pos < total ? total - pos : 0;
+}
+
+int File::read() {
+    if (!impl_ || impl_->file == nullptr) {
+        return -1;
+    }
+    int c = fgetc(impl_->file);
+    return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+    if (!impl_ || impl_->file == nullptr) {
+        return -1;
+    }
+    int c = fgetc(impl_->file);
+    if (c == EOF) {
+        return -1;
+    }
+    ungetc(c, impl_->file);
+    return c;
+}
+
+size_t File::read(uint8_t *buffer, size_t size) {
+    if (!impl_ || impl_->file == nullptr) {
+        return 0;
+    }
+    return fread(buffer, 1, size, impl_->file);
+}
+
+void File::flush() {
+    if (impl_ && impl_->file != nullptr) {
+        fflush(impl_->file);
+    }
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!impl_ || impl_->file == nullptr) {
+        return false;
+    }
+    int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(impl_->file, pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!impl_ || impl_->file == nullptr) {
+        return 0;
+    }
+    long pos = ftell(impl_->file);
+    return pos < 0 ? 0 : pos;
+}
+
+size_t File::size() const {
+    if (!impl_ || impl_->file == nullptr) {
+        return 0;
+    }
+    fflush(impl_->file);
+    struct stat status;
+    if (fstat(fileno(impl_->file), &status) != 0) {
+        return 0;
+    }
+    return status.st_size;
+}
+
+void File::close() {
+    if (impl_) {
+        impl_->close();
+    }
+}
+
+File::operator bool() const {
+    return impl_ && impl_->isOpen;
+}
+
+const char *File::name() const {
+    static const char *empty = "";
+    if (!impl_) {
+        return empty;
+    }
+    size_t pos = impl_->path.find_last_of('/');
+    return impl_->path.c_str() + (pos == std::string::npos ? 0 : pos + 1);
+}
+
+const char *File::path() const {
+    return impl_ ? impl_->path.c_str() : "";
+}
+
+bool File::isDirectory() const {
+    return impl_ && impl_->isOpen && impl_->isDirectory;
+}
+
+File File::openNextFile(const char *mode) {
+    if (!isDirectory() || impl_->nextEntry >= impl_->entries.size()) {
+        return File();
+    }
+    std::string entryPath = impl_->path;
+    if (entryPath.empty() || entryPath.back() != '/') {
+        entryPath += '/';
+    }
+    entryPath += impl_->entries[impl_->nextEntry++];
+    std::string root = impl_->hostPath.substr(0, impl_->hostPath.size() - impl_->path.size());
+    return FS(root).open(entryPath.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+    if (impl_) {
+        impl_->nextEntry = 0;
+    }
+}
+
+std::string FS::hostPath(const char *path) const {
+    std::string result = root_;
+    if (path[0] != '/') {
+        result += '/';
+    }
+    result += path;
+    return result;
+}
+
+File FS::open(const char *path, const char *mode, const bool create) {
+    FileImplPtr impl = std::make_shared<FileImpl>();
+    impl->path = path[0] == '/' ? path : std::string("/") + path;
+    impl->hostPath = hostPath(path);
+
+    struct stat status;
+    if (stat(impl->hostPath.c_str(), &status) == 0 && S_ISDIR(status.st_mode)) {
+        DIR *dir = opendir(impl->hostPath.c_str());
+        if (dir == nullptr) {
+            return File();
+        }
+        while (struct dirent *entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                impl->entries.push_back(name);
+            }
+        }
+        closedir(dir);
+        std::sort(impl->entries.begin(), impl->entries.end());
+        impl->isDirectory = true;
+        impl->isOpen = true;
+        return File(impl);
+    }
+
+    std::string hostMode = mode;
+    if (hostMode.find('b') == std::string::npos) {
+        hostMode += 'b';
+    }
+    if (hostMode[0] != 'r' && useWriteBudget(1) == 0) {
+        return File();
+    }
+    if (create && hostMode[0] != 'r') {
+        // Parent directories are created like LittleFS does with create set
+        for (size_t pos = impl->hostPath.find('/', root_.size() + 1); pos != std::string::npos;
+             pos = impl->hostPath.find('/', pos + 1)) {
+            ::mkdir(impl->hostPath.substr(0, pos).c_str(), 0755);
+        }
+    }
+    impl->file = fopen(impl->hostPath.c_str(), hostMode.c_str());
+    if (impl->file == nullptr) {
+        return File();
+    }
+    impl->isOpen = true;
+    return File(impl);
+}
+
+bool FS::exists(const char *path) {
+    struct stat status;
+    return stat(hostPath(path).c_str(), &status) == 0;
+}
+
+bool FS::remove(const char *path) {
+    return useWriteBudget(1) == 1 && unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo) {
+    return useWriteBudget(1) == 1 && ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path) {
+    return ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+bool FS::rmdir(const char *path) {
+    return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+} // namespace fs
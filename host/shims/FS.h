@@ -0,0 +1,107 @@
+/*
+ * FS.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+// File system API of the ESP32 Arduino core for the host build. Paths are mapped onto
+// a directory of the host (the root of the file system). Like on the device, copies of
+// a File share the open file.
+
+#include "Arduino.h"
+#include <memory>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+class FileImpl;
+typedef std::shared_ptr<FileImpl> FileImplPtr;
+
+class File : public Stream {
+public:
+    File(FileImplPtr impl = FileImplPtr()) : impl_(impl) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t *buffer, size_t size);
+    void flush();
+    bool seek(uint32_t pos, SeekMode mode);
+    bool seek(uint32_t pos) { return seek(pos, SeekSet); }
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const;
+    // Name without directory and full path
+    const char *name() const;
+    const char *path() const;
+
+    bool isDirectory() const;
+    File openNextFile(const char *mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    FileImplPtr impl_;
+};
+
+class FS {
+public:
+    FS(const std::string &root = "") : root_(root) {}
+    virtual ~FS() {}
+
+    File open(const char *path, const char *mode = FILE_READ, const bool create = false);
+    File open(const std::string &path, const char *mode = FILE_READ, const bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char *path);
+    bool exists(const std::string &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const std::string &path) { return remove(path.c_str()); }
+    bool rename(const char *pathFrom, const char *pathTo);
+    bool rename(const std::string &pathFrom, const std::string &pathTo) { return rename(pathFrom.c_str(), pathTo.c_str()); }
+    bool mkdir(const char *path);
+    bool rmdir(const char *path);
+
+    // Host only: directory of the host holding the files
+    void setRoot(const std::string &root) { root_ = root; }
+    const std::string &root() const { return root_; }
+
+protected:
+    std::string hostPath(const char *path) const;
+
+    std::string root_;
+};
+
+// Host only: simulates a power cut. Each byte written and each file creation, rename and
+// removal uses up one unit of the budget, once it is used up they have no effect.
+// A budget of -1 (default) is unlimited.
+void hostSetWriteBudget(long units);
+long hostWriteBudget();
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif
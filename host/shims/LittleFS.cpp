@@ -0,0 +1,37 @@
+/*
+ * LittleFS.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "LittleFS.h"
+
+#include <sys/stat.h>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel) {
+    if (root_.empty()) {
+        const char *root = getenv("IGNITRON_FS_ROOT");
+        root_ = root != nullptr ? root : "littlefs";
+    }
+    struct stat status;
+    if (stat(root_.c_str(), &status) == 0) {
+        return S_ISDIR(status.st_mode);
+    }
+    return formatOnFail && ::mkdir(root_.c_str(), 0755) == 0;
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    File root = open("/");
+    for (File file = root.openNextFile(); file; file = root.openNextFile()) {
+        used += file.size();
+    }
+    return used;
+}
+
+} // namespace fs
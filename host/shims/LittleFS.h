@@ -0,0 +1,32 @@
+/*
+ * LittleFS.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// LittleFS of the host build, mapped onto a directory: the one set with setRoot(),
+// otherwise the one in the environment variable IGNITRON_FS_ROOT or "littlefs" in
+// the working directory. begin() creates the directory if formatOnFail is set.
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+    bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char *partitionLabel = "spiffs");
+    void end() {}
+    size_t totalBytes() { return 0x160000; }
+    size_t usedBytes();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
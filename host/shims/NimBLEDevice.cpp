@@ -0,0 +1,173 @@
+/*
+ * NimBLEDevice.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "NimBLEDevice.h"
+
+#include <algorithm>
+#include <cctype>
+
+NimBLEAddress::NimBLEAddress(const ble_addr_t &address) {
+    memcpy(address_, address.val, sizeof address_);
+}
+
+std::string NimBLEAddress::toString() const {
+    char text[18];
+    // Stored least significant byte first like in NimBLE
+    snprintf(text, sizeof text, "%02x:%02x:%02x:%02x:%02x:%02x", address_[5], address_[4], address_[3],
+             address_[2], address_[1], address_[0]);
+    return text;
+}
+
+NimBLEUUID::NimBLEUUID(uint16_t uuid) {
+    char text[5];
+    snprintf(text, sizeof text, "%04x", uuid);
+    uuid_ = text;
+}
+
+bool NimBLEUUID::operator==(const NimBLEUUID &other) const {
+    if (uuid_.size() != other.uuid_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < uuid_.size(); i++) {
+        if (tolower(uuid_[i]) != tolower(other.uuid_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool NimBLEAdvertisedDevice::isAdvertisingService(const NimBLEUUID &uuid) const {
+    return std::find(services_.begin(), services_.end(), uuid) != services_.end();
+}
+
+bool NimBLEScan::start(uint32_t duration, void (*scanCompleteCB)(NimBLEScanResults), bool isContinue) {
+    scanCompleteCB_ = scanCompleteCB;
+    isScanning_ = true;
+    return true;
+}
+
+bool NimBLEScan::stop() {
+    bool wasScanning = isScanning_;
+    isScanning_ = false;
+    if (wasScanning && scanCompleteCB_ != nullptr) {
+        scanCompleteCB_(NimBLEScanResults());
+    }
+    return true;
+}
+
+void NimBLEScan::hostReport(NimBLEAdvertisedDevice *device) {
+    if (isScanning_ && callbacks_ != nullptr) {
+        callbacks_->onResult(device);
+    }
+}
+
+void NimBLECharacteristic::hostWrite(const uint8_t *data, size_t length) {
+    setValue(data, length);
+    if (callbacks_ != nullptr) {
+        callbacks_->onWrite(this);
+    }
+}
+
+NimBLECharacteristic *NimBLEService::createCharacteristic(const NimBLEUUID &uuid, uint16_t properties) {
+    characteristics_.emplace_back(new NimBLECharacteristic(uuid, properties));
+    return characteristics_.back().get();
+}
+
+NimBLECharacteristic *NimBLEService::getCharacteristic(const NimBLEUUID &uuid) {
+    for (std::unique_ptr<NimBLECharacteristic> &characteristic : characteristics_) {
+        if (characteristic->getUUID() == uuid) {
+            return characteristic.get();
+        }
+    }
+    return nullptr;
+}
+
+NimBLEService *NimBLEServer::createService(const NimBLEUUID &uuid) {
+    services_.emplace_back(new NimBLEService(uuid));
+    return services_.back().get();
+}
+
+NimBLEService *NimBLEServer::getServiceByUUID(const NimBLEUUID &uuid) {
+    for (std::unique_ptr<NimBLEService> &service : services_) {
+        if (service->getUUID() == uuid) {
+            return service.get();
+        }
+    }
+    return nullptr;
+}
+
+int NimBLEServer::disconnect(uint16_t connHandle, uint8_t reason) {
+    if (connHandle >= connectedCount_) {
+        return -1;
+    }
+    hostDisconnect();
+    return 0;
+}
+
+void NimBLEServer::hostConnect() {
+    connectedCount_++;
+    if (callbacks_ != nullptr) {
+        ble_gap_conn_desc desc = {};
+        callbacks_->onConnect(this, &desc);
+    }
+}
+
+void NimBLEServer::hostDisconnect() {
+    if (connectedCount_ > 0) {
+        connectedCount_--;
+    }
+    if (callbacks_ != nullptr) {
+        callbacks_->onDisconnect(this);
+    }
+}
+
+static std::unique_ptr<NimBLEServer> server;
+static std::vector<std::unique_ptr<NimBLEClient>> clients;
+
+NimBLEScan *NimBLEDevice::getScan() {
+    static NimBLEScan scan;
+    return &scan;
+}
+
+NimBLEServer *NimBLEDevice::createServer() {
+    if (!server) {
+        server.reset(new NimBLEServer());
+    }
+    return server.get();
+}
+
+NimBLEServer *NimBLEDevice::getServer() {
+    return server.get();
+}
+
+NimBLEAdvertising *NimBLEDevice::getAdvertising() {
+    static NimBLEAdvertising advertising;
+    return &advertising;
+}
+
+NimBLEClient *NimBLEDevice::createClient() {
+    clients.emplace_back(new NimBLEClient());
+    return clients.back().get();
+}
+
+bool NimBLEDevice::deleteClient(NimBLEClient *client) {
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        if (it->get() == client) {
+            clients.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t NimBLEDevice::getClientListSize() {
+    return clients.size();
+}
+
+NimBLEClient *NimBLEDevice::getDisconnectedClient() {
+    return clients.empty() ? nullptr : clients.front().get();
+}
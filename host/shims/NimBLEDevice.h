@@ -0,0 +1,296 @@
+/*
+ * NimBLEDevice.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_NIMBLE_DEVICE_H
+#define HOST_NIMBLE_DEVICE_H
+
+// NimBLE-Arduino (1.4) for the host build
+// ---------------------------------------
+// The part of the API used by SparkBTControl. There is no radio: scans find nothing and
+// clients do not connect. The server side works in memory, a test can connect a client,
+// write to a characteristic (hostConnect, hostWrite) and read what has been notified.
+
+#include "Arduino.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define NIMBLE_MAX_CONNECTIONS 3
+#define BLE_SM_PAIR_AUTHREQ_SC 0x08
+
+enum esp_power_level_t {
+    ESP_PWR_LVL_N12 = 0,
+    ESP_PWR_LVL_P9 = 7
+};
+
+namespace NIMBLE_PROPERTY {
+const uint16_t READ = 0x0002;
+const uint16_t WRITE_NR = 0x0004;
+const uint16_t WRITE = 0x0008;
+const uint16_t NOTIFY = 0x0010;
+} // namespace NIMBLE_PROPERTY
+
+struct ble_addr_t {
+    uint8_t type;
+    uint8_t val[6];
+};
+
+struct ble_gap_conn_desc {
+    uint16_t conn_handle;
+    ble_addr_t peer_ota_addr;
+};
+
+class NimBLEAddress {
+public:
+    NimBLEAddress() : address_{} {}
+    NimBLEAddress(const ble_addr_t &address);
+
+    std::string toString() const;
+    operator std::string() const { return toString(); }
+    bool operator==(const NimBLEAddress &other) const { return memcmp(address_, other.address_, 6) == 0; }
+
+private:
+    uint8_t address_[6];
+};
+
+class NimBLEUUID {
+public:
+    NimBLEUUID() {}
+    NimBLEUUID(const std::string &uuid) : uuid_(uuid) {}
+    NimBLEUUID(const char *uuid) : uuid_(uuid) {}
+    NimBLEUUID(uint16_t uuid);
+
+    std::string toString() const { return uuid_; }
+    operator std::string() const { return uuid_; }
+    bool operator==(const NimBLEUUID &other) const;
+
+private:
+    std::string uuid_;
+};
+typedef NimBLEUUID BLEUUID;
+
+class NimBLEAdvertisedDevice {
+public:
+    NimBLEAddress getAddress() const { return address_; }
+    bool isAdvertisingService(const NimBLEUUID &uuid) const;
+
+    // Host only
+    void hostSetService(const NimBLEUUID &uuid) { services_.push_back(uuid); }
+
+private:
+    NimBLEAddress address_;
+    std::vector<NimBLEUUID> services_;
+};
+
+class NimBLEAdvertisedDeviceCallbacks {
+public:
+    virtual ~NimBLEAdvertisedDeviceCallbacks() {}
+    virtual void onResult(NimBLEAdvertisedDevice *advertisedDevice) = 0;
+};
+
+class NimBLEScanResults {
+public:
+    int getCount() const { return 0; }
+};
+
+class NimBLEScan {
+public:
+    void setAdvertisedDeviceCallbacks(NimBLEAdvertisedDeviceCallbacks *callbacks, bool wantDuplicates = false) {
+        callbacks_ = callbacks;
+    }
+    void setInterval(uint16_t interval) {}
+    void setWindow(uint16_t window) {}
+    void setActiveScan(bool active) {}
+    bool start(uint32_t duration, void (*scanCompleteCB)(NimBLEScanResults), bool isContinue = false);
+    bool stop();
+    bool isScanning() const { return isScanning_; }
+
+    // Host only: reports a device as found by the scan
+    void hostReport(NimBLEAdvertisedDevice *device);
+
+private:
+    NimBLEAdvertisedDeviceCallbacks *callbacks_ = nullptr;
+    void (*scanCompleteCB_)(NimBLEScanResults) = nullptr;
+    bool isScanning_ = false;
+};
+
+class NimBLERemoteCharacteristic;
+typedef std::function<void(NimBLERemoteCharacteristic *characteristic, uint8_t *data, size_t length, bool isNotify)>
+    notify_callback;
+
+class NimBLERemoteDescriptor {
+public:
+    bool writeValue(const uint8_t *data, size_t length, bool response = false) { return false; }
+};
+
+class NimBLERemoteCharacteristic {
+public:
+    bool canNotify() const { return false; }
+    NimBLERemoteDescriptor *getDescriptor(const NimBLEUUID &uuid) { return &descriptor_; }
+    bool subscribe(bool notifications = true, notify_callback notifyCallback = nullptr, bool response = false) {
+        return false;
+    }
+    bool writeValue(const uint8_t *data, size_t length, bool response = false) { return false; }
+
+private:
+    NimBLERemoteDescriptor descriptor_;
+};
+
+class NimBLERemoteService {
+public:
+    NimBLERemoteCharacteristic *getCharacteristic(const NimBLEUUID &uuid) { return nullptr; }
+};
+
+class NimBLEClient;
+
+class NimBLEClientCallbacks {
+public:
+    virtual ~NimBLEClientCallbacks() {}
+    virtual void onConnect(NimBLEClient *client) {}
+    virtual void onDisconnect(NimBLEClient *client) {}
+};
+
+// Clients never connect, there is no amp to connect to
+class NimBLEClient {
+public:
+    bool connect(NimBLEAdvertisedDevice *device, bool deleteAttributes = true) { return false; }
+    int disconnect(uint8_t reason = 0) { return 0; }
+    bool isConnected() const { return false; }
+    void setClientCallbacks(NimBLEClientCallbacks *callbacks, bool deleteCallbacks = true) {}
+    void setConnectionParams(uint16_t minInterval, uint16_t maxInterval, uint16_t latency, uint16_t timeout) {}
+    void setConnectTimeout(uint32_t timeout) {}
+    uint16_t getMTU() const { return 23; }
+    NimBLEAddress getPeerAddress() const { return NimBLEAddress(); }
+    NimBLERemoteService *getService(const NimBLEUUID &uuid) { return nullptr; }
+};
+
+class NimBLECharacteristic;
+
+class NimBLECharacteristicCallbacks {
+public:
+    virtual ~NimBLECharacteristicCallbacks() {}
+    virtual void onWrite(NimBLECharacteristic *characteristic) {}
+    virtual void onSubscribe(NimBLECharacteristic *characteristic, ble_gap_conn_desc *desc, uint16_t subValue) {}
+};
+
+class NimBLECharacteristic {
+public:
+    NimBLECharacteristic(const NimBLEUUID &uuid, uint16_t properties) : uuid_(uuid), properties_(properties) {}
+
+    NimBLEUUID getUUID() const { return uuid_; }
+    void setCallbacks(NimBLECharacteristicCallbacks *callbacks) { callbacks_ = callbacks; }
+    void setValue(const uint8_t *data, size_t length) { value_.assign((const char *)data, length); }
+    template <typename T>
+    void setValue(const T &value) { setValue((const uint8_t *)&value, sizeof value); }
+    std::string getValue() const { return value_; }
+    void notify(bool isNotification = true) { notified_.push_back(value_); }
+
+    // Host only: a client writes to the characteristic
+    void hostWrite(const uint8_t *data, size_t length);
+    // Host only: values notified so far
+    std::vector<std::string> &hostNotified() { return notified_; }
+
+private:
+    NimBLEUUID uuid_;
+    uint16_t properties_;
+    NimBLECharacteristicCallbacks *callbacks_ = nullptr;
+    std::string value_;
+    std::vector<std::string> notified_;
+};
+
+class NimBLEService {
+public:
+    NimBLEService(const NimBLEUUID &uuid) : uuid_(uuid) {}
+
+    NimBLECharacteristic *createCharacteristic(const NimBLEUUID &uuid, uint16_t properties);
+    NimBLECharacteristic *getCharacteristic(const NimBLEUUID &uuid);
+    NimBLEUUID getUUID() const { return uuid_; }
+    bool start() { return true; }
+
+private:
+    NimBLEUUID uuid_;
+    std::vector<std::unique_ptr<NimBLECharacteristic>> characteristics_;
+};
+
+class NimBLEServer;
+
+class NimBLEServerCallbacks {
+public:
+    virtual ~NimBLEServerCallbacks() {}
+    virtual void onConnect(NimBLEServer *server, ble_gap_conn_desc *desc) {}
+    virtual void onDisconnect(NimBLEServer *server) {}
+};
+
+class NimBLEConnInfo {
+public:
+    NimBLEConnInfo(uint16_t connHandle) : connHandle_(connHandle) {}
+    uint16_t getConnHandle() const { return connHandle_; }
+
+private:
+    uint16_t connHandle_;
+};
+
+class NimBLEServer {
+public:
+    void setCallbacks(NimBLEServerCallbacks *callbacks, bool deleteCallbacks = true) { callbacks_ = callbacks; }
+    NimBLEService *createService(const NimBLEUUID &uuid);
+    NimBLEService *getServiceByUUID(const NimBLEUUID &uuid);
+    bool startAdvertising() { return true; }
+    bool stopAdvertising() { return true; }
+    size_t getConnectedCount() const { return connectedCount_; }
+    // Clients are numbered in the order they connected
+    NimBLEConnInfo getPeerInfo(size_t index) const { return NimBLEConnInfo(index); }
+    int disconnect(uint16_t connHandle, uint8_t reason = 0);
+
+    // Host only: a client (the app) connects or disconnects
+    void hostConnect();
+    void hostDisconnect();
+
+private:
+    NimBLEServerCallbacks *callbacks_ = nullptr;
+    std::vector<std::unique_ptr<NimBLEService>> services_;
+    size_t connectedCount_ = 0;
+};
+
+class NimBLEAdvertising {
+public:
+    void addServiceUUID(const NimBLEUUID &uuid) {}
+    void setScanResponse(bool enabled) {}
+    bool start() { return true; }
+    bool stop() { return true; }
+};
+
+class NimBLEDevice {
+public:
+    static void init(const std::string &deviceName) {}
+    static void deinit(bool clearAll = false) {}
+    static void setPower(esp_power_level_t powerLevel) {}
+    static void setSecurityAuth(uint8_t authReq) {}
+
+    static NimBLEScan *getScan();
+    static NimBLEServer *createServer();
+    static NimBLEServer *getServer();
+    static NimBLEAdvertising *getAdvertising();
+    static bool startAdvertising() { return true; }
+    static bool stopAdvertising() { return true; }
+
+    static NimBLEClient *createClient();
+    static bool deleteClient(NimBLEClient *client);
+    static size_t getClientListSize();
+    static NimBLEClient *getClientByPeerAddress(const NimBLEAddress &address) { return nullptr; }
+    static NimBLEClient *getDisconnectedClient();
+};
+
+// Names of the original BLE library, as defined by NimBLE-Arduino
+#define BLEDevice NimBLEDevice
+#define BLEServer NimBLEServer
+#define BLEService NimBLEService
+#define BLECharacteristic NimBLECharacteristic
+#define BLEAdvertising NimBLEAdvertising
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ * Wire.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "Wire.h"
+
+TwoWire Wire;
@@ -0,0 +1,42 @@
+/*
+ * Wire.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// I2C of the ESP32 Arduino core for the host build. There is no device on the bus, the
+// bytes of each transmission are only counted.
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+    bool begin() { return true; }
+    bool setClock(uint32_t frequency) {
+        clock_ = frequency;
+        return true;
+    }
+    uint32_t getClock() const { return clock_; }
+    void beginTransmission(uint8_t address) {}
+    size_t write(uint8_t data) { return write(&data, 1); }
+    size_t write(const uint8_t *data, size_t length) {
+        bytesWritten_ += length;
+        return length;
+    }
+    uint8_t endTransmission(bool sendStop = true) { return 0; }
+
+    // Host only: bytes written in all transmissions
+    unsigned long hostBytesWritten() const { return bytesWritten_; }
+
+private:
+    uint32_t clock_ = 100000;
+    unsigned long bytesWritten_ = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
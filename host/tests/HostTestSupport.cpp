@@ -0,0 +1,86 @@
+/*
+ * HostTestSupport.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "HostTestSupport.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "SparkBenchmarkWorkloads.h"
+
+ScratchFileSystem::ScratchFileSystem() {
+    const char *tmpDir = getenv("TMPDIR");
+    std::string pattern = std::string(tmpDir != nullptr ? tmpDir : "/tmp") + "/ignitron-fs-XXXXXX";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+    if (mkdtemp(path.data()) != nullptr) {
+        root_ = path.data();
+    }
+    previousRoot_ = LittleFS.root();
+    LittleFS.setRoot(root_);
+}
+
+ScratchFileSystem::~ScratchFileSystem() {
+    LittleFS.setRoot(previousRoot_);
+    if (!root_.empty()) {
+        std::string command = "rm -rf '" + root_ + "'";
+        if (system(command.c_str()) != 0) {
+            fprintf(stderr, "Could not remove %s\n", root_.c_str());
+        }
+    }
+}
+
+void ScratchFileSystem::writeFile(const char *path, const std::string &content) {
+    std::ofstream file(root_ + path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+std::string ScratchFileSystem::readFile(const char *path) {
+    std::ifstream file(root_ + path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+bool ScratchFileSystem::copyFrom(const std::string &directory) {
+    std::string command = "cp -R '" + directory + "/.' '" + root_ + "'";
+    return !root_.empty() && system(command.c_str()) == 0;
+}
+
+Preset examplePreset(const std::string &name, const std::string &uuid) {
+    Preset preset = SparkBenchmarkWorkloads::examplePreset(name);
+    preset.uuid = uuid;
+    return preset;
+}
+
+std::string presetUUID(int num) {
+    char uuid[40];
+    snprintf(uuid, sizeof uuid, "%08d-1234-1234-1234-123456789012", num);
+    return uuid;
+}
+
+std::string presetFilename(int num) {
+    return "Preset" + std::to_string(num) + ".json";
+}
+
+std::string presetList(int count) {
+    std::string list;
+    for (int i = 0; i < count; i++) {
+        list += presetFilename(i) + " " + presetUUID(i) + "\n";
+    }
+    return list;
+}
+
+std::vector<ByteVector> messageBlocks(const std::vector<CmdData> &message) {
+    std::vector<ByteVector> blocks;
+    for (const CmdData &cmd : message) {
+        blocks.emplace_back(cmd.data.begin(), cmd.data.end());
+    }
+    return blocks;
+}
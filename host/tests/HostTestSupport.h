@@ -0,0 +1,49 @@
+/*
+ * HostTestSupport.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef HOST_TEST_SUPPORT_H
+#define HOST_TEST_SUPPORT_H
+
+// Helpers shared by the host unit tests and benchmarks
+
+#include <LittleFS.h>
+#include <string>
+#include <vector>
+
+#include "SparkTypes.h"
+
+// Points LittleFS to a new, empty directory for the lifetime of the object
+class ScratchFileSystem {
+public:
+    ScratchFileSystem();
+    ~ScratchFileSystem();
+
+    const std::string &root() const { return root_; }
+    // Writes a file of the scratch file system at once
+    void writeFile(const char *path, const std::string &content);
+    std::string readFile(const char *path);
+    // Copies the content of a directory of the host, e.g. data/ with the presets
+    bool copyFrom(const std::string &directory);
+
+private:
+    std::string root_;
+    std::string previousRoot_;
+};
+
+// Preset with a full chain of catalog effects, the name makes it unique
+Preset examplePreset(const std::string &name, const std::string &uuid = "12345678-1234-1234-1234-123456789012");
+
+// UUID and file name of the generated preset number num
+std::string presetUUID(int num);
+std::string presetFilename(int num);
+// Preset list with UUIDs as written by SparkPresetBuilder, one line per generated preset
+std::string presetList(int count);
+
+// Data blocks of a message as sent over BLE
+std::vector<ByteVector> messageBlocks(const std::vector<CmdData> &message);
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * SparkBTControlTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// AMP mode of SparkBTControl (BLE server and Bluetooth serial) against the shims
+
+#include <gtest/gtest.h>
+
+#include "HostTestSupport.h"
+#include "SparkBTControl.h"
+#include "SparkMessage.h"
+
+namespace {
+
+vector<ByteVector> received;
+
+void onReceive(const uint8_t *data, size_t length) {
+    received.emplace_back(data, data + length);
+}
+
+class SparkBTControlTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        received.clear();
+        btControl.setReceiveCallback(&onReceive);
+    }
+
+    SparkBTControl btControl;
+    SparkMessage sparkMessage;
+};
+
+TEST_F(SparkBTControlTest, PassesBLEWritesToReceiveCallback) {
+    btControl.startServer();
+    NimBLEServer *server = NimBLEDevice::getServer();
+    ASSERT_NE(server, nullptr);
+    server->hostConnect();
+    EXPECT_TRUE(btControl.isAppConnected());
+
+    NimBLECharacteristic *writeCharacteristic = server->getServiceByUUID("FFC0")->getCharacteristic("FFC1");
+    ASSERT_NE(writeCharacteristic, nullptr);
+    ByteVector block = messageBlocks(sparkMessage.getSerialNumber(1)).front();
+    writeCharacteristic->hostWrite(block.data(), block.size());
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], block);
+
+    server->hostDisconnect();
+    EXPECT_FALSE(btControl.isAppConnected());
+}
+
+TEST_F(SparkBTControlTest, NotifiesSentBlocks) {
+    btControl.startServer();
+    NimBLECharacteristic *notifyCharacteristic =
+        NimBLEDevice::getServer()->getServiceByUUID("FFC0")->getCharacteristic("FFC2");
+    ASSERT_NE(notifyCharacteristic, nullptr);
+    notifyCharacteristic->hostNotified().clear();
+
+    const BlockData &block = sparkMessage.sendSerialNumber(1).front().data;
+    EXPECT_TRUE(btControl.send(block));
+    ASSERT_EQ(notifyCharacteristic->hostNotified().size(), 1u);
+    EXPECT_EQ(notifyCharacteristic->hostNotified()[0], std::string((const char *)block.data(), block.size()));
+}
+
+TEST_F(SparkBTControlTest, ReassemblesSerialChunks) {
+    btControl.startBTSerial();
+    BluetoothSerial *btSerial = BluetoothSerial::hostInstance();
+    ASSERT_NE(btSerial, nullptr);
+    btSerial->hostConnect(true);
+
+    // Bluetooth serial is a byte stream, chunks arrive in arbitrary pieces
+    vector<ByteVector> blocks = messageBlocks(sparkMessage.changePreset(examplePreset("Serial"), DIR_TO_SPARK, 2));
+    ByteVector stream;
+    for (const ByteVector &block : blocks) {
+        stream.insert(stream.end(), block.begin(), block.end());
+    }
+    for (size_t pos = 0; pos < stream.size(); pos += 7) {
+        btSerial->hostReceive(stream.data() + pos, min((size_t)7, stream.size() - pos));
+    }
+
+    ByteVector reassembled;
+    for (const ByteVector &chunk : received) {
+        EXPECT_EQ(chunk.back(), 0xF7);
+        reassembled.insert(reassembled.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(reassembled, stream);
+    btControl.stopBTSerial();
+}
+
+TEST_F(SparkBTControlTest, DropsOverlongSerialChunks) {
+    btControl.startBTSerial();
+    BluetoothSerial *btSerial = BluetoothSerial::hostInstance();
+    btSerial->hostConnect(true);
+
+    // No end marker within a block, the data up to the next F7 is dropped
+    ByteVector garbage(MAX_BLOCK_SIZE + 10, 0x55);
+    garbage.push_back(0xF7);
+    btSerial->hostReceive(garbage.data(), garbage.size());
+    EXPECT_TRUE(received.empty());
+
+    ByteVector block = messageBlocks(sparkMessage.getSerialNumber(1)).front();
+    btSerial->hostReceive(block.data(), block.size());
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], block);
+    btControl.stopBTSerial();
+}
+
+} // namespace
@@ -0,0 +1,136 @@
+/*
+ * SparkCaptureReplayTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Captures recorded with SparkCapture, saved to the file system and replayed
+
+#include <gtest/gtest.h>
+
+#include "HostTestSupport.h"
+#include "SparkCapture.h"
+#include "SparkCaptureReplay.h"
+#include "SparkMessage.h"
+
+namespace {
+
+std::vector<ByteVector> replayed;
+bool isConnected = false;
+
+void collectPacket(const uint8_t *data, size_t length) {
+    replayed.push_back(ByteVector(data, data + length));
+}
+
+bool checkConnected() {
+    return isConnected;
+}
+
+class SparkCaptureReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        replayed.clear();
+        isConnected = false;
+        capture.clear();
+        capture.setEnabled(true);
+        replay.setPacketHandler(collectPacket, checkConnected);
+    }
+
+    void TearDown() override {
+        replay.stop();
+        replay.setPacketHandler(nullptr);
+    }
+
+    // Records the blocks of a preset message as received, each followed by an ack as sent
+    std::vector<ByteVector> recordSession(unsigned long packetInterval) {
+        std::vector<ByteVector> received = messageBlocks(sparkMessage.changePreset(examplePreset("Replay"), DIR_FROM_SPARK, 1));
+        ByteVector sent = messageBlocks(sparkMessage.sendAck(1, 0x01, DIR_TO_SPARK))[0];
+        for (const ByteVector &block : received) {
+            capture.record(CAPTURE_IN, block);
+            capture.record(CAPTURE_OUT, sent);
+            delay(packetInterval);
+        }
+        EXPECT_TRUE(capture.save());
+        return received;
+    }
+
+    ScratchFileSystem fileSystem;
+    SparkMessage sparkMessage;
+    SparkCapture &capture = SparkCapture::getInstance();
+    SparkCaptureReplay &replay = SparkCaptureReplay::getInstance();
+};
+
+TEST_F(SparkCaptureReplayTest, FullSpeedReplaysReceivedPackets) {
+    std::vector<ByteVector> received = recordSession(0);
+    ASSERT_TRUE(replay.load());
+    ASSERT_TRUE(replay.start(REPLAY_FULL_SPEED));
+
+    EXPECT_FALSE(replay.isRunning());
+    EXPECT_EQ(replayed, received);
+    // Recording is enabled again after the replay
+    EXPECT_TRUE(capture.isEnabled());
+}
+
+TEST_F(SparkCaptureReplayTest, RealTimeKeepsOriginalTiming) {
+    std::vector<ByteVector> received = recordSession(50);
+    ASSERT_GT(received.size(), 2u);
+    ASSERT_TRUE(replay.load());
+    ASSERT_TRUE(replay.start(REPLAY_REAL_TIME));
+    EXPECT_FALSE(capture.isEnabled());
+
+    replay.update();
+    EXPECT_EQ(replayed.size(), 1u);
+    delay(55);
+    replay.update();
+    EXPECT_EQ(replayed.size(), 2u);
+    while (replay.isRunning()) {
+        delay(10);
+        replay.update();
+    }
+    EXPECT_EQ(replayed, received);
+}
+
+TEST_F(SparkCaptureReplayTest, NoReplayWhileConnected) {
+    recordSession(0);
+    ASSERT_TRUE(replay.load());
+    isConnected = true;
+    EXPECT_FALSE(replay.start(REPLAY_FULL_SPEED));
+    EXPECT_FALSE(replay.start(REPLAY_REAL_TIME));
+    EXPECT_TRUE(replayed.empty());
+}
+
+TEST_F(SparkCaptureReplayTest, ConnectionStopsRealTimeReplay) {
+    recordSession(50);
+    ASSERT_TRUE(replay.load());
+    ASSERT_TRUE(replay.start(REPLAY_REAL_TIME));
+    replay.update();
+    ASSERT_EQ(replayed.size(), 1u);
+
+    isConnected = true;
+    delay(200);
+    replay.update();
+    EXPECT_FALSE(replay.isRunning());
+    EXPECT_EQ(replayed.size(), 1u);
+}
+
+TEST_F(SparkCaptureReplayTest, PacketsOfImageStopAtTruncatedRecord) {
+    std::vector<ByteVector> received = recordSession(0);
+    ByteVector image;
+    capture.image(image);
+
+    std::vector<ByteVector> packets;
+    SparkCapture::packets(image, CAPTURE_IN, packets);
+    EXPECT_EQ(packets, received);
+    packets.clear();
+    SparkCapture::packets(image, CAPTURE_OUT, packets);
+    EXPECT_EQ(packets.size(), received.size());
+
+    // The last record (an ack as sent) is cut off
+    image.resize(image.size() - 1);
+    packets.clear();
+    SparkCapture::packets(image, CAPTURE_OUT, packets);
+    EXPECT_EQ(packets.size(), received.size() - 1);
+}
+
+} // namespace
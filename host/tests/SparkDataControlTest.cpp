@@ -0,0 +1,101 @@
+/*
+ * SparkDataControlTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// SparkDataControl in APP mode against the simulated amp (see HostApp), with the
+// presets of data/. Each test runs in its own process and starts with the handshake.
+
+#include <gtest/gtest.h>
+
+#include "HostApp.h"
+#include "HostTestSupport.h"
+#include "SparkStatus.h"
+
+namespace {
+
+class SparkDataControlTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        Serial.setOutputEnabled(false);
+        fileSystem = new ScratchFileSystem();
+        isDataCopied = fileSystem->copyFrom(IGNITRON_DATA_DIR);
+        SimulatedAmpConfig config;
+        config.ampName = AMP_NAME_SPARK_40;
+        HostApp::getInstance().begin(config);
+        isReady = HostApp::getInstance().runUntilReady(30000);
+    }
+
+    static void TearDownTestSuite() {
+        delete fileSystem;
+        fileSystem = nullptr;
+        Serial.setOutputEnabled(true);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(isDataCopied);
+        ASSERT_TRUE(isReady);
+    }
+
+    static ScratchFileSystem *fileSystem;
+    static bool isDataCopied;
+    static bool isReady;
+
+    HostApp &app = HostApp::getInstance();
+    SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+};
+
+ScratchFileSystem *SparkDataControlTest::fileSystem = nullptr;
+bool SparkDataControlTest::isDataCopied = false;
+bool SparkDataControlTest::isReady = false;
+
+TEST_F(SparkDataControlTest, HandshakeReadsAmpAndHWPresets) {
+    EXPECT_TRUE(SparkDataControl::isAmpConnected());
+    EXPECT_EQ(SparkStatus::getInstance().ampName(), AMP_NAME_SPARK_40);
+    EXPECT_EQ(presetControl.numberOfHWBanks(), 1);
+    EXPECT_TRUE(presetControl.allHWPresetsAvailable());
+    // HW presets of the simulated amp are the presets of the first custom bank
+    EXPECT_EQ(presetControl.activeBank(), 0);
+    EXPECT_EQ(presetControl.activePresetNum(), 1);
+    EXPECT_FALSE(presetControl.activePreset().isEmpty);
+    EXPECT_EQ(presetControl.activePreset().name, presetControl.getPreset(1, 1).name);
+}
+
+TEST_F(SparkDataControlTest, SwitchesHWPresetAfterAck) {
+    unsigned long displayBytes = Wire.hostBytesWritten();
+    ASSERT_TRUE(app.dataControl().switchPreset(3, false));
+    app.runFor(200);
+
+    EXPECT_EQ(presetControl.activeBank(), 0);
+    EXPECT_EQ(presetControl.activePresetNum(), 3);
+    EXPECT_FALSE(presetControl.activePreset().isEmpty);
+    EXPECT_EQ(presetControl.activePreset().name, presetControl.getPreset(1, 3).name);
+    // The new preset name has been sent to the display
+    EXPECT_GT(Wire.hostBytesWritten(), displayBytes);
+}
+
+TEST_F(SparkDataControlTest, TogglesEffectAfterAck) {
+    bool isOn = presetControl.activePreset().pedals[INDEX_FX_DRIVE].isOn;
+    ASSERT_TRUE(SparkDataControl::toggleEffect(INDEX_FX_DRIVE));
+    app.runFor(200);
+
+    EXPECT_EQ(presetControl.activePreset().pedals[INDEX_FX_DRIVE].isOn, !isOn);
+}
+
+TEST_F(SparkDataControlTest, SendsCustomPresetInChunks) {
+    presetControl.increaseBank();
+    ASSERT_EQ(presetControl.pendingBank(), 1);
+    ASSERT_TRUE(app.dataControl().switchPreset(2, false));
+    app.runFor(500);
+
+    // Final ack of the preset, then the preset number is set to 128
+    EXPECT_EQ(presetControl.activeBank(), 1);
+    EXPECT_EQ(presetControl.activePresetNum(), 2);
+    EXPECT_FALSE(presetControl.activePreset().isEmpty);
+    EXPECT_EQ(presetControl.activePreset().name, presetControl.getPreset(1, 2).name);
+    EXPECT_EQ(app.amp().pendingNotifications(), 0u);
+}
+
+} // namespace
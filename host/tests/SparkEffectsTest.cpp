@@ -0,0 +1,66 @@
+/*
+ * SparkEffectsTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include <gtest/gtest.h>
+
+#include "SparkEffectCatalog.h"
+#include "SparkEffects.h"
+#include "SparkTypes.h"
+
+namespace {
+
+TEST(SparkEffectsTest, CatalogEffectsHaveFixedIDs) {
+    EffectName twin("Twin");
+    EXPECT_TRUE(twin.isKnown());
+    EXPECT_GE(twin.id(), 1);
+    EXPECT_LE(twin.id(), NUMBER_OF_KNOWN_EFFECTS);
+    EXPECT_EQ(twin.str(), "Twin");
+    EXPECT_EQ(EffectName("Twin"), twin);
+}
+
+TEST(SparkEffectsTest, CatalogHasParameterCountsOfPresets) {
+    // The reference lists 7 parameters, presets of the amp have 8
+    EXPECT_EQ(EffectName("bias.reverb").numParameters(), 8);
+    EXPECT_EQ(EffectName("bias.noisegate").numParameters(), 3);
+    EXPECT_EQ(MAX_PEDAL_PARAMETERS, MAX_KNOWN_EFFECT_PARAMETERS);
+    for (const SparkEffectInfo &effect : KNOWN_EFFECTS) {
+        EXPECT_LE(effect.numParameters, MAX_PEDAL_PARAMETERS) << effect.name;
+    }
+}
+
+TEST(SparkEffectsTest, RuntimeEffectsKeepTheirID) {
+    EffectName custom("HostTestCustomEffect");
+    EXPECT_FALSE(custom.isKnown());
+    EXPECT_GT(custom.id(), NUMBER_OF_KNOWN_EFFECTS);
+    EXPECT_EQ(custom.str(), "HostTestCustomEffect");
+    EXPECT_EQ(EffectName("HostTestCustomEffect").id(), custom.id());
+}
+
+TEST(SparkEffectsTest, TableOfRuntimeEffectsIsCapped) {
+    // E.g. names from corrupted messages, each one different
+    EffectName first("HostTestFloodEffect0");
+    for (int i = 1; i < 70000; i++) {
+        EffectName name("HostTestFloodEffect" + std::to_string(i));
+        if (name.id() != SparkEffects::unknownEffect) {
+            EXPECT_LE(name.id(), NUMBER_OF_KNOWN_EFFECTS + SparkEffects::maxUnknownEffects);
+            EXPECT_EQ(name.str(), "HostTestFloodEffect" + std::to_string(i));
+        }
+    }
+
+    // Names added before keep their ID and name, catalog effects still work
+    EXPECT_EQ(EffectName("HostTestFloodEffect0").id(), first.id());
+    EXPECT_EQ(first.str(), "HostTestFloodEffect0");
+    EXPECT_TRUE(EffectName("Twin").isKnown());
+
+    EffectName overflow("HostTestOverflowEffect");
+    EXPECT_EQ(overflow.id(), SparkEffects::unknownEffect);
+    EXPECT_FALSE(overflow.isKnown());
+    EXPECT_EQ(overflow.str(), "unknown");
+    EXPECT_EQ(overflow.numParameters(), -1);
+}
+
+} // namespace
@@ -0,0 +1,110 @@
+/*
+ * SparkHeapAuditTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Allocations of the main loop in steady state (see SparkHeapAudit.h), with the firmware
+// in APP mode against the simulated amp (see HostApp). Built with AUDIT_HEAP_ALLOCATIONS
+// and the malloc wrappers, so operator new as well as malloc, calloc and realloc count.
+
+#include <gtest/gtest.h>
+
+#include "HostApp.h"
+#include "HostTestSupport.h"
+#include "SparkHeapAudit.h"
+
+namespace {
+
+class SparkHeapAuditTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        Serial.setOutputEnabled(false);
+        fileSystem = new ScratchFileSystem();
+        isDataCopied = fileSystem->copyFrom(IGNITRON_DATA_DIR);
+        SimulatedAmpConfig config;
+        config.ampName = AMP_NAME_SPARK_40;
+        HostApp::getInstance().begin(config);
+        isReady = HostApp::getInstance().runUntilReady(30000);
+    }
+
+    static void TearDownTestSuite() {
+        delete fileSystem;
+        fileSystem = nullptr;
+        Serial.setOutputEnabled(true);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(isDataCopied);
+        ASSERT_TRUE(isReady);
+    }
+
+    // Runs the main loop for ms, returns the allocations of the main loop task in steady state
+    unsigned long allocationsWhileRunning(unsigned long ms) {
+        unsigned long before = audit.totalAllocations();
+        app.runFor(ms);
+        return audit.totalAllocations() - before;
+    }
+
+    // Every action of the test once, so buffers have grown to the size they need
+    void runActions() {
+        SparkDataControl &dataControl = app.dataControl();
+        for (int pre = 2; pre <= PRESETS_PER_BANK; pre++) {
+            dataControl.switchPreset(pre, false);
+            app.runFor(200);
+        }
+        dataControl.switchPreset(1, false);
+        app.runFor(200);
+        SparkDataControl::toggleEffect(INDEX_FX_DRIVE);
+        app.runFor(200);
+        SparkDataControl::toggleEffect(INDEX_FX_DRIVE);
+        app.runFor(200);
+        dataControl.toggleLooperAppMode();
+        app.runFor(2000);
+        dataControl.toggleLooperAppMode();
+        app.runFor(200);
+    }
+
+    static ScratchFileSystem *fileSystem;
+    static bool isDataCopied;
+    static bool isReady;
+
+    HostApp &app = HostApp::getInstance();
+    SparkHeapAudit &audit = SparkHeapAudit::getInstance();
+};
+
+ScratchFileSystem *SparkHeapAuditTest::fileSystem = nullptr;
+bool SparkHeapAuditTest::isDataCopied = false;
+bool SparkHeapAuditTest::isReady = false;
+
+TEST_F(SparkHeapAuditTest, NoAllocationsInSteadyState) {
+    runActions();
+    audit.markSteadyState();
+    // Display and LEDs refresh in every loop, the looper timer runs as well
+    EXPECT_EQ(allocationsWhileRunning(SparkHeapAudit::settleTime + 1000), 0u) << "Refresh";
+
+    SparkDataControl &dataControl = app.dataControl();
+    unsigned long before = audit.totalAllocations();
+    ASSERT_TRUE(dataControl.switchPreset(3, false));
+    EXPECT_EQ(audit.totalAllocations() - before, 0u) << "Sending the HW preset change";
+    // Writing the last preset file on the ack is counted in HEAP_SCOPE_STORAGE, not in the total
+    EXPECT_EQ(allocationsWhileRunning(200), 0u) << "HW preset change";
+    EXPECT_EQ(SparkPresetControl::getInstance().activePresetNum(), 3);
+
+    before = audit.totalAllocations();
+    ASSERT_TRUE(SparkDataControl::toggleEffect(INDEX_FX_DRIVE));
+    EXPECT_EQ(audit.totalAllocations() - before, 0u) << "Sending the effect toggle";
+    EXPECT_EQ(allocationsWhileRunning(200), 0u) << "Effect toggle";
+
+    before = audit.totalAllocations();
+    ASSERT_TRUE(dataControl.toggleLooperAppMode());
+    EXPECT_EQ(audit.totalAllocations() - before, 0u) << "Switching to looper mode";
+    EXPECT_EQ(allocationsWhileRunning(2000), 0u) << "Looper";
+    ASSERT_TRUE(dataControl.toggleLooperAppMode());
+    EXPECT_EQ(allocationsWhileRunning(200), 0u) << "Switching back from looper mode";
+
+    EXPECT_EQ(audit.totalAllocations(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,109 @@
+/*
+ * SparkLoopProfilerTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// SparkLoopProfiler with a virtual clock, the stages take a known number of ticks
+
+#include <gtest/gtest.h>
+
+#include "SparkLoopProfiler.h"
+
+namespace {
+
+uint32_t virtualTicks = 0;
+
+uint32_t virtualClock() {
+    return virtualTicks;
+}
+
+class SparkLoopProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Serial.setOutputEnabled(false);
+        // 10 ticks per us
+        profiler.setClock(virtualClock, 10);
+        // The first loop may print the periodic report, which resets the histograms
+        profiler.beginLoop();
+        profiler.endLoop();
+        profiler.reset();
+    }
+
+    void TearDown() override {
+        Serial.setOutputEnabled(true);
+    }
+
+    // Runs one loop, durations in us
+    void runLoop(uint32_t updates, uint32_t buttons, uint32_t leds, uint32_t display) {
+        profiler.beginLoop();
+        virtualTicks += updates * 10;
+        profiler.endStage(LOOP_STAGE_UPDATES);
+        virtualTicks += buttons * 10;
+        profiler.endStage(LOOP_STAGE_BUTTONS);
+        profiler.endStage(LOOP_STAGE_BATTERY);
+        virtualTicks += leds * 10;
+        profiler.endStage(LOOP_STAGE_LEDS);
+        virtualTicks += display * 10;
+        profiler.endStage(LOOP_STAGE_DISPLAY);
+        profiler.endLoop();
+    }
+
+    SparkLoopProfiler &profiler = SparkLoopProfiler::getInstance();
+};
+
+TEST_F(SparkLoopProfilerTest, MeasuresStagesWithVirtualClock) {
+    // 200 loops, updates take 100 to 299 us, one display refresh takes 20 ms
+    for (uint32_t i = 0; i < 200; i++) {
+        runLoop(100 + i, 5, 40, i == 150 ? 20000 : 0);
+    }
+
+    const DurationHistogram &updates = profiler.histogram(LOOP_STAGE_UPDATES);
+    EXPECT_EQ(updates.count(), 200u);
+    EXPECT_EQ(updates.min(), 100u);
+    EXPECT_EQ(updates.max(), 299u);
+    EXPECT_EQ(updates.average(), 199u);
+    // Percentiles are the upper bound of their bucket, at most 25% above
+    EXPECT_GE(updates.percentile(99), 297u);
+    EXPECT_LE(updates.percentile(99), 299u);
+
+    const DurationHistogram &buttons = profiler.histogram(LOOP_STAGE_BUTTONS);
+    EXPECT_EQ(buttons.min(), 5u);
+    EXPECT_EQ(buttons.max(), 5u);
+    EXPECT_EQ(buttons.percentile(99), 5u);
+
+    const DurationHistogram &battery = profiler.histogram(LOOP_STAGE_BATTERY);
+    EXPECT_EQ(battery.max(), 0u);
+
+    const DurationHistogram &leds = profiler.histogram(LOOP_STAGE_LEDS);
+    EXPECT_EQ(leds.average(), 40u);
+
+    // The single slow refresh shows up in max, not in p99
+    const DurationHistogram &display = profiler.histogram(LOOP_STAGE_DISPLAY);
+    EXPECT_EQ(display.min(), 0u);
+    EXPECT_EQ(display.max(), 20000u);
+    EXPECT_EQ(display.average(), 100u);
+    EXPECT_EQ(display.percentile(99), 0u);
+
+    const DurationHistogram &total = profiler.histogram(LOOP_STAGE_TOTAL);
+    EXPECT_EQ(total.count(), 200u);
+    EXPECT_EQ(total.min(), 100u + 5 + 40);
+    EXPECT_EQ(total.max(), 250u + 5 + 40 + 20000);
+}
+
+TEST_F(SparkLoopProfilerTest, HandlesWrapAroundOfTheClock) {
+    virtualTicks = UINT32_MAX - 500;
+    runLoop(100, 0, 0, 0);
+    EXPECT_EQ(profiler.histogram(LOOP_STAGE_UPDATES).max(), 100u);
+    EXPECT_EQ(profiler.histogram(LOOP_STAGE_TOTAL).max(), 100u);
+}
+
+TEST_F(SparkLoopProfilerTest, ReportResetsTheHistograms) {
+    runLoop(100, 0, 0, 0);
+    profiler.requestReport();
+    runLoop(100, 0, 0, 0);
+    EXPECT_EQ(profiler.histogram(LOOP_STAGE_TOTAL).count(), 0u);
+}
+
+} // namespace
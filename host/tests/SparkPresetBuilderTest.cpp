@@ -0,0 +1,86 @@
+/*
+ * SparkPresetBuilderTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include <gtest/gtest.h>
+
+#include "HostTestSupport.h"
+#include "SparkPresetBuilder.h"
+
+namespace {
+
+void expectSamePreset(const Preset &actual, const Preset &expected) {
+    EXPECT_FALSE(actual.isEmpty);
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.uuid, expected.uuid);
+    EXPECT_EQ(actual.description, expected.description);
+    ASSERT_EQ(actual.pedals.size(), expected.pedals.size());
+    for (size_t i = 0; i < expected.pedals.size(); i++) {
+        EXPECT_EQ(actual.pedals[i].name, expected.pedals[i].name);
+        EXPECT_EQ(actual.pedals[i].isOn, expected.pedals[i].isOn);
+        ASSERT_EQ(actual.pedals[i].parameters.size(), expected.pedals[i].parameters.size());
+        for (size_t p = 0; p < expected.pedals[i].parameters.size(); p++) {
+            EXPECT_NEAR(actual.pedals[i].parameters[p].value, expected.pedals[i].parameters[p].value, 0.0001);
+        }
+    }
+}
+
+class SparkPresetBuilderTest : public ::testing::Test {
+protected:
+    ScratchFileSystem fileSystem;
+    SparkPresetBuilder presetBuilder;
+};
+
+TEST_F(SparkPresetBuilderTest, ParsesPresetFromString) {
+    Preset preset = examplePreset("From String");
+    std::string json = preset.getJson();
+    expectSamePreset(presetBuilder.getPresetFromJson(json.c_str()), preset);
+}
+
+TEST_F(SparkPresetBuilderTest, ParsesPresetFromFile) {
+    // Larger than the read buffer, so the file is read in several blocks
+    Preset preset = examplePreset("From File");
+    std::string json = preset.getJson();
+    ASSERT_GT(json.size(), 256u);
+    fileSystem.writeFile("/Preset.json", json);
+
+    File file = LittleFS.open("/Preset.json");
+    expectSamePreset(presetBuilder.getPresetFromJson(file), preset);
+}
+
+TEST_F(SparkPresetBuilderTest, ReturnsEmptyPresetForTruncatedFile) {
+    std::string json = examplePreset("Truncated").getJson();
+    fileSystem.writeFile("/Preset.json", json.substr(0, json.size() / 2));
+
+    File file = LittleFS.open("/Preset.json");
+    EXPECT_TRUE(presetBuilder.getPresetFromJson(file).isEmpty);
+}
+
+TEST_F(SparkPresetBuilderTest, StoreAndDeleteInDirectoryLeaveRootUntouched) {
+    fileSystem.writeFile("/PresetListUUIDs.txt", presetList(4));
+    ASSERT_TRUE(LittleFS.mkdir("/bench"));
+    fileSystem.writeFile("/bench/PresetListUUIDs.txt", "");
+    presetBuilder.setDirectory("/bench");
+    presetBuilder.init();
+    ASSERT_EQ(presetBuilder.numberOfPresets(), 0);
+
+    Preset stored = examplePreset("Stored");
+    ASSERT_EQ(presetBuilder.storePreset(stored, 1, 1), STORE_PRESET_OK);
+    EXPECT_TRUE(LittleFS.exists("/bench/Stored.json"));
+    ASSERT_EQ(presetBuilder.numberOfPresets(), 1);
+    expectSamePreset(presetBuilder.getPreset(1, 1), stored);
+
+    EXPECT_EQ(presetBuilder.deletePreset(1, 1), DELETE_PRESET_OK);
+    EXPECT_FALSE(LittleFS.exists("/bench/Stored.json"));
+    EXPECT_EQ(presetBuilder.numberOfPresets(), 0);
+
+    EXPECT_EQ(fileSystem.readFile("/PresetListUUIDs.txt"), presetList(4));
+    EXPECT_FALSE(LittleFS.exists("/PresetIndex.bin"));
+    EXPECT_FALSE(LittleFS.exists("/PresetList.journal"));
+    EXPECT_FALSE(LittleFS.exists("/Stored.json"));
+}
+
+} // namespace
@@ -0,0 +1,206 @@
+/*
+ * SparkPresetIndexCrashTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Crash consistency of the preset journal and the compaction: each operation is cut
+// off after every possible number of written bytes (hostSetWriteBudget), then the
+// index is opened again like on boot. The preset list must be either the one before
+// or the one after the operation.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "HostTestSupport.h"
+#include "SparkPresetIndex.h"
+
+namespace {
+
+const char *listFileName = "/PresetList.txt";
+const char *uuidListFileName = "/PresetListUUIDs.txt";
+const char *journalFileName = "/PresetList.journal";
+const int presetsPerBank = 4;
+
+typedef std::vector<std::string> PresetListState;
+typedef std::function<void(SparkPresetIndex &)> IndexOperation;
+
+PresetListState stateOf(SparkPresetIndex &index) {
+    PresetListState state;
+    PresetIndexRecord record;
+    for (int position = 0; position < index.numberOfPresets(); position++) {
+        if (!index.getRecord(position, record)) {
+            state.push_back("<unreadable>");
+            continue;
+        }
+        state.push_back(std::string(record.filename) + " " + record.uuid);
+    }
+    return state;
+}
+
+class SparkPresetIndexCrashTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        fs::hostSetWriteBudget(-1);
+    }
+
+    // Opens the index like SparkPresetBuilder does on boot
+    PresetListState boot() {
+        SparkPresetIndex index;
+        EXPECT_TRUE(index.build(uuidListFileName));
+        if (index.isJournalFull()) {
+            EXPECT_TRUE(index.compact(listFileName, uuidListFileName, presetsPerBank));
+        }
+        EXPECT_FALSE(index.isJournalFull());
+        return stateOf(index);
+    }
+
+    // Starts from a list of 8 presets, prepare runs without power cut
+    void start(SparkPresetIndex &index, const IndexOperation &prepare) {
+        const char *files[] = {listFileName, uuidListFileName, journalFileName, "/PresetIndex.bin",
+                               "/PresetList.txt.tmp", "/PresetListUUIDs.txt.tmp", "/PresetList.journal.tmp"};
+        for (const char *file : files) {
+            LittleFS.remove(file);
+        }
+        fileSystem.writeFile(uuidListFileName, presetList(8));
+        ASSERT_TRUE(index.build(uuidListFileName));
+        prepare(index);
+    }
+
+    // Runs the operation with every possible power cut, checks the state after the next boot
+    void sweep(const IndexOperation &prepare, const IndexOperation &operation) {
+        PresetListState before;
+        PresetListState after;
+        {
+            SparkPresetIndex index;
+            start(index, prepare);
+            before = stateOf(index);
+            operation(index);
+            after = stateOf(index);
+        }
+        ASSERT_EQ(boot(), after);
+
+        for (long budget = 0;; budget++) {
+            {
+                SparkPresetIndex index;
+                start(index, prepare);
+                fs::hostSetWriteBudget(budget);
+                operation(index);
+            }
+            bool isComplete = fs::hostWriteBudget() > 0;
+            fs::hostSetWriteBudget(-1);
+
+            PresetListState state = boot();
+            EXPECT_TRUE(state == before || state == after) << "power cut after " << budget << " units";
+            // Booting again must not change anything
+            EXPECT_EQ(boot(), state) << "power cut after " << budget << " units";
+            if (isComplete) {
+                EXPECT_EQ(state, after);
+                break;
+            }
+        }
+    }
+
+    ScratchFileSystem fileSystem;
+};
+
+TEST_F(SparkPresetIndexCrashTest, InterruptedFirstJournalAppend) {
+    sweep([](SparkPresetIndex &) {},
+          [](SparkPresetIndex &index) { index.insert(3, "New.json", presetUUID(100)); });
+}
+
+TEST_F(SparkPresetIndexCrashTest, InterruptedJournalAppend) {
+    sweep(
+        [](SparkPresetIndex &index) {
+            index.insert(0, "First.json", presetUUID(100));
+            index.remove(5);
+        },
+        [](SparkPresetIndex &index) { index.remove(2); });
+}
+
+TEST_F(SparkPresetIndexCrashTest, InterruptedCompaction) {
+    sweep(
+        [](SparkPresetIndex &index) {
+            index.insert(8, "Last.json", presetUUID(100));
+            index.remove(1);
+            index.insert(4, "Middle.json", presetUUID(101));
+        },
+        [](SparkPresetIndex &index) { index.compact(listFileName, uuidListFileName, presetsPerBank); });
+}
+
+TEST_F(SparkPresetIndexCrashTest, InterruptedCompactionOfUnchangedList) {
+    // Journal is full, but its changes cancel out: the compacted list is identical to the old one
+    sweep(
+        [](SparkPresetIndex &index) {
+            for (int i = 0; i < PRESET_JOURNAL_MAX_ENTRIES / 2; i++) {
+                index.insert(8, "Stored.json", presetUUID(100));
+                index.remove(8);
+            }
+        },
+        [](SparkPresetIndex &index) { index.compact(listFileName, uuidListFileName, presetsPerBank); });
+}
+
+TEST_F(SparkPresetIndexCrashTest, InterruptedRewriteOfTornJournal) {
+    PresetListState expected;
+    IndexOperation prepare = [this](SparkPresetIndex &index) {
+        index.insert(0, "First.json", presetUUID(100));
+        index.insert(0, "Second.json", presetUUID(101));
+        index.insert(0, "Torn.json", presetUUID(102));
+        index.close();
+        // Last entry only partially written
+        std::string journal = fileSystem.readFile(journalFileName);
+        fileSystem.writeFile(journalFileName, journal.substr(0, journal.size() - 10));
+    };
+    {
+        SparkPresetIndex index;
+        start(index, [](SparkPresetIndex &index) {
+            index.insert(0, "First.json", presetUUID(100));
+            index.insert(0, "Second.json", presetUUID(101));
+        });
+        expected = stateOf(index);
+    }
+
+    // Dropping the torn entry on boot is interrupted
+    for (long budget = 0;; budget++) {
+        {
+            SparkPresetIndex index;
+            start(index, prepare);
+        }
+        fs::hostSetWriteBudget(budget);
+        {
+            SparkPresetIndex index;
+            index.build(uuidListFileName);
+        }
+        bool isComplete = fs::hostWriteBudget() > 0;
+        fs::hostSetWriteBudget(-1);
+
+        EXPECT_EQ(boot(), expected) << "power cut after " << budget << " units";
+        if (isComplete) {
+            break;
+        }
+    }
+    EXPECT_EQ(fileSystem.readFile(journalFileName).size(), sizeof(PresetJournalHeader) + 2 * sizeof(PresetJournalEntry));
+}
+
+TEST_F(SparkPresetIndexCrashTest, CompactionOfUnchangedListRemovesJournal) {
+    SparkPresetIndex index;
+    start(index, [](SparkPresetIndex &) {});
+    PresetListState before = stateOf(index);
+    for (int i = 0; i < PRESET_JOURNAL_MAX_ENTRIES / 2; i++) {
+        ASSERT_TRUE(index.insert(8, "Stored.json", presetUUID(100)));
+        ASSERT_TRUE(index.remove(8));
+    }
+    ASSERT_TRUE(index.isJournalFull());
+    ASSERT_TRUE(index.compact(listFileName, uuidListFileName, presetsPerBank));
+
+    EXPECT_FALSE(index.isJournalFull());
+    EXPECT_FALSE(LittleFS.exists(journalFileName));
+    EXPECT_EQ(stateOf(index), before);
+    EXPECT_EQ(fileSystem.readFile(uuidListFileName), presetList(8));
+    EXPECT_EQ(fileSystem.readFile(listFileName), "-- Bank 1 \nPreset0.json\nPreset1.json\nPreset2.json\nPreset3.json\n"
+                                                 "-- Bank 2 \nPreset4.json\nPreset5.json\nPreset6.json\nPreset7.json\n");
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+/*
+ * SparkPresetIndexTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include <gtest/gtest.h>
+
+#include "HostTestSupport.h"
+#include "SparkPresetIndex.h"
+
+namespace {
+
+const char *listFileName = "/PresetList.txt";
+
+class SparkPresetIndexTest : public ::testing::Test {
+protected:
+    ScratchFileSystem fileSystem;
+    SparkPresetIndex index;
+};
+
+TEST_F(SparkPresetIndexTest, LooksUpByPositionAndUUID) {
+    fileSystem.writeFile(listFileName, presetList(20));
+    ASSERT_TRUE(index.build(listFileName));
+    ASSERT_EQ(index.numberOfPresets(), 20);
+
+    PresetIndexRecord record;
+    ASSERT_TRUE(index.getRecord(13, record));
+    EXPECT_STREQ(record.filename, presetFilename(13).c_str());
+    EXPECT_STREQ(record.uuid, presetUUID(13).c_str());
+    EXPECT_EQ(index.findUUID(presetUUID(7)), 7);
+    EXPECT_EQ(index.findUUID(presetUUID(99)), -1);
+    EXPECT_FALSE(index.getRecord(20, record));
+}
+
+TEST_F(SparkPresetIndexTest, AppliesJournalAfterReopen) {
+    fileSystem.writeFile(listFileName, presetList(8));
+    ASSERT_TRUE(index.build(listFileName));
+    ASSERT_TRUE(index.insert(8, "Added.json", presetUUID(100)));
+    ASSERT_TRUE(index.remove(0));
+    index.close();
+
+    SparkPresetIndex reopened;
+    ASSERT_TRUE(reopened.build(listFileName));
+    EXPECT_EQ(reopened.numberOfPresets(), 8);
+    PresetIndexRecord record;
+    ASSERT_TRUE(reopened.getRecord(0, record));
+    EXPECT_STREQ(record.filename, presetFilename(1).c_str());
+    ASSERT_TRUE(reopened.getRecord(7, record));
+    EXPECT_STREQ(record.filename, "Added.json");
+    EXPECT_EQ(reopened.findUUID(presetUUID(100)), 7);
+    EXPECT_EQ(reopened.findUUID(presetUUID(0)), -1);
+}
+
+TEST_F(SparkPresetIndexTest, RebuildsWhenListChanges) {
+    fileSystem.writeFile(listFileName, presetList(4));
+    ASSERT_TRUE(index.build(listFileName));
+    index.close();
+
+    fileSystem.writeFile(listFileName, presetList(6));
+    SparkPresetIndex rebuilt;
+    ASSERT_TRUE(rebuilt.build(listFileName));
+    EXPECT_EQ(rebuilt.numberOfPresets(), 6);
+}
+
+TEST_F(SparkPresetIndexTest, SkipsLinesLongerThanTheLineBuffer) {
+    // 127 characters fit into the buffer, with or without carriage return
+    std::string fitting = "Fitting.json " + presetUUID(1);
+    fitting += " " + std::string(127 - fitting.size() - 1, 'x');
+    ASSERT_EQ(fitting.size(), 127u);
+    std::string tooLong = "TooLong.json " + presetUUID(2) + " " + std::string(200, 'y');
+    fileSystem.writeFile(listFileName, presetFilename(0) + " " + presetUUID(0) + "\n" + tooLong + "\n" + fitting + "\r\n" +
+                                           fitting + "\n" + presetFilename(3) + " " + presetUUID(3));
+
+    ASSERT_TRUE(index.build(listFileName));
+    // The rest of the long line must not show up as another record
+    ASSERT_EQ(index.numberOfPresets(), 4);
+    PresetIndexRecord record;
+    ASSERT_TRUE(index.getRecord(1, record));
+    EXPECT_STREQ(record.filename, "Fitting.json");
+    EXPECT_STREQ(record.uuid, presetUUID(1).c_str());
+    ASSERT_TRUE(index.getRecord(2, record));
+    EXPECT_STREQ(record.filename, "Fitting.json");
+    ASSERT_TRUE(index.getRecord(3, record));
+    EXPECT_STREQ(record.filename, presetFilename(3).c_str());
+    EXPECT_EQ(index.findUUID(presetUUID(2)), -1);
+}
+
+} // namespace
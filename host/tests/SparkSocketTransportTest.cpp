@@ -0,0 +1,123 @@
+/*
+ * SparkSocketTransportTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// SparkSocketTransport: app and amp side connected over a Unix socket in one process
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "HostTestSupport.h"
+#include "SparkMessage.h"
+#include "SparkSocketTransport.h"
+#include "SparkStreamReader.h"
+
+namespace {
+
+// Callbacks are called from the receive threads
+std::mutex eventMutex;
+std::condition_variable eventCondition;
+vector<ByteVector> ampReceived;
+vector<ByteVector> appReceived;
+vector<bool> ampConnectionEvents;
+
+void onAmpReceive(const uint8_t *data, size_t length) {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    ampReceived.emplace_back(data, data + length);
+    eventCondition.notify_all();
+}
+
+void onAppReceive(const uint8_t *data, size_t length) {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    appReceived.emplace_back(data, data + length);
+    eventCondition.notify_all();
+}
+
+void onAmpConnection(bool isConnected) {
+    std::lock_guard<std::mutex> lock(eventMutex);
+    ampConnectionEvents.push_back(isConnected);
+    eventCondition.notify_all();
+}
+
+bool waitFor(const std::function<bool()> &condition) {
+    std::unique_lock<std::mutex> lock(eventMutex);
+    return eventCondition.wait_for(lock, std::chrono::seconds(2), condition);
+}
+
+class SparkSocketTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ampReceived.clear();
+        appReceived.clear();
+        ampConnectionEvents.clear();
+        amp.setReceiveCallback(&onAmpReceive);
+        amp.setConnectionCallback(&onAmpConnection);
+        app.setReceiveCallback(&onAppReceive);
+        ASSERT_TRUE(amp.listen(path));
+        ASSERT_TRUE(app.connect(path));
+        ASSERT_TRUE(waitFor([] { return ampConnectionEvents.size() == 1; }));
+    }
+
+    void TearDown() override {
+        app.close();
+        amp.close();
+    }
+
+    std::string path = ::testing::TempDir() + "ignitron_transport.sock";
+    SparkSocketTransport amp;
+    SparkSocketTransport app;
+    SparkMessage sparkMessage;
+};
+
+TEST_F(SparkSocketTransportTest, KeepsBlockBoundaries) {
+    EXPECT_TRUE(amp.isConnected());
+    EXPECT_TRUE(app.isConnected());
+
+    const vector<CmdData> &message = sparkMessage.changePreset(examplePreset("Socket"), DIR_TO_SPARK, 3);
+    vector<ByteVector> blocks = messageBlocks(message);
+    ASSERT_GT(blocks.size(), 1u);
+    for (const CmdData &block : message) {
+        EXPECT_TRUE(app.send(block.data));
+    }
+    ASSERT_TRUE(waitFor([&] { return ampReceived.size() == blocks.size(); }));
+    EXPECT_EQ(ampReceived, blocks);
+}
+
+TEST_F(SparkSocketTransportTest, DeliversResponsesToStreamReader) {
+    for (const CmdData &block : sparkMessage.sendSerialNumber(4)) {
+        EXPECT_TRUE(amp.send(block.data));
+    }
+    ASSERT_TRUE(waitFor([] { return !appReceived.empty(); }));
+
+    SparkStreamReader reader;
+    MessageProcessStatus status = MSG_PROCESS_RES_INCOMPLETE;
+    for (ByteVector &block : appReceived) {
+        status = reader.processBlock(block);
+    }
+    EXPECT_EQ(status, MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(SparkStatus::getInstance().ampSerialNumber(), "S999C999B999");
+}
+
+TEST_F(SparkSocketTransportTest, AcceptsNewClientAfterDisconnect) {
+    app.close();
+    ASSERT_TRUE(waitFor([] { return ampConnectionEvents.size() == 2; }));
+    EXPECT_FALSE(ampConnectionEvents[1]);
+    EXPECT_FALSE(amp.isConnected());
+    EXPECT_FALSE(app.isConnected());
+    EXPECT_FALSE(amp.send(sparkMessage.sendSerialNumber(5).front().data));
+
+    ASSERT_TRUE(app.connect(path));
+    ASSERT_TRUE(waitFor([] { return ampConnectionEvents.size() == 3; }));
+    EXPECT_TRUE(ampConnectionEvents[2]);
+    EXPECT_TRUE(amp.send(sparkMessage.sendSerialNumber(6).front().data));
+    ASSERT_TRUE(waitFor([] { return appReceived.size() == 1; }));
+}
+
+} // namespace
@@ -0,0 +1,178 @@
+/*
+ * SparkStreamReaderTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Messages built by SparkMessage as the amp sends them, decoded by SparkStreamReader
+
+#include <gtest/gtest.h>
+
+#include "HostTestSupport.h"
+#include "SparkMessage.h"
+#include "SparkStatus.h"
+#include "SparkStreamReader.h"
+
+namespace {
+
+class SparkStreamReaderTest : public ::testing::Test {
+protected:
+    // Feeds all blocks of a message, returns the result of the last one
+    MessageProcessStatus receive(const vector<CmdData> &message) {
+        MessageProcessStatus result = MSG_PROCESS_RES_INCOMPLETE;
+        for (ByteVector &block : messageBlocks(message)) {
+            result = reader.processBlock(block);
+        }
+        return result;
+    }
+
+    // F0 01 ... F7 chunks of a message without the 01FE headers of the blocks
+    vector<ByteVector> chunks(const vector<CmdData> &message) {
+        ByteVector content;
+        for (const ByteVector &block : messageBlocks(message)) {
+            content.insert(content.end(), block.begin() + 16, block.end());
+        }
+        vector<ByteVector> result;
+        auto chunkStart = content.begin();
+        for (auto it = content.begin(); it != content.end(); ++it) {
+            if (*it == 0xF7) {
+                result.emplace_back(chunkStart, it + 1);
+                chunkStart = it + 1;
+            }
+        }
+        return result;
+    }
+
+    SparkMessage sparkMessage;
+    SparkStreamReader reader;
+    SparkStatus &status = SparkStatus::getInstance();
+};
+
+TEST_F(SparkStreamReaderTest, DecodesSerialNumber) {
+    ASSERT_EQ(receive(sparkMessage.sendSerialNumber(1)), MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(status.lastMessageType(), MSG_TYPE_AMP_SERIAL);
+    EXPECT_FALSE(status.ampSerialNumber().empty());
+}
+
+TEST_F(SparkStreamReaderTest, DecodesAmpName) {
+    ASSERT_EQ(receive(sparkMessage.sendAmpName(2, "Spark MINI")), MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(status.lastMessageType(), MSG_TYPE_AMP_NAME);
+    EXPECT_EQ(status.ampName(), "Spark MINI");
+}
+
+TEST_F(SparkStreamReaderTest, DecodesMultiChunkPreset) {
+    Preset sent = examplePreset("Round Trip");
+    const vector<CmdData> &message = sparkMessage.changePreset(sent, DIR_FROM_SPARK, 3);
+    ASSERT_GT(message.size(), 1u);
+    ASSERT_EQ(receive(message), MSG_PROCESS_RES_COMPLETE);
+
+    EXPECT_EQ(status.lastMessageType(), MSG_TYPE_PRESET);
+    const Preset &received = status.currentPreset();
+    EXPECT_EQ(received.name, sent.name);
+    EXPECT_EQ(received.uuid, sent.uuid);
+    EXPECT_EQ(received.description, sent.description);
+    ASSERT_EQ(received.pedals.size(), sent.pedals.size());
+    for (int i = 0; i < sent.pedals.size(); i++) {
+        const Pedal &sentPedal = sent.pedals[i];
+        const Pedal &receivedPedal = received.pedals[i];
+        EXPECT_EQ(receivedPedal.name, sentPedal.name) << "pedal " << i;
+        EXPECT_EQ(receivedPedal.isOn, sentPedal.isOn) << "pedal " << i;
+        ASSERT_EQ(receivedPedal.parameters.size(), sentPedal.parameters.size()) << "pedal " << i;
+        for (int p = 0; p < sentPedal.parameters.size(); p++) {
+            EXPECT_FLOAT_EQ(receivedPedal.parameters[p].value, sentPedal.parameters[p].value);
+        }
+    }
+}
+
+TEST_F(SparkStreamReaderTest, IncompletePresetIsNotReported) {
+    const vector<CmdData> &message = sparkMessage.changePreset(examplePreset("Partial"), DIR_FROM_SPARK, 4);
+    vector<ByteVector> blocks = messageBlocks(message);
+    ASSERT_GT(blocks.size(), 1u);
+    EXPECT_EQ(reader.processBlock(blocks[0]), MSG_PROCESS_RES_INCOMPLETE);
+}
+
+TEST_F(SparkStreamReaderTest, ReadsTunerFrame) {
+    const vector<CmdData> &message = sparkMessage.sendTunerOutput(5, 7, 0.25);
+    ASSERT_EQ(message.size(), 1u);
+    byte note = 0;
+    float offset = 0;
+    ASSERT_TRUE(SparkStreamReader::readTunerFrame(message[0].data.data(), message[0].data.size(), note, offset));
+    EXPECT_EQ(note, 7);
+    EXPECT_NEAR(offset, 0.25, 0.001);
+}
+
+TEST_F(SparkStreamReaderTest, RejectsChunkWithWrongChecksum) {
+    vector<ByteVector> blocks = messageBlocks(sparkMessage.sendAmpName(7, "Spark GO"));
+    ASSERT_EQ(blocks.size(), 1u);
+    ASSERT_EQ(blocks[0][16], 0xF0);
+    // Checksum is the 4th byte of the chunk
+    blocks[0][16 + 3] ^= 0x01;
+    status.ampName() = "";
+
+    EXPECT_EQ(reader.processBlock(blocks[0]), MSG_PROCESS_RES_INCOMPLETE);
+    EXPECT_EQ(reader.checksumErrors(), 1u);
+    EXPECT_EQ(status.ampName(), "");
+
+    AckData corrupted;
+    ASSERT_TRUE(reader.getCorruptedMessageAndEmpty(corrupted));
+    EXPECT_EQ(corrupted.msgNum, 7);
+    EXPECT_EQ(corrupted.cmd, 0x03);
+    EXPECT_EQ(corrupted.subcmd, 0x11);
+    EXPECT_FALSE(reader.getCorruptedMessageAndEmpty(corrupted));
+
+    // The next message is decoded again
+    ASSERT_EQ(receive(sparkMessage.sendAmpName(8, "Spark GO")), MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(status.ampName(), "Spark GO");
+    EXPECT_EQ(reader.checksumErrors(), 1u);
+}
+
+TEST_F(SparkStreamReaderTest, ResyncsOnNextChunkAfterGarbage) {
+    vector<ByteVector> blocks = messageBlocks(sparkMessage.sendAmpName(9, "Spark NEO"));
+    ASSERT_EQ(blocks.size(), 1u);
+    ByteVector &block = blocks[0];
+    const byte garbage[] = {0x12, 0xF7, 0x34, 0xF0, 0x56};
+    block.insert(block.begin() + 16, garbage, garbage + sizeof garbage);
+
+    ASSERT_EQ(reader.processBlock(block), MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(status.ampName(), "Spark NEO");
+    EXPECT_EQ(reader.skippedBytes(), sizeof garbage);
+    EXPECT_EQ(reader.resyncs(), 1u);
+    EXPECT_EQ(reader.checksumErrors(), 0u);
+}
+
+TEST_F(SparkStreamReaderTest, DropsMultiChunkMessageWithMissingChunk) {
+    vector<ByteVector> dropped = chunks(sparkMessage.changePreset(examplePreset("Dropped"), DIR_FROM_SPARK, 10));
+    ASSERT_GE(dropped.size(), 3u);
+    // Second chunk is lost, the following chunks can't be attached
+    EXPECT_EQ(reader.processBlock(dropped[0]), MSG_PROCESS_RES_INCOMPLETE);
+    for (size_t i = 2; i < dropped.size(); i++) {
+        EXPECT_EQ(reader.processBlock(dropped[i]), MSG_PROCESS_RES_INCOMPLETE) << "chunk " << i;
+    }
+    EXPECT_EQ(reader.rejectedChunks(), dropped.size() - 2);
+    EXPECT_EQ(reader.resyncs(), dropped.size() - 2);
+
+    // The first chunk of the next message drops the incomplete one
+    vector<ByteVector> complete = chunks(sparkMessage.changePreset(examplePreset("Complete"), DIR_FROM_SPARK, 11));
+    MessageProcessStatus result = MSG_PROCESS_RES_INCOMPLETE;
+    for (ByteVector &chunk : complete) {
+        result = reader.processBlock(chunk);
+    }
+    ASSERT_EQ(result, MSG_PROCESS_RES_COMPLETE);
+    EXPECT_EQ(status.currentPreset().name, "Complete");
+    EXPECT_EQ(reader.rejectedChunks(), dropped.size() - 1);
+}
+
+TEST_F(SparkStreamReaderTest, DropsChunksOutOfOrder) {
+    vector<ByteVector> swapped = chunks(sparkMessage.changePreset(examplePreset("Swapped"), DIR_FROM_SPARK, 12));
+    ASSERT_GE(swapped.size(), 2u);
+    std::swap(swapped[0], swapped[1]);
+    status.currentPreset().name = "";
+    for (ByteVector &chunk : swapped) {
+        EXPECT_EQ(reader.processBlock(chunk), MSG_PROCESS_RES_INCOMPLETE);
+    }
+    EXPECT_EQ(status.currentPreset().name, "");
+    EXPECT_GT(reader.resyncs(), 0u);
+}
+
+} // namespace
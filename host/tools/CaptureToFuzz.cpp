@@ -0,0 +1,107 @@
+/*
+ * CaptureToFuzz.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Fuzz seeds from a capture
+// -------------------------
+//   ignitron_capture_to_fuzz CAPTURE DIR
+// Converts the received packets (CAPTURE_IN) of a capture image (see SparkCapture.h)
+// to inputs of the SparkStreamReader fuzz target (host/fuzz): each packet becomes a
+// length byte followed by the packet, packets longer than 255 bytes are split into
+// several blocks like a smaller MTU would do. The packets received between two sent
+// packets (the responses to one request) form one input, so messages spanning several
+// packets stay together. One more input holds the whole session. Inputs with the same
+// content are written once, as DIR/capture-N.
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "SparkCapture.h"
+
+namespace {
+
+typedef std::vector<uint8_t> FuzzInput;
+
+const size_t maxBlockLength = 255;
+
+void appendPacket(FuzzInput &input, const uint8_t *data, size_t length) {
+    do {
+        size_t blockLength = length < maxBlockLength ? length : maxBlockLength;
+        input.push_back(blockLength);
+        input.insert(input.end(), data, data + blockLength);
+        data += blockLength;
+        length -= blockLength;
+    } while (length > 0);
+}
+
+std::vector<FuzzInput> convert(const ByteVector &image) {
+    std::vector<FuzzInput> inputs;
+    FuzzInput response;
+    FuzzInput session;
+    size_t pos = SparkCapture::imageHeaderSize;
+    uint32_t timestamp;
+    CaptureDirection direction;
+    const uint8_t *data;
+    size_t length;
+    while (SparkCapture::readRecord(image, pos, timestamp, direction, data, length)) {
+        if (direction == CAPTURE_OUT) {
+            if (!response.empty()) {
+                inputs.push_back(response);
+                response.clear();
+            }
+            continue;
+        }
+        appendPacket(response, data, length);
+        appendPacket(session, data, length);
+    }
+    if (!response.empty()) {
+        inputs.push_back(response);
+    }
+    if (inputs.size() > 1) {
+        inputs.push_back(session);
+    }
+    return inputs;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s CAPTURE DIR\n", argv[0]);
+        return 2;
+    }
+    std::ifstream file(argv[1], std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string imageData = content.str();
+    ByteVector image(imageData.begin(), imageData.end());
+    if (!file || image.size() < SparkCapture::imageHeaderSize || imageData.compare(0, 4, "SPKC") != 0
+        || image[4] != SparkCapture::imageVersion) {
+        fprintf(stderr, "%s is not a valid capture\n", argv[1]);
+        return 1;
+    }
+
+    std::set<FuzzInput> written;
+    int count = 0;
+    for (const FuzzInput &input : convert(image)) {
+        if (!written.insert(input).second) {
+            continue;
+        }
+        std::string path = std::string(argv[2]) + "/capture-" + std::to_string(count++);
+        std::ofstream seed(path, std::ios::binary);
+        seed.write((const char *)input.data(), input.size());
+        if (!seed) {
+            fprintf(stderr, "Cannot write %s\n", path.c_str());
+            return 1;
+        }
+    }
+    printf("Wrote %d inputs to %s\n", count, argv[2]);
+    return 0;
+}
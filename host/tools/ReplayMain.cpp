@@ -0,0 +1,154 @@
+/*
+ * ReplayMain.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+// Replay of a capture on the host
+// -------------------------------
+//   ignitron_replay CAPTURE [--real-time]
+// Loads a capture saved on the device (command 'w', see SparkCapture.h) with
+// SparkCaptureReplay. --real-time replays with the original timing on the virtual clock
+// of the host build, otherwise at full speed.
+// With the preset builder (REPLAY_DATA_CONTROL, needs ArduinoJson) the packets go to
+// SparkDataControl::processReplayedData like on the device: the firmware runs in APP mode
+// (HostApp) with the presets of data/ and no amp connected, at the end the state it has
+// taken from the capture is printed. Otherwise the received packets are decoded with
+// SparkStreamReader and each decoded message is printed as JSON.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "SparkCaptureReplay.h"
+#include "SparkFileSystem.h"
+#include "SparkStreamReader.h"
+
+#ifdef REPLAY_DATA_CONTROL
+#include "HostApp.h"
+#include "HostTestSupport.h"
+#include "SparkStatus.h"
+#endif
+
+namespace {
+
+#ifdef REPLAY_DATA_CONTROL
+
+const char *replayFileName = "/replay.bin";
+
+// The capture is copied next to the presets, the file system has a single root
+bool copyCapture(ScratchFileSystem &fileSystem, const char *path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    fileSystem.writeFile(replayFileName, content.str());
+    return true;
+}
+
+void printState() {
+    SparkStatus &status = SparkStatus::getInstance();
+    SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+    printf("Amp: %s, serial number %s, %d HW preset checksums\n", status.ampName().c_str(),
+           status.ampSerialNumber().c_str(), (int)status.hwChecksums().size());
+    printf("Active preset: bank %d, preset %d, %s\n", presetControl.activeBank(), presetControl.activePresetNum(),
+           presetControl.activePreset().name.c_str());
+    printf("Tuner updates: %d\n", status.tunerUpdateCount());
+}
+
+int replayWithDataControl(const char *path, bool isRealTime) {
+    Serial.setOutputEnabled(false);
+    ScratchFileSystem fileSystem;
+    if (!fileSystem.copyFrom(IGNITRON_DATA_DIR) || !copyCapture(fileSystem, path)) {
+        return 1;
+    }
+    HostApp &app = HostApp::getInstance();
+    app.begin(SimulatedAmpConfig());
+    // A replay only runs while no amp is connected, the firmware resets its status first
+    app.amp().end();
+    app.runFor(10);
+
+    SparkCaptureReplay &replay = SparkCaptureReplay::getInstance();
+    replay.setPacketHandler(SparkDataControl::processReplayedData, SparkDataControl::isTransportConnected);
+    Serial.setOutputEnabled(true);
+    if (!replay.load(replayFileName) || !replay.start(isRealTime ? REPLAY_REAL_TIME : REPLAY_FULL_SPEED)) {
+        return 1;
+    }
+    Serial.setOutputEnabled(false);
+    while (replay.isRunning()) {
+        replay.update();
+        app.step();
+    }
+    // Updates from the last packets
+    app.runFor(10);
+    Serial.setOutputEnabled(true);
+    printState();
+    return 0;
+}
+
+#else
+
+SparkStreamReader reader;
+ByteVector packet;
+unsigned long decodedMessages = 0;
+
+void decodePacket(const uint8_t *data, size_t length) {
+    byte note;
+    float offset;
+    if (SparkStreamReader::readTunerFrame(data, length, note, offset)) {
+        printf("Tuner: note %d, offset %.3f\n", note, offset);
+        return;
+    }
+    packet.assign(data, data + length);
+    MessageProcessStatus status = reader.processBlock(packet);
+    if (status != MSG_PROCESS_RES_COMPLETE && status != MSG_PROCESS_RES_REQUEST) {
+        return;
+    }
+    decodedMessages++;
+    for (const MessageData &message : reader.lastMessage()) {
+        printf("Message %02x %02x\n", message.cmd, message.subcmd);
+    }
+    if (reader.hasJson()) {
+        printf("%s\n", reader.getJson().c_str());
+    }
+}
+
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s CAPTURE [--real-time]\n", argv[0]);
+        return 2;
+    }
+    bool isRealTime = argc > 2 && strcmp(argv[2], "--real-time") == 0;
+#ifdef REPLAY_DATA_CONTROL
+    return replayWithDataControl(argv[1], isRealTime);
+#else
+
+    // The capture is read through the file system like on the device
+    std::string path = argv[1];
+    size_t separator = path.find_last_of('/');
+    SPARK_FS.setRoot(separator == std::string::npos ? "." : path.substr(0, separator));
+    std::string fileName = "/" + (separator == std::string::npos ? path : path.substr(separator + 1));
+
+    SparkCaptureReplay &replay = SparkCaptureReplay::getInstance();
+    replay.setPacketHandler(decodePacket);
+    if (!replay.load(fileName.c_str()) || !replay.start(isRealTime ? REPLAY_REAL_TIME : REPLAY_FULL_SPEED)) {
+        return 1;
+    }
+    while (replay.isRunning()) {
+        replay.update();
+        delay(1);
+    }
+    printf("%lu messages decoded\n", decodedMessages);
+    return 0;
+#endif
+}
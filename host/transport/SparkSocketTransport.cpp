@@ -0,0 +1,143 @@
+/*
+ * SparkSocketTransport.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkSocketTransport.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Larger than any block, so a packet is never truncated
+static const size_t receiveBufferSize = 512;
+
+static bool socketAddress(const string &path, sockaddr_un &address) {
+    memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof address.sun_path) {
+        return false;
+    }
+    strncpy(address.sun_path, path.c_str(), sizeof address.sun_path - 1);
+    return true;
+}
+
+SparkSocketTransport::~SparkSocketTransport() {
+    close();
+}
+
+bool SparkSocketTransport::listen(const string &path) {
+    sockaddr_un address;
+    if (thread_.joinable() || !socketAddress(path, address)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) {
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(fd, (sockaddr *)&address, sizeof address) != 0 || ::listen(fd, 1) != 0) {
+        ::close(fd);
+        return false;
+    }
+    path_ = path;
+    listenFd_ = fd;
+    thread_ = thread(&SparkSocketTransport::acceptLoop, this);
+    return true;
+}
+
+bool SparkSocketTransport::connect(const string &path) {
+    sockaddr_un address;
+    if (thread_.joinable() || !socketAddress(path, address)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (::connect(fd, (sockaddr *)&address, sizeof address) != 0) {
+        ::close(fd);
+        return false;
+    }
+    connectionFd_ = fd;
+    connectionChanged(true);
+    thread_ = thread(&SparkSocketTransport::receiveLoop, this, fd);
+    return true;
+}
+
+void SparkSocketTransport::close() {
+    isClosing_ = true;
+    {
+        // Wakes up the receive thread, it closes the connection
+        lock_guard<mutex> lock(connectionMutex_);
+        if (connectionFd_ >= 0) {
+            shutdown(connectionFd_, SHUT_RDWR);
+        }
+    }
+    if (listenFd_ >= 0) {
+        shutdown(listenFd_, SHUT_RDWR);
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        unlink(path_.c_str());
+    }
+    isClosing_ = false;
+}
+
+bool SparkSocketTransport::send(const BlockData &block) {
+    lock_guard<mutex> lock(connectionMutex_);
+    if (connectionFd_ < 0) {
+        return false;
+    }
+    ssize_t sent = ::send(connectionFd_, block.data(), block.size(), MSG_NOSIGNAL);
+    return sent == (ssize_t)block.size();
+}
+
+void SparkSocketTransport::acceptLoop() {
+    while (!isClosing_) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+        {
+            lock_guard<mutex> lock(connectionMutex_);
+            connectionFd_ = fd;
+        }
+        // close() might have missed the new connection
+        if (isClosing_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        connectionChanged(true);
+        receiveLoop(fd);
+    }
+}
+
+void SparkSocketTransport::receiveLoop(int fd) {
+    uint8_t buffer[receiveBufferSize];
+    while (true) {
+        ssize_t length = recv(fd, buffer, sizeof buffer, 0);
+        if (length > 0) {
+            dataReceived(buffer, length);
+        } else if (length == 0 || errno != EINTR) {
+            break;
+        }
+    }
+    disconnect();
+}
+
+void SparkSocketTransport::disconnect() {
+    {
+        lock_guard<mutex> lock(connectionMutex_);
+        ::close(connectionFd_);
+        connectionFd_ = -1;
+    }
+    connectionChanged(false);
+}
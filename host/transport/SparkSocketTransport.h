@@ -0,0 +1,61 @@
+/*
+ * SparkSocketTransport.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_SOCKET_TRANSPORT_H
+#define SPARK_SOCKET_TRANSPORT_H
+
+#include "SparkTransport.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+class SparkSocketTransport : public SparkTransport {
+    // Transport over a Unix domain socket (host build)
+    // ------------------------------------------------
+    // Connects two processes (or two threads) like the BLE connection between app and
+    // amp. One side listens (the amp, like the BLE server), the other one connects.
+    // The socket is SOCK_SEQPACKET, so each block sent arrives as one packet like a
+    // BLE write or notification. A receive thread reads the packets into a fixed
+    // buffer and passes them to the receive callback, connection changes are reported
+    // from the same thread. A listening transport accepts a new client after the
+    // previous one disconnected.
+
+public:
+    SparkSocketTransport() {}
+    ~SparkSocketTransport();
+
+    SparkSocketTransport(const SparkSocketTransport &) = delete;
+    SparkSocketTransport &operator=(const SparkSocketTransport &) = delete;
+
+    // Creates the socket file at path and waits for clients in the background
+    bool listen(const string &path);
+    // Connects to a listening transport
+    bool connect(const string &path);
+    // Disconnects, stops the receive thread and removes the socket file of a listener
+    void close();
+
+    bool isConnected() const override { return connectionFd_.load() >= 0; }
+    bool send(const BlockData &block) override;
+
+private:
+    void acceptLoop();
+    void receiveLoop(int fd);
+    void disconnect();
+
+    string path_;
+    int listenFd_ = -1;
+    atomic<int> connectionFd_{-1};
+    atomic<bool> isClosing_{false};
+    // Guards connectionFd_ against being closed while it is used
+    mutex connectionMutex_;
+    thread thread_;
+};
+
+#endif
@@ -8,15 +8,46 @@
 #ifndef CONFIG_DEFINITIONS_H_
 #define CONFIG_DEFINITIONS_H_
 
+#include "SparkLog.h"
 #include <Arduino.h>
 #include <string>
 using namespace std;
 
 // #define DEBUG
+
+// Log levels, messages above LOG_LEVEL are not compiled in.
+// Log output is buffered and sent by a background task (see SparkLog.h).
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_DEBUG 3
+
+#ifndef LOG_LEVEL
+#ifdef DEBUG
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+#define LOG_ENABLED(level) (LOG_LEVEL >= (level))
+#define SPARK_LOG SparkLog::getInstance()
+
+#if LOG_ENABLED(LOG_LEVEL_ERROR)
+#define LOG_ERROR(...) SPARK_LOG.printf(__VA_ARGS__)
+#else
+#define LOG_ERROR(...)
+#endif
+#if LOG_ENABLED(LOG_LEVEL_INFO)
+#define LOG_INFO(...) SPARK_LOG.printf(__VA_ARGS__)
+#else
+#define LOG_INFO(...)
+#endif
+
 #ifdef DEBUG
-#define DEBUG_PRINT(...) Serial.print(__VA_ARGS__)
-#define DEBUG_PRINTLN(x) Serial.println(x)
-#define DEBUG_PRINTF(...) Serial.printf(__VA_ARGS__)
+#define DEBUG_PRINT(...) SPARK_LOG.print(__VA_ARGS__)
+#define DEBUG_PRINTLN(x) SPARK_LOG.println(x)
+#define DEBUG_PRINTF(...) SPARK_LOG.printf(__VA_ARGS__)
 #define DEBUG_PRINTVECTOR(x) SparkHelper::printByteVector(x)
 #else
 #define DEBUG_PRINT(...)
@@ -25,6 +56,45 @@ using namespace std;
 #define DEBUG_PRINTVECTOR(x)
 #endif
 
+// Counts heap allocations of the main loop after the connection is established
+// and reports them per subsystem over serial (see SparkHeapAudit.h)
+// #define AUDIT_HEAP_ALLOCATIONS
+
+// Measures the stages of the main loop and reports min/avg/p99/max over serial
+// (see SparkLoopProfiler.h)
+// #define PROFILE_LOOP
+
+// Traces button presses up to the acknowledgment of the amp and reports the
+// latency per action over serial (see SparkLatencyTrace.h)
+// #define TRACE_LATENCY
+
+// Replaces the Spark amp by a simulated amp in APP mode for testing without hardware.
+// The amp type can be selected with SIMULATED_AMP_NAME (see SparkAmpSimulator.h)
+// #define SIMULATE_AMP
+
+// Adds the protocol and storage benchmarks, started with command 'b' on Serial.
+// Results are printed as JSON (see SparkBenchmark.h)
+// #define BENCHMARK
+
+// The benchmark firmware (PlatformIO environment "benchmark") defines BENCHMARK_FIRMWARE:
+// it runs all benchmarks on boot and does not connect to amp or app
+#if defined(BENCHMARK_FIRMWARE) && !defined(BENCHMARK)
+#define BENCHMARK
+#endif
+
+// Drives the firmware with preset switches, effect toggles, looper commands and tuner
+// against the simulated amp and fails if heap, container sizes or latency drift over
+// time (see SparkSoakTest.h). Needs SIMULATE_AMP and TRACE_LATENCY, both are enabled.
+// #define SOAK_TEST
+#ifdef SOAK_TEST
+#ifndef SIMULATE_AMP
+#define SIMULATE_AMP
+#endif
+#ifndef TRACE_LATENCY
+#define TRACE_LATENCY
+#endif
+#endif
+
 // Software version
 const string VERSION = "1.9.1";
 
@@ -0,0 +1,67 @@
+/*
+ * DurationHistogram.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "DurationHistogram.h"
+
+int DurationHistogram::bucketIndex(uint32_t duration) {
+    if (duration < subBuckets) {
+        return duration;
+    }
+    int msb = 31 - __builtin_clz(duration);
+    int octave = msb - 1;
+    int sub = (duration >> (msb - 2)) & (subBuckets - 1);
+    int index = octave * subBuckets + sub;
+    return index < numberOfBuckets ? index : numberOfBuckets - 1;
+}
+
+uint32_t DurationHistogram::bucketUpperBound(int index) {
+    if (index < subBuckets) {
+        return index;
+    }
+    int msb = index / subBuckets + 1;
+    int sub = index % subBuckets;
+    uint32_t lower = (uint32_t)(subBuckets + sub) << (msb - 2);
+    return lower + (1UL << (msb - 2)) - 1;
+}
+
+void DurationHistogram::add(uint32_t duration) {
+    buckets_[bucketIndex(duration)]++;
+    count_++;
+    total_ += duration;
+    if (duration < min_) {
+        min_ = duration;
+    }
+    if (duration > max_) {
+        max_ = duration;
+    }
+}
+
+void DurationHistogram::reset() {
+    for (int i = 0; i < numberOfBuckets; i++) {
+        buckets_[i] = 0;
+    }
+    count_ = 0;
+    total_ = 0;
+    min_ = UINT32_MAX;
+    max_ = 0;
+}
+
+uint32_t DurationHistogram::percentile(int percent) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    uint32_t target = ((uint64_t)count_ * percent + 99) / 100;
+    uint32_t cumulated = 0;
+    for (int i = 0; i < numberOfBuckets; i++) {
+        cumulated += buckets_[i];
+        if (cumulated >= target) {
+            uint32_t upperBound = bucketUpperBound(i);
+            return upperBound < max_ ? upperBound : max_;
+        }
+    }
+    return max_;
+}
@@ -0,0 +1,43 @@
+/*
+ * DurationHistogram.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef DURATION_HISTOGRAM_H
+#define DURATION_HISTOGRAM_H
+
+#include <stdint.h>
+
+// Histogram of durations (any unit) with 4 buckets per power of two, percentiles are reported
+// as upper bound of their bucket (max. 25% above the exact value)
+class DurationHistogram {
+
+public:
+    void add(uint32_t duration);
+    void reset();
+
+    uint32_t count() const { return count_; }
+    uint32_t min() const { return count_ ? min_ : 0; }
+    uint32_t max() const { return max_; }
+    uint32_t average() const { return count_ ? total_ / count_ : 0; }
+    // Upper bound of the bucket containing the given percentile
+    uint32_t percentile(int percent) const;
+
+    static const int subBuckets = 4;
+    static const int octaves = 24;
+    static const int numberOfBuckets = octaves * subBuckets;
+
+private:
+    static int bucketIndex(uint32_t duration);
+    static uint32_t bucketUpperBound(int index);
+
+    uint32_t buckets_[numberOfBuckets] = {};
+    uint32_t count_ = 0;
+    uint64_t total_ = 0;
+    uint32_t min_ = UINT32_MAX;
+    uint32_t max_ = 0;
+};
+
+#endif
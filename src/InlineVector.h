@@ -0,0 +1,71 @@
+/*
+ * InlineVector.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef INLINEVECTOR_H_
+#define INLINEVECTOR_H_
+
+#include <stdint.h>
+
+// Vector-like container with a fixed capacity. Elements are stored inline,
+// so no heap allocation is needed and copies stay cheap.
+template <typename T, int N>
+class InlineVector {
+
+public:
+    static const int capacity = N;
+
+    int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == N; }
+
+    void clear() {
+        for (int i = 0; i < size_; i++) {
+            items_[i] = T();
+        }
+        size_ = 0;
+    }
+
+    // Returns false if the capacity is exceeded, the element is not added then
+    bool push_back(const T &item) {
+        if (size_ >= N) {
+            return false;
+        }
+        items_[size_++] = item;
+        return true;
+    }
+
+    // Appends the range up to the capacity, returns false if not all elements fit
+    template <typename It>
+    bool append(It first, It last) {
+        for (; first != last; ++first) {
+            if (!push_back(*first)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Access is possible up to the capacity, unused elements are default initialized
+    T &operator[](int index) { return items_[index]; }
+    const T &operator[](int index) const { return items_[index]; }
+    T &back() { return items_[size_ - 1]; }
+    const T &back() const { return items_[size_ - 1]; }
+
+    T *data() { return items_; }
+    const T *data() const { return items_; }
+
+    T *begin() { return items_; }
+    T *end() { return items_ + size_; }
+    const T *begin() const { return items_; }
+    const T *end() const { return items_ + size_; }
+
+private:
+    T items_[N] = {};
+    uint8_t size_ = 0;
+};
+
+#endif /* INLINEVECTOR_H_ */
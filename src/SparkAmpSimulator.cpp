@@ -0,0 +1,335 @@
+/*
+ * SparkAmpSimulator.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkAmpSimulator.h"
+
+#ifdef SIMULATE_AMP
+
+// Maximum size of the 8 bit payload of a single chunk
+static const int maxChunkPayload = 0x90;
+
+SparkAmpSimulator &SparkAmpSimulator::getInstance() {
+    static SparkAmpSimulator INSTANCE;
+    return INSTANCE;
+}
+
+// Amp types: name, HW presets, MTU, looper, tuner, checksum request
+static const SimulatedAmpModel ampModels[] = {
+    {AMP_NAME_SPARK_40, 4, 0xAD, false, true, 0x2A},
+    {AMP_NAME_SPARK_MINI, 4, 0x64, false, true, 0x2A},
+    {AMP_NAME_SPARK_GO, 4, 0xAD, false, true, 0x2A},
+    {AMP_NAME_SPARK_NEO, 4, 0xAD, false, true, 0x2A},
+    {AMP_NAME_SPARK_2, 8, 0x64, true, true, 0x2B},
+};
+
+const SimulatedAmpModel &SparkAmpSimulator::model() const {
+    for (const SimulatedAmpModel &model : ampModels) {
+        if (model.ampName == config_.ampName) {
+            return model;
+        }
+    }
+    return ampModels[0];
+}
+
+void SparkAmpSimulator::begin() {
+    if (config_.mtu <= 0) {
+        config_.mtu = model().mtu;
+    }
+    isConnected_ = true;
+    connectionChanged(true);
+    Serial.printf("Simulated amp '%s' connected (latency %lu ms, loss %d%%, MTU %d).\n",
+                  config_.ampName.c_str(), config_.latency, config_.lossPercent, config_.mtu);
+}
+
+void SparkAmpSimulator::end() {
+    isConnected_ = false;
+    isTunerOn_ = false;
+    notificationCount_ = 0;
+    connectionChanged(false);
+    Serial.printf("Simulated amp '%s' disconnected.\n", config_.ampName.c_str());
+}
+
+void SparkAmpSimulator::configure(const SimulatedAmpConfig &config) {
+    config_ = config;
+    if (config_.mtu <= 0) {
+        config_.mtu = model().mtu;
+    }
+    notificationHead_ = 0;
+    notificationCount_ = 0;
+}
+
+int SparkAmpSimulator::numberOfHWPresets() const {
+    return model().numberOfHWPresets;
+}
+
+Preset SparkAmpSimulator::hwPreset(int presetNumber) const {
+    if (presetSource_ == nullptr) {
+        return Preset();
+    }
+    return presetSource_(presetNumber);
+}
+
+// Decodes the 7 bit data of a F0 01 ... F7 chunk, returns the number of 8 bit bytes
+static int decodeChunk(const byte *chunk, size_t length, byte *payload, int maxSize) {
+    int size = 0;
+    // Data starts after F0 01 <seq> <chk> <cmd> <sub> and ends before F7
+    size_t pos = 6;
+    while (pos < length - 1) {
+        byte bit8 = chunk[pos++];
+        for (int i = 0; i < 7 && pos < length - 1 && size < maxSize; i++) {
+            byte value = chunk[pos++];
+            if (bit8 & (1 << i)) {
+                value |= 0x80;
+            }
+            payload[size++] = value;
+        }
+    }
+    return size;
+}
+
+bool SparkAmpSimulator::send(const BlockData &block) {
+    if (!isConnected_) {
+        return false;
+    }
+    blocksReceived_++;
+    bytesReceived_ += block.size();
+    requestTimestamp_ = micros();
+
+    const byte *data = block.data();
+    size_t length = block.size();
+    // Skip 01FE header
+    if (length > 16 && data[0] == 0x01 && data[1] == 0xFE) {
+        data += 16;
+        length -= 16;
+    }
+
+    byte payload[maxChunkPayload];
+    bool isMessageComplete = true;
+    byte msgNum = 0;
+    size_t pos = 0;
+    while (pos + 7 <= length) {
+        if (data[pos] != 0xF0 || data[pos + 1] != 0x01) {
+            pos++;
+            continue;
+        }
+        size_t end = pos + 6;
+        while (end < length && data[end] != 0xF7) {
+            end++;
+        }
+        if (end == length) {
+            Serial.println("Simulated amp: incomplete chunk, ignoring rest of block");
+            break;
+        }
+        const byte *chunk = data + pos;
+        size_t chunkLength = end - pos + 1;
+        msgNum = chunk[2];
+        byte cmd = chunk[4];
+        byte subCmd = chunk[5];
+        int payloadSize = decodeChunk(chunk, chunkLength, payload, maxChunkPayload);
+
+        if (cmd == 0x02) {
+            handleRequest(msgNum, subCmd, payload, payloadSize);
+        } else if (cmd == 0x01) {
+            // Presets are sent in multiple chunks with numChunks, thisChunk, chunkSize prefix
+            isMessageComplete = true;
+            if (subCmd == 0x01 && payloadSize >= 3) {
+                isMessageComplete = payload[1] + 1 >= payload[0];
+            }
+            if (isMessageComplete) {
+                handleChange(msgNum, subCmd, payload, payloadSize);
+            }
+        }
+        pos = end + 1;
+    }
+    if (!isMessageComplete) {
+        sendResponse(sparkMsg_.sendIntermediateAck(msgNum, 0x01));
+    }
+    return true;
+}
+
+void SparkAmpSimulator::handleRequest(byte msgNum, byte subCmd, const byte *payload, int payloadSize) {
+    ByteVector checksums;
+    Preset preset;
+    const SimulatedAmpModel &ampModel = model();
+
+    bool isChecksumRequest = subCmd == 0x2A || subCmd == 0x2B;
+    if ((isChecksumRequest && subCmd != ampModel.checksumRequest) || (subCmd == 0x76 && !ampModel.hasLooper)) {
+        unsupportedMessages_++;
+        Serial.printf("Simulated amp: request 02 %02X not supported by %s\n", subCmd, ampModel.ampName.c_str());
+        return;
+    }
+
+    switch (subCmd) {
+    case 0x23:
+        sendResponse(sparkMsg_.sendSerialNumber(msgNum));
+        break;
+    case 0x2F:
+        sendResponse(sparkMsg_.sendFirmwareVersion(msgNum));
+        break;
+    case 0x11:
+        sendResponse(sparkMsg_.sendAmpName(msgNum, config_.ampName));
+        break;
+    case 0x2A:
+    case 0x2B:
+        for (int i = 1; i <= numberOfHWPresets(); i++) {
+            checksums.push_back(sparkMsg_.getPresetChecksum(hwPreset(i)));
+        }
+        if (subCmd == 0x2B) {
+            sendResponse(sparkMsg_.sendHWChecksumsExtended(msgNum, checksums));
+        } else {
+            sendResponse(sparkMsg_.sendHWChecksums(msgNum, checksums));
+        }
+        break;
+    case 0x10:
+        sendResponse(sparkMsg_.sendHWPresetNumber(msgNum, currentPresetNumber_));
+        break;
+    case 0x01:
+        // 01 00 is the current preset, 00 <num> a HW preset
+        if (payloadSize >= 2 && payload[0] == 0x00 && payload[1] < numberOfHWPresets()) {
+            preset = hwPreset(payload[1] + 1);
+            preset.presetNumber = payload[1];
+        } else {
+            // A custom preset sent to the amp is not decoded, so the active HW preset is returned
+            int presetNumber = currentPresetNumber_ <= numberOfHWPresets() ? currentPresetNumber_ : 1;
+            preset = hwPreset(presetNumber);
+            preset.presetNumber = 127;
+        }
+        sendResponse(sparkMsg_.changePreset(preset, DIR_FROM_SPARK, msgNum));
+        break;
+    case 0x71:
+        sendResponse(sparkMsg_.sendAmpStatus(msgNum));
+        break;
+    case 0x72:
+        sendResponse(sparkMsg_.sendResponse72(msgNum));
+        break;
+    case 0x76:
+        sendResponse(sparkMsg_.sendLooperSettings(msgNum, looperSetting_));
+        break;
+    default:
+        Serial.printf("Simulated amp: request 02 %02X not handled\n", subCmd);
+        break;
+    }
+}
+
+void SparkAmpSimulator::handleChange(byte msgNum, byte subCmd, const byte *payload, int payloadSize) {
+    const SimulatedAmpModel &ampModel = model();
+    bool isLooperChange = subCmd == 0x75 || subCmd == 0x76;
+    if ((isLooperChange && !ampModel.hasLooper) || (subCmd == 0x65 && !ampModel.hasTuner)) {
+        unsupportedMessages_++;
+        Serial.printf("Simulated amp: change 01 %02X not supported by %s\n", subCmd, ampModel.ampName.c_str());
+        return;
+    }
+
+    switch (subCmd) {
+    case 0x38:
+        if (payloadSize >= 2) {
+            currentPresetNumber_ = payload[1] + 1;
+        }
+        break;
+    case 0x65:
+        if (payloadSize >= 1) {
+            isTunerOn_ = payload[0] == 0xC3;
+        }
+        break;
+    case 0x76: {
+        // [CC] bpm, count, bars, free, click, unknown, CD <duration>
+        int pos = 0;
+        if (payloadSize > 0 && payload[pos] == 0xCC) {
+            pos++;
+        }
+        if (payloadSize - pos >= 9) {
+            looperSetting_.bpm = payload[pos];
+            looperSetting_.count = payload[pos + 1];
+            looperSetting_.bars = payload[pos + 2];
+            looperSetting_.freeIndicator = payload[pos + 3] == 0xC3;
+            looperSetting_.click = payload[pos + 4] == 0xC3;
+            looperSetting_.unknownOnOff = payload[pos + 5] == 0xC3;
+            looperSetting_.maxDuration = payload[pos + 7] << 8 | payload[pos + 8];
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    // Effect parameter changes are not acknowledged by the amp
+    if (subCmd != 0x04) {
+        sendResponse(sparkMsg_.sendAck(msgNum, subCmd, DIR_FROM_SPARK));
+    }
+}
+
+void SparkAmpSimulator::sendResponse(const vector<CmdData> &message, bool isResponse) {
+    unsigned long due = millis() + config_.latency;
+    for (const CmdData &block : message) {
+        const byte *data = block.data.data();
+        int size = block.data.size();
+        bool isLastBlock = &block == &message.back();
+        for (int pos = 0; pos < size; pos += config_.mtu) {
+            if (config_.lossPercent > 0 && random(100) < config_.lossPercent) {
+                notificationsDropped_++;
+                continue;
+            }
+            int packetSize = min(config_.mtu, size - pos);
+            bool isLast = isResponse && isLastBlock && pos + packetSize == size;
+            queueNotification(due, data + pos, packetSize, isLast);
+        }
+    }
+}
+
+void SparkAmpSimulator::queueNotification(unsigned long due, const byte *data, int size, bool isLastOfResponse) {
+    if (notificationCount_ == notifications_.size()) {
+        // Ring is full, it is unrolled and grows at the end
+        rotate(notifications_.begin(), notifications_.begin() + notificationHead_, notifications_.end());
+        notificationHead_ = 0;
+        notifications_.emplace_back();
+    }
+    Notification &notification = notifications_[(notificationHead_ + notificationCount_) % notifications_.size()];
+    notification.due = due;
+    notification.data.assign(data, data + size);
+    notification.isLastOfResponse = isLastOfResponse;
+    notification.requestTimestamp = requestTimestamp_;
+    notificationCount_++;
+}
+
+void SparkAmpSimulator::update() {
+    if (!isConnected_) {
+        return;
+    }
+    unsigned long now = millis();
+
+    if (isTunerOn_ && now - lastTunerOutput_ >= config_.tunerInterval) {
+        lastTunerOutput_ = now;
+        // Cycle through all notes, sweeping each from flat to sharp
+        byte note = (tunerStep_ / 10) % 12;
+        float offset = (tunerStep_ % 10) / 9.0;
+        tunerStep_++;
+        sendResponse(sparkMsg_.sendTunerOutput(0, note, offset), false);
+    }
+
+    while (notificationCount_ > 0 && (long)(now - notifications_[notificationHead_].due) >= 0) {
+        Notification &notification = notifications_[notificationHead_];
+        notificationsSent_++;
+        bytesSent_ += notification.data.size();
+        if (notification.isLastOfResponse) {
+            roundTrip_.add(micros() - notification.requestTimestamp);
+        }
+        dataReceived(notification.data.data(), notification.data.size());
+        notificationHead_ = (notificationHead_ + 1) % notifications_.size();
+        notificationCount_--;
+    }
+}
+
+void SparkAmpSimulator::report() {
+    Serial.printf("Simulated amp '%s': received %lu blocks (%lu bytes), sent %lu notifications (%lu bytes), dropped %lu, pending %d\n",
+                  config_.ampName.c_str(), blocksReceived_, bytesReceived_, notificationsSent_, bytesSent_,
+                  notificationsDropped_, (int)notificationCount_);
+    Serial.printf("Simulated amp '%s': %lu responses, round trip p50 %lu us, p90 %lu us, p99 %lu us, max %lu us, %lu unsupported\n",
+                  config_.ampName.c_str(), (unsigned long)roundTrip_.count(), (unsigned long)roundTrip_.percentile(50),
+                  (unsigned long)roundTrip_.percentile(90), (unsigned long)roundTrip_.percentile(99),
+                  (unsigned long)roundTrip_.max(), unsupportedMessages_);
+}
+
+#endif
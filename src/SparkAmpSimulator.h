@@ -0,0 +1,147 @@
+/*
+ * SparkAmpSimulator.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_AMP_SIMULATOR_H
+#define SPARK_AMP_SIMULATOR_H
+
+#include "Config_Definitions.h"
+#include "DurationHistogram.h"
+#include "SparkMessage.h"
+#include "SparkTransport.h"
+#include "SparkTypes.h"
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Amp type simulated when SIMULATE_AMP is defined
+#ifndef SIMULATED_AMP_NAME
+#define SIMULATED_AMP_NAME AMP_NAME_SPARK_40
+#endif
+
+// Properties of an amp type, see SparkAmpSimulator::model()
+struct SimulatedAmpModel {
+    string ampName;
+    int numberOfHWPresets;
+    // Default maximum size of a notification
+    int mtu;
+    // Built-in looper (02 75 commands, 02/01 76 looper settings)
+    bool hasLooper;
+    bool hasTuner;
+    // Request for the HW preset checksums the amp answers: 2B (extended) or 2A
+    byte checksumRequest;
+};
+
+struct SimulatedAmpConfig {
+    string ampName = SIMULATED_AMP_NAME;
+    // Delay of each notification in ms
+    unsigned long latency = 20;
+    // Percentage of notifications which are dropped
+    int lossPercent = 0;
+    // Maximum size of a notification, larger blocks are split (0: default of the amp type)
+    int mtu = 0;
+    // Interval of tuner output in ms while the tuner is on
+    unsigned long tunerInterval = 100;
+};
+
+class SparkAmpSimulator : public SparkTransport {
+    // Simulated Spark amp
+    // -------------------
+    // When SIMULATE_AMP is defined, SparkDataControl uses this class as transport instead
+    // of the BLE connection in APP mode (in-process loopback). The simulator answers requests (serial number, firmware,
+    // amp name, checksums, presets, preset number, amp status, looper settings) and acknowledges
+    // changes with intermediate (05 01) and final (04 xx) acks like the amp does. While the
+    // tuner is on, tuner output is streamed. Responses are delivered through the receive
+    // callback after the configured latency, split by MTU and randomly dropped by the loss rate.
+    // HW presets of the simulated amp are taken from the preset source, the firmware uses the
+    // presets of the first custom bank(s) as in AMP mode. Amp types differ in number of HW
+    // presets, notification size, looper and tuner and the checksum request (see model()),
+    // requests and changes an amp type does not support are not answered.
+    // The round trip from a request block to the last notification of its response is
+    // collected in roundTrip().
+
+public:
+    // Returns HW preset presetNumber (1 based) of the simulated amp
+    typedef Preset (*PresetSource)(int presetNumber);
+
+    static SparkAmpSimulator &getInstance();
+
+    SparkAmpSimulator(const SparkAmpSimulator &) = delete;
+    SparkAmpSimulator &operator=(const SparkAmpSimulator &) = delete;
+
+    // Connects the simulated amp
+    void begin();
+    // Disconnects it, begin() connects it again
+    void end();
+    void configure(const SimulatedAmpConfig &config);
+    const SimulatedAmpConfig &config() const { return config_; }
+    // Properties of the configured amp type, Spark 40 for unknown names
+    const SimulatedAmpModel &model() const;
+    void setPresetSource(PresetSource source) { presetSource_ = source; }
+
+    bool isConnected() const override { return isConnected_; }
+    // Block written to the amp
+    bool send(const BlockData &block) override;
+    // Delivers due notifications and tuner output, to be called in the main loop
+    void update();
+    void report();
+    // Notifications waiting for delivery
+    size_t pendingNotifications() const { return notificationCount_; }
+    // Round trip in us of each request or change which has been answered
+    const DurationHistogram &roundTrip() const { return roundTrip_; }
+    unsigned long bytesReceived() const { return bytesReceived_; }
+    unsigned long bytesSent() const { return bytesSent_; }
+    // Requests and changes not supported by the amp type
+    unsigned long unsupportedMessages() const { return unsupportedMessages_; }
+
+private:
+    SparkAmpSimulator() {}
+
+    struct Notification {
+        unsigned long due;
+        ByteVector data;
+        // Last notification of a response, requestTimestamp is the time the request arrived
+        bool isLastOfResponse;
+        unsigned long requestTimestamp;
+    };
+
+    void handleRequest(byte msgNum, byte subCmd, const byte *payload, int payloadSize);
+    void handleChange(byte msgNum, byte subCmd, const byte *payload, int payloadSize);
+    // isResponse is false for messages the amp sends on its own (tuner output)
+    void sendResponse(const vector<CmdData> &message, bool isResponse = true);
+    void queueNotification(unsigned long due, const byte *data, int size, bool isLastOfResponse);
+    int numberOfHWPresets() const;
+    Preset hwPreset(int presetNumber) const;
+
+    SimulatedAmpConfig config_;
+    SparkMessage sparkMsg_;
+    PresetSource presetSource_ = nullptr;
+    bool isConnected_ = false;
+    // Ring of notifications, the buffers are reused once the ring has grown to its size
+    vector<Notification> notifications_;
+    size_t notificationHead_ = 0;
+    size_t notificationCount_ = 0;
+
+    int currentPresetNumber_ = 1;
+    LooperSetting looperSetting_;
+    bool isTunerOn_ = false;
+    unsigned long lastTunerOutput_ = 0;
+    int tunerStep_ = 0;
+
+    unsigned long blocksReceived_ = 0;
+    unsigned long bytesReceived_ = 0;
+    unsigned long notificationsSent_ = 0;
+    unsigned long bytesSent_ = 0;
+    unsigned long notificationsDropped_ = 0;
+    unsigned long unsupportedMessages_ = 0;
+    // Arrival of the request block being handled
+    unsigned long requestTimestamp_ = 0;
+    DurationHistogram roundTrip_;
+};
+
+#endif
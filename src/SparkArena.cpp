@@ -0,0 +1,39 @@
+/*
+ * SparkArena.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkArena.h"
+#include <stdlib.h>
+
+SparkArena &SparkArena::getInstance() {
+    static SparkArena INSTANCE;
+    return INSTANCE;
+}
+
+void *SparkArena::allocate(size_t size, size_t alignment) {
+    size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+    if (start + size > arenaSize) {
+        fallbackCount_++;
+        return malloc(size);
+    }
+    used_ = start + size;
+    if (used_ > highWaterMark_) {
+        highWaterMark_ = used_;
+    }
+    return buffer_ + start;
+}
+
+void SparkArena::deallocate(void *ptr) {
+    uint8_t *bytePtr = static_cast<uint8_t *>(ptr);
+    if (bytePtr >= buffer_ && bytePtr < buffer_ + arenaSize) {
+        return;
+    }
+    free(ptr);
+}
+
+void SparkArena::reset() {
+    used_ = 0;
+}
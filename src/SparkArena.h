@@ -0,0 +1,78 @@
+/*
+ * SparkArena.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_ARENA_H
+#define SPARK_ARENA_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <vector>
+
+using namespace std;
+
+class SparkArena {
+    // Scratch memory for parsing messages
+    // -----------------------------------
+    // Memory is taken from a static buffer by increasing an offset (bump allocation),
+    // single allocations are never freed. The whole arena is reset after a message has
+    // been processed, so parsing does not fragment the heap.
+    // If the arena is full, memory is taken from the heap instead and counted as fallback.
+
+public:
+    static SparkArena &getInstance();
+
+    SparkArena(const SparkArena &) = delete;
+    SparkArena &operator=(const SparkArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment);
+    // Only memory taken from the heap is freed, arena memory is released with reset()
+    void deallocate(void *ptr);
+    // Must only be called when no object using arena memory is alive anymore
+    void reset();
+
+    size_t used() const { return used_; }
+    size_t highWaterMark() const { return highWaterMark_; }
+    unsigned long fallbackCount() const { return fallbackCount_; }
+    static const size_t arenaSize = 8192;
+
+private:
+    SparkArena() {}
+
+    alignas(8) uint8_t buffer_[arenaSize];
+    size_t used_ = 0;
+    size_t highWaterMark_ = 0;
+    unsigned long fallbackCount_ = 0;
+};
+
+// STL allocator taking memory from the arena
+template <typename T>
+class ArenaAllocator {
+
+public:
+    typedef T value_type;
+
+    ArenaAllocator() {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(SparkArena::getInstance().allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *ptr, size_t) {
+        SparkArena::getInstance().deallocate(ptr);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &) { return true; }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &) { return false; }
+
+// Byte vector for temporary data while parsing a message
+typedef vector<byte, ArenaAllocator<byte>> ScratchByteVector;
+
+#endif
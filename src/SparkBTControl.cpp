@@ -14,13 +14,6 @@ bool SparkBTControl::isAppConnectedSerial_ = false;
 SparkBTControl::SparkBTControl() {
     // advDevCB = new AdvertisedDeviceCallbacks();
     advDevice_ = nullptr;
-    spark_dc_ = nullptr;
-}
-
-SparkBTControl::SparkBTControl(SparkDataControl *dc) {
-    // advDevCB = new AdvertisedDeviceCallbacks();
-    advDevice_ = nullptr;
-    spark_dc_ = dc;
 }
 
 SparkBTControl::~SparkBTControl() {
@@ -36,10 +29,9 @@ SparkBTControl::~SparkBTControl() {
 }
 
 // Initializing BLE connection with NimBLE
-void SparkBTControl::initBLE(notify_callback notifyCallback) {
+void SparkBTControl::initBLE() {
     // NimBLEDevice::init("");
     advDevice_ = new NimBLEAdvertisedDevice();
-    notifyCB_ = notifyCallback;
 
     /** Optional: set the transmit power, default is 3db */
     NimBLEDevice::setPower(ESP_PWR_LVL_P9); /** +9db */
@@ -74,7 +66,6 @@ void SparkBTControl::scanEndedCB(NimBLEScanResults results) {
 }
 
 void SparkBTControl::startScan() {
-    spark_dc_->resetStatus();
     NimBLEDevice::getScan()->start(kScanTime, scanEndedCB);
     Serial.println("Scan initiated");
 }
@@ -148,7 +139,7 @@ bool SparkBTControl::connectToServer() {
     return true;
 }
 
-bool SparkBTControl::subscribeToNotifications(notify_callback notifyCallback) {
+bool SparkBTControl::subscribeToNotifications() {
 
     // Subscribe to notifications from Spark
     NimBLERemoteService *service = nullptr;
@@ -168,7 +159,11 @@ bool SparkBTControl::subscribeToNotifications(notify_callback notifyCallback) {
                     // Descriptor 2902 needs to be activated in order to receive notifications
                     characteristic->getDescriptor(BLEUUID((uint16_t)0x2902))->writeValue(kNotificationOn, 2, true);
                     // Subscribing to Spark characteristic
-                    if (!characteristic->subscribe(true, notifyCB_)) {
+                    notify_callback notifyCallback = [this](NimBLERemoteCharacteristic *characteristic,
+                                                            uint8_t *data, size_t length, bool isNotify) {
+                        dataReceived(data, length);
+                    };
+                    if (!characteristic->subscribe(true, notifyCallback)) {
                         Serial.println("Subscribe failed, disconnecting");
                         // Disconnect if subscribe failed
                         client_->disconnect();
@@ -198,7 +193,7 @@ bool SparkBTControl::subscribeToNotifications(notify_callback notifyCallback) {
 }
 
 // To send messages to Spark via Bluetooth LE
-bool SparkBTControl::writeBLE(ByteVector &cmd, bool withDelay, bool response) {
+bool SparkBTControl::writeBLE(const BlockData &cmd, bool withDelay, bool response) {
     // DEBUG_PRINTLN("Sending message:");
     // DEBUG_PRINTVECTOR(cmd);
     // DEBUG_PRINTLN();
@@ -222,15 +217,12 @@ bool SparkBTControl::writeBLE(ByteVector &cmd, bool withDelay, bool response) {
                 DEBUG_PRINTVECTOR(cmd);
                 DEBUG_PRINTLN();
                 bool return_value = true;
-                ByteVector send_cmd;
-                while (cmd.size() > 0) {
-                    int cmd_size = cmd.size();
-                    int cut_point = min(cmd_size, bleMaxMsgSize_);
-                    if (cut_point > 0) {
-                        send_cmd.assign(cmd.begin(), cmd.begin() + cut_point);
-                        cmd.assign(cmd.begin() + cut_point, cmd.end());
-                        return_value = characteristic->writeValue(send_cmd.data(), send_cmd.size(), response);
-                    }
+                int cmd_size = cmd.size();
+                int sent = 0;
+                while (sent < cmd_size && bleMaxMsgSize_ > 0) {
+                    int cut_point = min(cmd_size - sent, bleMaxMsgSize_);
+                    return_value = characteristic->writeValue(cmd.data() + sent, cut_point, response);
+                    sent += cut_point;
                 }
                 if (return_value) {
                     // Delay seems to be required in order to not lose any packages.
@@ -374,16 +366,9 @@ void SparkBTControl::onWrite(NimBLECharacteristic *pCharacteristic) {
     DEBUG_PRINT(pCharacteristic->getUUID().toString().c_str());
     DEBUG_PRINTLN(": onWrite()");
     string rxValue = pCharacteristic->getValue();
-    ByteVector byteVector;
-    byteVector.clear();
-
     if (rxValue.length() > 0) {
-        for (int i = 0; i < rxValue.length(); i++) {
-            byteVector.push_back((byte)(rxValue[i]));
-        }
+        dataReceived((const uint8_t *)rxValue.data(), rxValue.length());
     }
-    // Add message to Queue for processing
-    spark_dc_->queueMessage(byteVector);
 }
 
 void SparkBTControl::onSubscribe(NimBLECharacteristic *pCharacteristic,
@@ -404,46 +389,47 @@ void SparkBTControl::onSubscribe(NimBLECharacteristic *pCharacteristic,
     Serial.println(str.c_str());
 };
 
-void SparkBTControl::notifyClients(const vector<CmdData> &msg) {
+bool SparkBTControl::notifyClients(const BlockData &block) {
+    bool isSent = false;
     if (server_) {
         NimBLEService *service = server_->getServiceByUUID(SPARK_BLE_SERVICE_UUID);
         if (service) {
             NimBLECharacteristic *characteristic = service->getCharacteristic(
                 SPARK_BLE_NOTIF_CHAR_UUID);
             if (characteristic) {
-                for (auto block : msg) {
-                    /*DEBUG_PRINTLN("Sending data:");
-                    DEBUG_PRINTVECTOR(block);
-                    DEBUG_PRINTLN();*/
-                    characteristic->setValue(&block.data.data()[0], block.data.size());
-                    characteristic->notify();
-                }
+                /*DEBUG_PRINTLN("Sending data:");
+                DEBUG_PRINTVECTOR(block);
+                DEBUG_PRINTLN();*/
+                characteristic->setValue(block.data(), block.size());
+                characteristic->notify();
                 DEBUG_PRINTLN("Clients notified.");
+                isSent = true;
             }
         }
     }
 
     if (btSerial && btSerial->hasClient()) {
         DEBUG_PRINTLN("Sending message via BT Serial:");
-        for (auto chunk : msg) {
-            ByteVector chunkData = chunk.data;
-            for (auto by : chunkData) {
-                if (by < 16) {
-                    DEBUG_PRINT("0");
-                }
-                DEBUG_PRINT(by, HEX);
-                btSerial->write(by);
-            }
-            DEBUG_PRINTLN();
-            DEBUG_PRINTF("Free Heap size: %d\n", ESP.getFreeHeap());
-        }
+        DEBUG_PRINTVECTOR(block);
+        DEBUG_PRINTLN();
+        btSerial->write(block.data(), block.size());
+        isSent = true;
     }
+    return isSent;
+}
+
+bool SparkBTControl::send(const BlockData &block) {
+    if (client_) {
+        return writeBLE(block, withDelay_);
+    }
+    return notifyClients(block);
 }
 
 // AMP Mode
 void SparkBTControl::onConnect(NimBLEServer *pServer_,
                                ble_gap_conn_desc *desc) {
     isAppConnectedBLE_ = true;
+    connectionChanged(true);
     Serial.println("Multi-connect support: start advertising");
     //	pServer->updateConnParams(desc->conn_handle, 40, 80, 5, 51);
     NimBLEDevice::startAdvertising();
@@ -452,7 +438,7 @@ void SparkBTControl::onConnect(NimBLEServer *pServer_,
 // APP mode
 void SparkBTControl::onConnect(NimBLEClient *pClient_) {
     NimBLEClientCallbacks::onConnect(pClient_);
-    spark_dc_->getAmpName();
+    connectionChanged(true);
 }
 
 // AMP mode when App is disconnected
@@ -460,6 +446,7 @@ void SparkBTControl::onDisconnect(NimBLEServer *pServer_) {
     Serial.println("Client disconnected");
     isAppConnectedBLE_ = false;
     notificationCount = 0;
+    connectionChanged(false);
     Serial.println("Start advertising");
     NimBLEDevice::startAdvertising();
 }
@@ -468,6 +455,7 @@ void SparkBTControl::onDisconnect(NimBLEServer *pServer_) {
 void SparkBTControl::onDisconnect(NimBLEClient *pClient_) {
     isAmpConnected_ = false;
     isConnectionFound_ = false;
+    connectionChanged(false);
     if (!(NimBLEDevice::getScan()->isScanning())) {
         startScan();
     }
@@ -497,6 +485,9 @@ void SparkBTControl::serialCallback(esp_spp_cb_event_t event, esp_spp_cb_param_t
 void SparkBTControl::startBTSerial() {
     btSerial = new BluetoothSerial();
     btSerial->register_callback(serialCallback);
+    btSerial->onData([this](const uint8_t *data, size_t length) {
+        serialDataReceived(data, length);
+    });
     // btStart();
     if (btSerial->begin(btNameSerial.c_str(), false)) {
         Serial.printf("Started BT Serial with name %s \n",
@@ -507,6 +498,26 @@ void SparkBTControl::startBTSerial() {
     }
 }
 
+void SparkBTControl::serialDataReceived(const uint8_t *data, size_t length) {
+    // Bluetooth serial is a byte stream, chunks are passed on when the end marker has been received
+    for (size_t i = 0; i < length; i++) {
+        if (!serialData_.push_back(data[i])) {
+            isSerialDataOverflow_ = true;
+        }
+        if (data[i] == 0xF7) {
+            if (isSerialDataOverflow_) {
+                // Longer than any block of the protocol, cannot be a valid chunk
+                LOG_ERROR("Serial chunk exceeds %d bytes, dropped\n", MAX_BLOCK_SIZE);
+            } else {
+                DEBUG_PRINTLN("Received a message");
+                dataReceived(serialData_.data(), serialData_.size());
+            }
+            serialData_.clear();
+            isSerialDataOverflow_ = false;
+        }
+    }
+}
+
 void SparkBTControl::stopBTSerial() {
     // Stop Bluetooth Serial
     btSerial->end();
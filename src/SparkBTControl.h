@@ -9,6 +9,7 @@
 #define SPARKBLECONTROL_H_
 
 #include "Config_Definitions.h"
+#include "SparkTransport.h"
 #include "SparkTypes.h"
 #include <Arduino.h>
 #include <BluetoothSerial.h>
@@ -16,25 +17,24 @@
 #include <string>
 #include <vector>
 
-#include "SparkDataControl.h"
-
 using namespace std;
 
 // Service and characteristics UUIDs of Spark Amp
 
 using ByteVector = vector<byte>;
-class SparkDataControl;
 
 // Forward declaration of Callbacks classes, does nothing special, only default actions
 // class ClientCallbacks: public NimBLEClientCallbacks {};
 
-class SparkBTControl : public NimBLEAdvertisedDeviceCallbacks,
+// Transport over BLE as client of the Spark Amp (APP mode) or as
+// BLE server / Bluetooth serial for the Spark App (AMP mode)
+class SparkBTControl : public SparkTransport,
+                       NimBLEAdvertisedDeviceCallbacks,
                        NimBLECharacteristicCallbacks,
                        NimBLEServerCallbacks,
                        NimBLEClientCallbacks {
 public:
     SparkBTControl();
-    SparkBTControl(SparkDataControl *dc);
     virtual ~SparkBTControl();
 
     /**
@@ -85,13 +85,11 @@ public:
      * @brief  Subscribe to notifications from Spark Amp.
      *
      * This is called by SparkDataControl so it gets notified when the Spark Amp
-     * returns messages to Ignitron
-     *
-     * @param notifyCallback Function to be called when notifications are received
+     * returns messages to Ignitron. Notifications are passed to the receive callback.
      *
      * @return TRUE if successful
      */
-    bool subscribeToNotifications(notify_callback notifyCallback = nullptr);
+    bool subscribeToNotifications();
     /**
      * @brief  Send messages via BLE to Spark Amp or App
      *
@@ -103,17 +101,14 @@ public:
      *
      * @return TRUE if successful
      */
-    bool writeBLE(ByteVector &cmd, bool withDelay = false, bool response = false);
+    bool writeBLE(const BlockData &cmd, bool withDelay = false, bool response = false);
     /**
      * @brief  Initializes Ignitron BLE as client to connect to the Spark Amp
      *
-     * Sets up the BLE connection and initiates a scan for the Spark Amp. When
-     * servers have been found, the notifyCallback function is called back.
-     *
-     * @param notifyCallback function called back when servers are found
+     * Sets up the BLE connection and initiates a scan for the Spark Amp.
      *
      */
-    void initBLE(notify_callback notifyCallback = nullptr);
+    void initBLE();
     /**
      * @brief  Starts a scan for servers to connect to.
      *
@@ -153,30 +148,26 @@ public:
      * so that the Spark App can connect to Ignitron
      *
      */
-    void notifyClients(const vector<CmdData> &msg);
+    bool notifyClients(const BlockData &block);
+
+    // SparkTransport: connected to the amp (APP mode) or the app (AMP mode)
+    bool isConnected() const override {
+        return isAmpConnected_ || isAppConnected();
+    }
+    // SparkTransport: writes to the amp in APP mode, notifies the app in AMP mode
+    bool send(const BlockData &block) override;
 
     void stopBLEServer();
 
     void startBTSerial();
     void stopBTSerial();
 
-    bool byteAvailable() {
-        if (btSerial != NULL) {
-            return btSerial->available();
-        } else
-            return false;
-    }
-    byte readByte() {
-        if (btSerial != NULL) {
-            return btSerial->read();
-        } else
-            return false;
-    }
-
     void setMaxBleMsgSize(int size) {
         if (size > 0)
             bleMaxMsgSize_ = size;
     }
+    // Some amps need a delay after each write to not lose any packages
+    void setWriteDelay(bool withDelay) { withDelay_ = withDelay; }
 
 private:
     const string SPARK_BLE_SERVICE_UUID = "FFC0";
@@ -197,7 +188,12 @@ private:
     // isClientConnected will be set when a client is connected to ESP in AMP mode
     bool isAppConnectedBLE_ = false;
     static bool isAppConnectedSerial_;
-    notify_callback notifyCB_;
+    bool withDelay_ = false;
+    // Bluetooth serial data is collected until a chunk is complete. The buffer is
+    // fixed, so receiving does not allocate in the task of the Bluetooth stack.
+    BlockData serialData_;
+    bool isSerialDataOverflow_ = false;
+    void serialDataReceived(const uint8_t *data, size_t length);
 
     const uint32_t kScanTime = 0; /** 0 = scan forever */
     const uint8_t kNotificationOn[2] = {0x1, 0x0};
@@ -216,7 +212,6 @@ private:
     NimBLECharacteristic *sparkNotificationCharacteristic_ = nullptr;
     NimBLEAdvertising *advertising_ = nullptr;
 
-    SparkDataControl *spark_dc_;
     void onWrite(NimBLECharacteristic *characteristic);
     void onSubscribe(NimBLECharacteristic *characteristic,
                      ble_gap_conn_desc *desc, uint16_t subValue);
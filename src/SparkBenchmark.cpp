@@ -0,0 +1,202 @@
+/*
+ * SparkBenchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkBenchmark.h"
+
+#ifdef BENCHMARK
+
+#include "SparkBenchmarkWorkloads.h"
+#include "SparkCapture.h"
+#include "SparkDisplayControl.h"
+#include "SparkFileSystem.h"
+#include "SparkLEDControl.h"
+#include "SparkPresetControl.h"
+
+#include <memory>
+
+SparkBenchmark &SparkBenchmark::getInstance() {
+    static SparkBenchmark INSTANCE;
+    return INSTANCE;
+}
+
+void SparkBenchmark::run(const string &name, Workload workload, unsigned long iterations) {
+    // Warm up, e.g. to fill caches and let containers reach their size
+    workload();
+
+    BenchmarkResult result;
+    result.name = name;
+    unsigned long batchSize = iterations > 0 ? iterations : 1;
+    uint64_t totalCycles = 0;
+    uint64_t totalMicros = 0;
+    uint32_t freeHeapBefore = ESP.getFreeHeap();
+
+    while (true) {
+        uint32_t startMicros = micros();
+        uint32_t startCycles = ESP.getCycleCount();
+        for (unsigned long i = 0; i < batchSize; i++) {
+            workload();
+        }
+        // Cycle counter wraps after some seconds, each batch is measured on its own
+        totalCycles += ESP.getCycleCount() - startCycles;
+        totalMicros += micros() - startMicros;
+        result.iterations += batchSize;
+        if (iterations > 0 || totalMicros >= minDuration * 1000) {
+            break;
+        }
+        batchSize *= 2;
+    }
+    result.heapDelta = (int32_t)ESP.getFreeHeap() - (int32_t)freeHeapBefore;
+    result.nanoseconds = totalMicros * 1000 / result.iterations;
+    result.cycles = totalCycles / result.iterations;
+    results_.push_back(result);
+    Serial.printf("%-40s %8lu iterations %10lu ns %10lu cycles\n", name.c_str(), result.iterations,
+                  (unsigned long)result.nanoseconds, (unsigned long)result.cycles);
+}
+
+void SparkBenchmark::runProtocolBenchmarks() {
+    // Corpus of the malformed input workload: received packets of the capture
+    ByteVector captureImage;
+    SparkCapture::getInstance().image(captureImage);
+    SparkBenchmarkWorkloads workloads(captureImage);
+
+    for (const SparkBenchmarkWorkloads::Definition &definition : SparkBenchmarkWorkloads::workloads()) {
+        run(definition.name, [&]() {
+            workloads.run(definition.workload);
+        });
+    }
+    const SparkStreamReader &sparkSsr = workloads.reader();
+    Serial.printf("Malformed input: %lu chunks rejected, %lu checksum errors, %lu bytes skipped, %lu resyncs, %lu messages truncated\n",
+                  sparkSsr.rejectedChunks(), sparkSsr.checksumErrors(), sparkSsr.skippedBytes(), sparkSsr.resyncs(),
+                  sparkSsr.truncatedMessages());
+}
+
+void SparkBenchmark::runStorageBenchmarks() {
+    SparkPresetBuilder &presetBuilder = SparkPresetControl::getInstance().presetBuilder;
+
+    File root = SPARK_FS.open("/");
+    File file = root.openNextFile();
+    string json;
+    while (file) {
+        string fileName = file.name();
+        if (!file.isDirectory() && fileName.size() > 5 && fileName.compare(fileName.size() - 5, 5, ".json") == 0) {
+            json.resize(file.size());
+            if (json.size() > 0 && file.readBytes(&json[0], json.size()) == json.size()) {
+                run("storage/getPresetFromJson/" + fileName, [&]() {
+                    presetBuilder.getPresetFromJson(&json[0]);
+                });
+            }
+        }
+        file.close();
+        file = root.openNextFile();
+    }
+    root.close();
+
+    // Cycles through all custom presets
+    int position = 0;
+    run("storage/getPreset", [&]() {
+        int numberOfPresets = max(presetBuilder.numberOfPresets(), 1);
+        presetBuilder.getPreset(position / PRESETS_PER_BANK + 1, position % PRESETS_PER_BANK + 1);
+        position = (position + 1) % numberOfPresets;
+    });
+
+    // Store and delete work on a preset list of their own, the presets, preset list and
+    // journal of the user are not touched. Heap allocated, the index holds its cache pages.
+    Preset preset = SparkBenchmarkWorkloads::examplePreset("Benchmark");
+    removeDirectory(benchmarkDirectory);
+    SPARK_FS.mkdir(benchmarkDirectory);
+    File listFile = SPARK_FS.open((string(benchmarkDirectory) + "/PresetListUUIDs.txt").c_str(), FILE_WRITE);
+    listFile.close();
+    unique_ptr<SparkPresetBuilder> scratchBuilder(new SparkPresetBuilder());
+    scratchBuilder->setDirectory(benchmarkDirectory);
+    scratchBuilder->init();
+    for (int i = 0; i < scratchPresets; i++) {
+        preset.name = "Scratch" + to_string(i);
+        scratchBuilder->storePreset(preset, i / PRESETS_PER_BANK + 1, i % PRESETS_PER_BANK + 1);
+    }
+
+    // Appended after the last preset, so the existing presets are not moved
+    preset.name = "Benchmark";
+    run("storage/storePreset+deletePreset", [&]() {
+        int lastPosition = scratchBuilder->numberOfPresets();
+        int bank = lastPosition / PRESETS_PER_BANK + 1;
+        int pre = lastPosition % PRESETS_PER_BANK + 1;
+        scratchBuilder->storePreset(preset, bank, pre);
+        scratchBuilder->deletePreset(bank, pre);
+    },
+        storageIterations);
+    scratchBuilder.reset();
+    removeDirectory(benchmarkDirectory);
+}
+
+void SparkBenchmark::removeDirectory(const char *directory) {
+    File dir = SPARK_FS.open(directory);
+    if (!dir || !dir.isDirectory()) {
+        return;
+    }
+    vector<string> paths;
+    File file = dir.openNextFile();
+    while (file) {
+        paths.push_back(file.path());
+        file.close();
+        file = dir.openNextFile();
+    }
+    dir.close();
+    for (const string &path : paths) {
+        SPARK_FS.remove(path.c_str());
+    }
+    SPARK_FS.rmdir(directory);
+}
+
+void SparkBenchmark::runDeviceBenchmarks(SparkDisplayControl *display, SparkLEDControl *leds) {
+    run("device/display/update", [&]() {
+        display->update();
+    });
+    run("device/display/redraw", [&]() {
+        display->invalidate();
+        display->update();
+    });
+    run("device/display/flush", [&]() {
+        display->display_.display();
+    });
+    run("device/leds/update", [&]() {
+        leds->updateLEDs();
+    });
+}
+
+void SparkBenchmark::runAll(SparkDisplayControl *display, SparkLEDControl *leds) {
+    clear();
+    runProtocolBenchmarks();
+    runStorageBenchmarks();
+    if (display != nullptr && leds != nullptr) {
+        runDeviceBenchmarks(display, leds);
+    }
+    report();
+}
+
+void SparkBenchmark::report() {
+    Serial.println("{");
+    Serial.println("  \"context\": {");
+    Serial.printf("    \"executable\": \"Ignitron %s\",\n", VERSION.c_str());
+    Serial.printf("    \"mhz_per_cpu\": %lu,\n", (unsigned long)ESP.getCpuFreqMHz());
+    Serial.printf("    \"free_heap\": %lu,\n", (unsigned long)ESP.getFreeHeap());
+    Serial.printf("    \"min_free_heap\": %lu,\n", (unsigned long)ESP.getMinFreeHeap());
+    Serial.printf("    \"max_alloc_heap\": %lu\n", (unsigned long)ESP.getMaxAllocHeap());
+    Serial.println("  },");
+    Serial.println("  \"benchmarks\": [");
+    for (int i = 0; i < results_.size(); i++) {
+        const BenchmarkResult &result = results_[i];
+        Serial.printf("    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %lu, "
+                      "\"real_time\": %lu, \"cpu_time\": %lu, \"time_unit\": \"ns\", \"cycles\": %lu, \"heap_delta\": %ld}%s\n",
+                      result.name.c_str(), result.iterations, (unsigned long)result.nanoseconds,
+                      (unsigned long)result.nanoseconds, (unsigned long)result.cycles, (long)result.heapDelta,
+                      i < results_.size() - 1 ? "," : "");
+    }
+    Serial.println("  ]");
+    Serial.println("}");
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * SparkBenchmark.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_BENCHMARK_H
+#define SPARK_BENCHMARK_H
+
+#include "Config_Definitions.h"
+#include <Arduino.h>
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class SparkDisplayControl;
+class SparkLEDControl;
+
+struct BenchmarkResult {
+    string name;
+    unsigned long iterations = 0;
+    // Average per iteration
+    uint32_t nanoseconds = 0;
+    uint32_t cycles = 0;
+    // Change of the free heap over all iterations
+    int32_t heapDelta = 0;
+};
+
+class SparkBenchmark {
+    // Benchmarks
+    // ----------
+    // When BENCHMARK is defined, the benchmark suite can be started with command 'b' on
+    // Serial. Each workload is repeated until it has run for at least minDuration ms (or
+    // a fixed number of iterations), time and CPU cycles per iteration are measured.
+    // Workloads:
+    //   encode:  SparkMessage changePreset, turnEffectOnOff, sendAck
+    //   decode:  SparkStreamReader processBlock (single and multi chunk), convertDataTo8bit,
+    //            processBlock with bit flips, truncations and inserted bytes
+    //   storage: getPresetFromJson for every preset file, getPreset (load from the file system),
+    //            storePreset + deletePreset
+    //   device:  display update (skipped if nothing changed), redraw (render and send all
+    //            pages) and flush only, LED update
+    // The results are printed as JSON in the format of Google Benchmark, so results of
+    // different versions can be compared with its tools.
+    // The encode and decode workloads are shared with the host benchmarks (host/bench,
+    // Google Benchmark), see SparkBenchmarkWorkloads.h. They update the status like
+    // received messages do. The store and delete workload runs on a scratch preset list
+    // in benchmarkDirectory, which is removed afterwards.
+    // With BENCHMARK_FIRMWARE (PlatformIO environment "benchmark") the firmware does not
+    // connect to the amp, it runs all benchmarks on boot instead.
+
+public:
+    typedef function<void()> Workload;
+
+    static SparkBenchmark &getInstance();
+
+    SparkBenchmark(const SparkBenchmark &) = delete;
+    SparkBenchmark &operator=(const SparkBenchmark &) = delete;
+
+    // Runs the workload, iterations = 0 repeats it for at least minDuration
+    void run(const string &name, Workload workload, unsigned long iterations = 0);
+
+    // Encode and decode workloads of SparkBenchmarkWorkloads, the capture is the malformed input corpus
+    void runProtocolBenchmarks();
+    void runStorageBenchmarks();
+    void runDeviceBenchmarks(SparkDisplayControl *display, SparkLEDControl *leds);
+    // Runs all benchmarks and prints the report, device benchmarks only if display and leds are given
+    void runAll(SparkDisplayControl *display = nullptr, SparkLEDControl *leds = nullptr);
+
+    const vector<BenchmarkResult> &results() const { return results_; }
+    void clear() { results_.clear(); }
+    // Prints the results as JSON
+    void report();
+
+    static const unsigned long minDuration = 200;
+    static const unsigned long storageIterations = 10;
+    static constexpr const char *benchmarkDirectory = "/bench";
+    // Presets in the scratch preset list before storing and deleting
+    static const int scratchPresets = 8;
+
+private:
+    SparkBenchmark() {}
+
+    static void removeDirectory(const char *directory);
+
+    vector<BenchmarkResult> results_;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * SparkBenchmarkWorkloads.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkBenchmarkWorkloads.h"
+
+#ifdef BENCHMARK
+
+#include "SparkArena.h"
+#include "SparkCapture.h"
+
+namespace {
+
+void appendBlocks(const vector<CmdData> &message, vector<ByteVector> &blocks) {
+    for (const CmdData &cmd : message) {
+        blocks.push_back(ByteVector(cmd.data.begin(), cmd.data.end()));
+    }
+}
+
+} // namespace
+
+SparkBenchmarkWorkloads::SparkBenchmarkWorkloads(const ByteVector &captureImage) {
+    preset_ = examplePreset("Benchmark");
+    fxName_ = preset_.pedals[0].name.str();
+
+    // Messages as sent by the amp
+    appendBlocks(sparkMsg_.sendSerialNumber(0x01), singleChunk_);
+    appendBlocks(sparkMsg_.changePreset(preset_, DIR_FROM_SPARK, 0x01), multiChunk_);
+
+    // 01FE header and chunk header of the first block
+    const ByteVector &firstBlock = multiChunk_.front();
+    int chunkStart = 16;
+    int chunkEnd = chunkStart;
+    while (chunkEnd < (int)firstBlock.size() && firstBlock[chunkEnd] != 0xF7) {
+        chunkEnd++;
+    }
+    payload_ = firstBlock.data() + chunkStart + 6;
+    payloadLength_ = chunkEnd - chunkStart - 6;
+
+    SparkCapture::packets(captureImage, CAPTURE_IN, corpus_);
+    if (corpus_.empty()) {
+        corpus_ = multiChunk_;
+        corpus_.insert(corpus_.end(), singleChunk_.begin(), singleChunk_.end());
+    }
+}
+
+const vector<SparkBenchmarkWorkloads::Definition> &SparkBenchmarkWorkloads::workloads() {
+    static const vector<Definition> definitions = {
+        {"encode/changePreset", &SparkBenchmarkWorkloads::encodeChangePreset},
+        {"encode/turnEffectOnOff", &SparkBenchmarkWorkloads::encodeTurnEffectOnOff},
+        {"encode/sendAck", &SparkBenchmarkWorkloads::encodeSendAck},
+        {"decode/processBlock/singleChunk", &SparkBenchmarkWorkloads::decodeSingleChunk},
+        {"decode/processBlock/multiChunk", &SparkBenchmarkWorkloads::decodeMultiChunk},
+        {"decode/convertDataTo8bit", &SparkBenchmarkWorkloads::decodeConvertDataTo8bit},
+        {"decode/processBlock/malformed", &SparkBenchmarkWorkloads::decodeMalformed},
+    };
+    return definitions;
+}
+
+void SparkBenchmarkWorkloads::encodeChangePreset() {
+    sparkMsg_.changePreset(preset_, DIR_TO_SPARK, 0x01);
+}
+
+void SparkBenchmarkWorkloads::encodeTurnEffectOnOff() {
+    sparkMsg_.turnEffectOnOff(0x01, fxName_, enable_);
+    enable_ = !enable_;
+}
+
+void SparkBenchmarkWorkloads::encodeSendAck() {
+    sparkMsg_.sendAck(0x01, 0x15, DIR_FROM_SPARK);
+}
+
+void SparkBenchmarkWorkloads::decodeSingleChunk() {
+    for (const ByteVector &data : singleChunk_) {
+        block_ = data;
+        sparkSsr_.processBlock(block_);
+    }
+}
+
+void SparkBenchmarkWorkloads::decodeMultiChunk() {
+    for (const ByteVector &data : multiChunk_) {
+        block_ = data;
+        sparkSsr_.processBlock(block_);
+    }
+}
+
+void SparkBenchmarkWorkloads::decodeConvertDataTo8bit() {
+    {
+        ScratchByteVector data8bit;
+        sparkSsr_.convertDataTo8bit(payload_, payloadLength_, data8bit);
+    }
+    SparkArena::getInstance().reset();
+}
+
+void SparkBenchmarkWorkloads::decodeMalformed() {
+    block_ = corpus_[next_];
+    next_ = (next_ + 1) % corpus_.size();
+    switch (random(4)) {
+    case 0: // bit flip
+        block_[random(block_.size())] ^= 1 << random(8);
+        break;
+    case 1: // truncation
+        block_.resize(random(block_.size()));
+        break;
+    case 2: // inserted byte
+        block_.insert(block_.begin() + random(block_.size() + 1), (byte)random(256));
+        break;
+    default: // unchanged
+        break;
+    }
+    sparkSsr_.processBlock(block_);
+}
+
+uint32_t SparkBenchmarkWorkloads::random(uint32_t range) {
+    seed_ = seed_ * 1103515245 + 12345;
+    return (seed_ >> 16) % range;
+}
+
+Preset SparkBenchmarkWorkloads::examplePreset(const string &name) {
+    static const char *effects[] = {"bias.noisegate", "Compressor", "DistortionTS9", "Twin",
+                                    "ChorusAnalog", "DelayMono", "bias.reverb"};
+
+    Preset preset;
+    preset.uuid = "12345678-1234-1234-1234-123456789012";
+    preset.name = name;
+    preset.version = "0.7";
+    preset.description = "Description of " + name;
+    preset.icon = "icon.png";
+    preset.bpm = 120;
+    for (int i = 0; i < 7; i++) {
+        Pedal pedal;
+        pedal.name = effects[i];
+        pedal.isOn = i % 2 == 0;
+        for (int p = 0; p < pedal.name.numParameters(); p++) {
+            Parameter parameter;
+            parameter.number = p;
+            parameter.special = 0x91;
+            parameter.value = (float)(p + 1) / 10;
+            pedal.parameters.push_back(parameter);
+        }
+        preset.pedals.push_back(pedal);
+    }
+    preset.isEmpty = false;
+    return preset;
+}
+
+#endif
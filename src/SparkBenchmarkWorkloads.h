@@ -0,0 +1,87 @@
+/*
+ * SparkBenchmarkWorkloads.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_BENCHMARK_WORKLOADS_H
+#define SPARK_BENCHMARK_WORKLOADS_H
+
+#include "Config_Definitions.h"
+#include "SparkMessage.h"
+#include "SparkStreamReader.h"
+#include "SparkTypes.h"
+#include <Arduino.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class SparkBenchmarkWorkloads {
+    // Protocol workloads of the benchmarks
+    // ------------------------------------
+    // Encode and decode workloads shared by the device benchmarks (SparkBenchmark) and
+    // the host benchmarks (host/bench), only the timing harness differs. Each call of a
+    // workload is one iteration, workloads() lists them with the names of the report.
+    // All workloads use the same messages on both sides: examplePreset() has a full chain
+    // of catalog effects and does not depend on the presets on the file system.
+    // The malformed input workload feeds deterministically mutated copies (bit flips,
+    // truncations, inserted bytes) of its corpus to SparkStreamReader, the corpus are the
+    // received packets of a capture image or generated messages if it has none.
+
+public:
+    typedef void (SparkBenchmarkWorkloads::*Workload)();
+
+    struct Definition {
+        const char *name;
+        Workload workload;
+    };
+
+    explicit SparkBenchmarkWorkloads(const ByteVector &captureImage = ByteVector());
+
+    SparkBenchmarkWorkloads(const SparkBenchmarkWorkloads &) = delete;
+    SparkBenchmarkWorkloads &operator=(const SparkBenchmarkWorkloads &) = delete;
+
+    static const vector<Definition> &workloads();
+    void run(Workload workload) { (this->*workload)(); }
+
+    void encodeChangePreset();
+    void encodeTurnEffectOnOff();
+    void encodeSendAck();
+    void decodeSingleChunk();
+    void decodeMultiChunk();
+    void decodeConvertDataTo8bit();
+    void decodeMalformed();
+
+    // Preset with a full chain of catalog effects, the name makes it unique
+    static Preset examplePreset(const string &name);
+
+    const SparkStreamReader &reader() const { return sparkSsr_; }
+    const vector<ByteVector> &corpus() const { return corpus_; }
+
+private:
+    // Linear congruential generator, the mutations are the same in every run
+    uint32_t random(uint32_t range);
+
+    SparkMessage sparkMsg_;
+    SparkStreamReader sparkSsr_;
+    ByteVector block_;
+
+    Preset preset_;
+    string fxName_;
+    bool enable_ = false;
+
+    vector<ByteVector> singleChunk_;
+    vector<ByteVector> multiChunk_;
+    // 7 bit payload of the first chunk of the preset
+    const byte *payload_ = nullptr;
+    int payloadLength_ = 0;
+
+    vector<ByteVector> corpus_;
+    size_t next_ = 0;
+    uint32_t seed_ = 1;
+};
+
+#endif
@@ -477,6 +477,8 @@ void SparkButtonHandler::btnPresetHandler(BfButton *btn, BfButton::press_pattern
         return;
     }
 
+    TRACE_BUTTON_PRESS();
+
     // Debug
     ButtonGpio pressed_btn_gpio = (ButtonGpio)btn->getID();
     DEBUG_PRINT("Button pressed: ");
@@ -568,6 +570,8 @@ void SparkButtonHandler::btnToggleFXHandler(BfButton *btn, BfButton::press_patte
         return;
     }
 
+    TRACE_BUTTON_PRESS();
+
     // Debug
     ButtonGpio pressed_btn_gpio = (ButtonGpio)btn->getID();
     DEBUG_PRINT("Button pressed: ");
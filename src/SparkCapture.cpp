@@ -0,0 +1,136 @@
+/*
+ * SparkCapture.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkCapture.h"
+#include "SparkFileSystem.h"
+
+const char *SparkCapture::captureFileName = "/capture.bin";
+
+SparkCapture &SparkCapture::getInstance() {
+    static SparkCapture INSTANCE;
+    return INSTANCE;
+}
+
+void SparkCapture::copyIn(size_t pos, const uint8_t *data, size_t length) {
+    size_t first = min(length, bufferSize - pos);
+    memcpy(buffer_ + pos, data, first);
+    memcpy(buffer_, data + first, length - first);
+}
+
+void SparkCapture::copyOut(size_t pos, uint8_t *data, size_t length) const {
+    size_t first = min(length, bufferSize - pos);
+    memcpy(data, buffer_ + pos, first);
+    memcpy(data + first, buffer_, length - first);
+}
+
+void SparkCapture::dropOldest() {
+    uint8_t header[recordHeaderSize];
+    copyOut(tail_, header, recordHeaderSize);
+    size_t recordSize = recordHeaderSize + (header[5] | header[6] << 8);
+    tail_ = (tail_ + recordSize) % bufferSize;
+    used_ -= recordSize;
+    overwritten_++;
+}
+
+void SparkCapture::record(CaptureDirection direction, const uint8_t *data, size_t length) {
+    if (!isEnabled_ || length == 0) {
+        return;
+    }
+    size_t recordSize = recordHeaderSize + length;
+    if (recordSize > bufferSize) {
+        return;
+    }
+    while (bufferSize - used_ < recordSize) {
+        dropOldest();
+    }
+    uint32_t timestamp = micros();
+    uint8_t header[recordHeaderSize] = {
+        (uint8_t)timestamp, (uint8_t)(timestamp >> 8), (uint8_t)(timestamp >> 16), (uint8_t)(timestamp >> 24),
+        (uint8_t)direction, (uint8_t)length, (uint8_t)(length >> 8)};
+    copyIn(head_, header, recordHeaderSize);
+    copyIn((head_ + recordHeaderSize) % bufferSize, data, length);
+    head_ = (head_ + recordSize) % bufferSize;
+    used_ += recordSize;
+    recorded_++;
+}
+
+void SparkCapture::clear() {
+    tail_ = 0;
+    head_ = 0;
+    used_ = 0;
+    recorded_ = 0;
+    overwritten_ = 0;
+}
+
+void SparkCapture::image(ByteVector &image) const {
+    image.resize(imageHeaderSize + used_);
+    memcpy(image.data(), "SPKC", 4);
+    image[4] = imageVersion;
+    copyOut(tail_, image.data() + imageHeaderSize, used_);
+}
+
+bool SparkCapture::readRecord(const ByteVector &image, size_t &pos, uint32_t &timestamp, CaptureDirection &direction,
+                              const uint8_t *&data, size_t &length) {
+    if (pos + recordHeaderSize > image.size()) {
+        return false;
+    }
+    const uint8_t *header = image.data() + pos;
+    timestamp = header[0] | header[1] << 8 | header[2] << 16 | (uint32_t)header[3] << 24;
+    direction = (CaptureDirection)header[4];
+    length = header[5] | header[6] << 8;
+    if (pos + recordHeaderSize + length > image.size()) {
+        return false;
+    }
+    data = header + recordHeaderSize;
+    pos += recordHeaderSize + length;
+    return true;
+}
+
+void SparkCapture::packets(const ByteVector &image, CaptureDirection direction, vector<ByteVector> &packets) {
+    size_t pos = imageHeaderSize;
+    uint32_t timestamp;
+    CaptureDirection recordDirection;
+    const uint8_t *data;
+    size_t length;
+    while (readRecord(image, pos, timestamp, recordDirection, data, length)) {
+        if (recordDirection == direction) {
+            packets.push_back(ByteVector(data, data + length));
+        }
+    }
+}
+
+void SparkCapture::dump() const {
+    ByteVector captureImage;
+    image(captureImage);
+    Serial.printf("Capture: %lu packets recorded, %lu overwritten, %d bytes\n",
+                  recorded_, overwritten_, (int)captureImage.size());
+    for (size_t pos = 0; pos < captureImage.size(); pos++) {
+        Serial.printf("%02X", captureImage[pos]);
+        if (pos % 32 == 31 || pos == captureImage.size() - 1) {
+            Serial.println();
+        }
+    }
+    Serial.println("Capture end");
+}
+
+bool SparkCapture::save(const char *fileName) const {
+    ByteVector captureImage;
+    image(captureImage);
+    File file = SPARK_FS.open(fileName, FILE_WRITE);
+    if (!file) {
+        Serial.printf("Failed to open %s for writing\n", fileName);
+        return false;
+    }
+    size_t written = file.write(captureImage.data(), captureImage.size());
+    file.close();
+    if (written != captureImage.size()) {
+        Serial.printf("Failed to write capture to %s\n", fileName);
+        return false;
+    }
+    Serial.printf("Capture saved to %s (%d bytes)\n", fileName, (int)written);
+    return true;
+}
@@ -0,0 +1,94 @@
+/*
+ * SparkCapture.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_CAPTURE_H
+#define SPARK_CAPTURE_H
+
+#include "Config_Definitions.h"
+#include <Arduino.h>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+using ByteVector = vector<byte>;
+
+// Size of the capture ring in bytes
+#ifndef CAPTURE_BUFFER_SIZE
+#define CAPTURE_BUFFER_SIZE 8192
+#endif
+
+enum CaptureDirection {
+    CAPTURE_IN,
+    CAPTURE_OUT
+};
+
+class SparkCapture {
+    // Capture of the Spark protocol
+    // -----------------------------
+    // Every packet received from or sent to the Spark Amp/App is recorded in a binary ring
+    // with timestamp and direction. When the ring is full, the oldest packets are dropped,
+    // so the capture always holds the latest traffic. Recording is on by default and can
+    // be toggled at runtime (command 'c' on Serial). Continuous tuner output (03 64) is
+    // decoded outside of the main loop and not recorded, it would push out everything else.
+    //
+    // Capture image (dump over Serial, capture file), all values little endian:
+    //   magic "SPKC", version (1 byte)
+    //   per packet: timestamp in us (4 bytes), direction (1 byte), length (2 bytes), data
+    // The image is printed as hex (command 'd') or saved to captureFileName (command 'w')
+    // and can be replayed with SparkCaptureReplay.
+
+public:
+    static SparkCapture &getInstance();
+
+    SparkCapture(const SparkCapture &) = delete;
+    SparkCapture &operator=(const SparkCapture &) = delete;
+
+    void record(CaptureDirection direction, const uint8_t *data, size_t length);
+    void record(CaptureDirection direction, const ByteVector &data) { record(direction, data.data(), data.size()); }
+
+    void setEnabled(bool enabled) { isEnabled_ = enabled; }
+    bool isEnabled() const { return isEnabled_; }
+    void clear();
+
+    // Builds the capture image with all recorded packets, oldest first
+    void image(ByteVector &image) const;
+    void dump() const;
+    bool save(const char *fileName = captureFileName) const;
+
+    // Reads the record of a capture image at pos and moves pos to the next one, returns false
+    // at the end of the image or if the record is truncated
+    static bool readRecord(const ByteVector &image, size_t &pos, uint32_t &timestamp, CaptureDirection &direction,
+                           const uint8_t *&data, size_t &length);
+    // Appends the packets of direction in a capture image to packets, stops at a truncated record
+    static void packets(const ByteVector &image, CaptureDirection direction, vector<ByteVector> &packets);
+
+    static const char *captureFileName;
+    static const byte imageVersion = 1;
+    static const size_t imageHeaderSize = 5;
+    static const size_t recordHeaderSize = 7;
+    static const size_t bufferSize = CAPTURE_BUFFER_SIZE;
+
+private:
+    SparkCapture() {}
+
+    void copyIn(size_t pos, const uint8_t *data, size_t length);
+    void copyOut(size_t pos, uint8_t *data, size_t length) const;
+    // Removes the oldest record from the ring
+    void dropOldest();
+
+    uint8_t buffer_[bufferSize] = {};
+    // Position of the oldest record and the next free byte, used bytes
+    size_t tail_ = 0;
+    size_t head_ = 0;
+    size_t used_ = 0;
+    bool isEnabled_ = true;
+
+    unsigned long recorded_ = 0;
+    unsigned long overwritten_ = 0;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * SparkCaptureReplay.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkCaptureReplay.h"
+#include "SparkFileSystem.h"
+
+SparkCaptureReplay &SparkCaptureReplay::getInstance() {
+    static SparkCaptureReplay INSTANCE;
+    return INSTANCE;
+}
+
+bool SparkCaptureReplay::load(const char *fileName) {
+    stop();
+    image_.clear();
+    if (!SPARK_FS.exists(fileName)) {
+        Serial.printf("Capture file %s not found\n", fileName);
+        return false;
+    }
+    File file = SPARK_FS.open(fileName);
+    if (!file) {
+        Serial.printf("Failed to open %s\n", fileName);
+        return false;
+    }
+    image_.resize(file.size());
+    size_t bytesRead = file.read(image_.data(), image_.size());
+    file.close();
+
+    if (bytesRead != image_.size() || image_.size() < SparkCapture::imageHeaderSize
+        || memcmp(image_.data(), "SPKC", 4) != 0 || image_[4] != SparkCapture::imageVersion) {
+        Serial.printf("%s is not a valid capture\n", fileName);
+        image_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SparkCaptureReplay::readRecord(uint32_t &timestamp, CaptureDirection &direction, const uint8_t *&data, size_t &length) {
+    if (SparkCapture::readRecord(image_, pos_, timestamp, direction, data, length)) {
+        return true;
+    }
+    if (pos_ < image_.size()) {
+        Serial.println("Capture is truncated");
+    }
+    return false;
+}
+
+bool SparkCaptureReplay::start(ReplayMode mode) {
+    if (image_.empty() || packetHandler_ == nullptr) {
+        return false;
+    }
+    if (isTransportConnected()) {
+        Serial.println("Replay is not possible while connected");
+        return false;
+    }
+    stop();
+    SparkCapture &capture = SparkCapture::getInstance();
+    wasCaptureEnabled_ = capture.isEnabled();
+    capture.setEnabled(false);
+    pos_ = SparkCapture::imageHeaderSize;
+    isRunning_ = true;
+
+    if (mode == REPLAY_FULL_SPEED) {
+        runFullSpeed();
+        stop();
+        return true;
+    }
+    // Timing is relative to the first packet of the capture
+    uint32_t timestamp;
+    CaptureDirection direction;
+    const uint8_t *data;
+    size_t length;
+    firstTimestamp_ = readRecord(timestamp, direction, data, length) ? timestamp : 0;
+    pos_ = SparkCapture::imageHeaderSize;
+    replayStart_ = micros();
+    Serial.println("Replaying capture in real time");
+    return true;
+}
+
+void SparkCaptureReplay::stop() {
+    if (!isRunning_) {
+        return;
+    }
+    isRunning_ = false;
+    SparkCapture::getInstance().setEnabled(wasCaptureEnabled_);
+}
+
+void SparkCaptureReplay::update() {
+    if (!isRunning_) {
+        return;
+    }
+    if (isTransportConnected()) {
+        Serial.println("Connected, replay stopped");
+        stop();
+        return;
+    }
+    uint32_t elapsed = micros() - replayStart_;
+    uint32_t timestamp;
+    CaptureDirection direction;
+    const uint8_t *data;
+    size_t length;
+    while (true) {
+        size_t recordPos = pos_;
+        if (!readRecord(timestamp, direction, data, length)) {
+            Serial.println("Replay finished");
+            stop();
+            return;
+        }
+        if (timestamp - firstTimestamp_ > elapsed) {
+            // Not due yet
+            pos_ = recordPos;
+            return;
+        }
+        if (direction == CAPTURE_IN) {
+            packetHandler_(data, length);
+        }
+    }
+}
+
+void SparkCaptureReplay::runFullSpeed() {
+    unsigned long packets = 0;
+    unsigned long bytes = 0;
+    uint32_t timestamp;
+    CaptureDirection direction;
+    const uint8_t *data;
+    size_t length;
+
+    uint32_t startTime = micros();
+    while (readRecord(timestamp, direction, data, length)) {
+        if (direction != CAPTURE_IN) {
+            continue;
+        }
+        packetHandler_(data, length);
+        packets++;
+        bytes += length;
+    }
+    uint32_t duration = micros() - startTime;
+    Serial.printf("Replayed %lu packets (%lu bytes) in %lu us", packets, bytes, (unsigned long)duration);
+    if (duration > 0) {
+        Serial.printf(", %lu packets/s, %lu bytes/s", (unsigned long)(packets * 1000000ULL / duration),
+                      (unsigned long)(bytes * 1000000ULL / duration));
+    }
+    Serial.println();
+}
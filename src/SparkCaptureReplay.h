@@ -0,0 +1,81 @@
+/*
+ * SparkCaptureReplay.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_CAPTURE_REPLAY_H
+#define SPARK_CAPTURE_REPLAY_H
+
+#include "Config_Definitions.h"
+#include "SparkCapture.h"
+#include <Arduino.h>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+enum ReplayMode {
+    REPLAY_REAL_TIME,
+    REPLAY_FULL_SPEED
+};
+
+class SparkCaptureReplay {
+    // Replay of a capture
+    // -------------------
+    // Loads a capture image (see SparkCapture.h) from the file system and hands the received
+    // packets to the packet handler again, so a session can be reproduced without the amp.
+    // The handler is SparkDataControl::processReplayedData, on the device as well as in the
+    // host replay (host/tools/ReplayMain.cpp) when it is built with ArduinoJson.
+    // REPLAY_REAL_TIME delivers the packets with the original timing (update() has to be
+    // called in the main loop). REPLAY_FULL_SPEED delivers all packets at once and reports
+    // the throughput, e.g. as benchmark. Sent packets are skipped.
+    // The handler is always called in the main loop: the receive buffer of the transport has
+    // a single producer, the Bluetooth task, so replayed packets must not go through it.
+    // A replay does not start while a transport is connected and stops when one connects,
+    // so replayed and live messages are never mixed.
+    // Recording is paused during a replay. Commands on Serial: 'r' real time, 'R' full speed.
+
+public:
+    typedef void (*PacketHandler)(const uint8_t *data, size_t length);
+    typedef bool (*ConnectionCheck)();
+
+    static SparkCaptureReplay &getInstance();
+
+    SparkCaptureReplay(const SparkCaptureReplay &) = delete;
+    SparkCaptureReplay &operator=(const SparkCaptureReplay &) = delete;
+
+    // Receiver of the replayed packets, isConnected tells if a transport is connected
+    void setPacketHandler(PacketHandler handler, ConnectionCheck isConnected = nullptr) {
+        packetHandler_ = handler;
+        isConnected_ = isConnected;
+    }
+
+    bool load(const char *fileName = SparkCapture::captureFileName);
+    bool start(ReplayMode mode);
+    void stop();
+    // Delivers the packets which are due in a real time replay
+    void update();
+    bool isRunning() const { return isRunning_; }
+
+private:
+    SparkCaptureReplay() {}
+
+    // Reads the record at pos_, returns false at the end of the image or if it is truncated
+    bool readRecord(uint32_t &timestamp, CaptureDirection &direction, const uint8_t *&data, size_t &length);
+    void runFullSpeed();
+
+    bool isTransportConnected() const { return isConnected_ != nullptr && isConnected_(); }
+
+    PacketHandler packetHandler_ = nullptr;
+    ConnectionCheck isConnected_ = nullptr;
+    ByteVector image_;
+    size_t pos_ = 0;
+    bool isRunning_ = false;
+    bool wasCaptureEnabled_ = false;
+    uint32_t firstTimestamp_ = 0;
+    uint32_t replayStart_ = 0;
+};
+
+#endif
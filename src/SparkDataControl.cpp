@@ -8,6 +8,7 @@
 #include "SparkDataControl.h"
 
 SparkBTControl *SparkDataControl::bleControl = nullptr;
+SparkTransport *SparkDataControl::transport = nullptr;
 SparkStreamReader SparkDataControl::sparkSsr;
 SparkStatus &SparkDataControl::statusObject = SparkStatus::getInstance();
 SparkMessage SparkDataControl::sparkMsg;
@@ -17,14 +18,24 @@ SparkKeyboardControl *SparkDataControl::keyboardControl = nullptr;
 SparkLooperControl SparkDataControl::looperControl_;
 SparkBLEKeyboard SparkDataControl::bleKeyboard = SparkBLEKeyboard();
 
-queue<ByteVector> SparkDataControl::msgQueue;
-deque<CmdData> SparkDataControl::currentCommand;
+SparkPacketBuffer SparkDataControl::receiveBuffer;
+ByteVector SparkDataControl::receivedBlock;
+atomic<bool> SparkDataControl::isConnectionLost_(false);
+vector<CmdData> SparkDataControl::currentCommand;
+int SparkDataControl::nextCommandBlock = 0;
 deque<AckData> SparkDataControl::pendingLooperAcks;
+CmdData SparkDataControl::pendingRequest;
+int SparkDataControl::requestRetries = 0;
 
 byte SparkDataControl::nextMessageNum = 0x01;
 
 bool SparkDataControl::ampNameReceived_ = false;
 
+#ifdef DEBUG
+unsigned long SparkDataControl::tunerFrameCount_ = 0;
+unsigned long SparkDataControl::tunerDecodeTime_ = 0;
+#endif
+
 // LooperSetting *SparkDataControl::looperSetting_ = nullptr;
 int SparkDataControl::tapEntrySize = 5;
 CircularBuffer SparkDataControl::tapEntries(tapEntrySize);
@@ -33,6 +44,7 @@ bool SparkDataControl::recordStartFlag = false;
 vector<CmdData>
     SparkDataControl::ackMsg;
 vector<CmdData> SparkDataControl::currentMsg;
+vector<CmdData> SparkDataControl::responseMsg;
 
 bool SparkDataControl::customPresetNumberChangePending = false;
 OperationMode SparkDataControl::operationMode_ = SPARK_MODE_APP;
@@ -43,7 +55,6 @@ OperationMode SparkDataControl::sparkModeAmp = SPARK_MODE_AMP;
 OperationMode SparkDataControl::sparkModeApp = SPARK_MODE_APP;
 AmpType SparkDataControl::sparkAmpType = AMP_TYPE_40;
 string SparkDataControl::sparkAmpName = AMP_NAME_SPARK_40;
-bool SparkDataControl::withDelay = false;
 ByteVector SparkDataControl::checksums = {};
 
 #ifdef ENABLE_BATTERY_STATUS_INDICATOR
@@ -53,9 +64,19 @@ BatteryLevel SparkDataControl::batteryLevel_ = BATTERY_LEVEL_0;
 bool SparkDataControl::isInitBoot_ = true;
 byte SparkDataControl::specialMsgNum = 0xEE;
 
+#ifdef SIMULATE_AMP
+// HW presets of the simulated amp are taken from the custom banks, like in AMP mode
+static Preset simulatedHWPreset(int presetNumber) {
+    int bank = (presetNumber - 1) / PRESETS_PER_BANK + 1;
+    int pre = (presetNumber - 1) % PRESETS_PER_BANK + 1;
+    return SparkPresetControl::getInstance().getPreset(bank, pre);
+}
+#endif
+
 SparkDataControl::SparkDataControl() {
     // init();
-    bleControl = new SparkBTControl(this);
+    bleControl = new SparkBTControl();
+    transport = bleControl;
     keyboardControl = new SparkKeyboardControl();
     keyboardControl->init();
     tapEntries = CircularBuffer(tapEntrySize);
@@ -78,6 +99,11 @@ OperationMode SparkDataControl::init(OperationMode opModeInput) {
     readOpModeFromFile();
     SparkPresetControl::getInstance().init();
 
+#ifdef BENCHMARK_FIRMWARE
+    // Benchmark firmware does not connect to amp or app
+    return operationMode_;
+#endif
+
     // Define MAC address required for keyboard
     uint8_t macKeyboard[] = {0xB4, 0xE6, 0x2D, 0xB2, 0x1B, 0x36}; //{0x36, 0x33, 0x33, 0x33, 0x33, 0x33};
 
@@ -91,7 +117,17 @@ OperationMode SparkDataControl::init(OperationMode opModeInput) {
         bleKeyboard.begin();
         // delay(2000);
         bleKeyboard.end();
-        bleControl->initBLE(&bleNotificationCallback);
+#ifdef SIMULATE_AMP
+        transport = &SparkAmpSimulator::getInstance();
+#endif
+        transport->setReceiveCallback(&receiveData);
+        transport->setConnectionCallback(&transportConnectionChanged);
+#ifdef SIMULATE_AMP
+        SparkAmpSimulator::getInstance().setPresetSource(&simulatedHWPreset);
+        SparkAmpSimulator::getInstance().begin();
+#else
+        bleControl->initBLE();
+#endif
         DEBUG_PRINTLN("Starting regular check for empty HW presets.");
 
         xTaskCreatePinnedToCore(
@@ -105,6 +141,7 @@ OperationMode SparkDataControl::init(OperationMode opModeInput) {
         break;
     case SPARK_MODE_AMP:
         readBTModeFromFile();
+        transport->setReceiveCallback(&receiveData);
         if (currentBTMode_ == BT_MODE_BLE) {
             bleControl->startServer();
         } else if (currentBTMode_ == BT_MODE_SERIAL) {
@@ -226,9 +263,9 @@ void SparkDataControl::restartESP(bool resetSparkMode) {
     Serial.print("!!! Restarting !!! ");
     if (resetSparkMode) {
         Serial.print("Resetting Spark mode");
-        bool sparkModeFileExists = LittleFS.exists(sparkModeFileName.c_str());
+        bool sparkModeFileExists = SPARK_FS.exists(sparkModeFileName.c_str());
         if (sparkModeFileExists) {
-            LittleFS.remove(sparkModeFileName.c_str());
+            SPARK_FS.remove(sparkModeFileName.c_str());
         }
     }
     Serial.println();
@@ -238,11 +275,11 @@ void SparkDataControl::restartESP(bool resetSparkMode) {
 void SparkDataControl::readOpModeFromFile() {
     OperationMode sparkModeInput;
     Serial.println("Reading opmode file.");
-    if (!LittleFS.exists(sparkModeFileName.c_str())) {
+    if (!SPARK_FS.exists(sparkModeFileName.c_str())) {
         Serial.println("Spark mode config file does not exist.");
         return;
     }
-    File file = LittleFS.open(sparkModeFileName.c_str());
+    File file = SPARK_FS.open(sparkModeFileName.c_str());
     string line;
 
     if (!(file)) {
@@ -266,7 +303,7 @@ void SparkDataControl::readOpModeFromFile() {
 
 void SparkDataControl::readBTModeFromFile() {
     string line;
-    File file = LittleFS.open(btModeFileName.c_str());
+    File file = SPARK_FS.open(btModeFileName.c_str());
 
     while (file.available()) {
         line += file.read();
@@ -315,7 +352,7 @@ void SparkDataControl::resetStatus() {
     customPresetNumberChangePending = false;
     sparkAmpType = AMP_TYPE_40;
     sparkAmpName = "Spark 40";
-    withDelay = false;
+    bleControl->setWriteDelay(false);
     lastAmpBatteryUpdate = 0;
     SparkPresetControl::getInstance().resetStatus();
     SparkStatus::getInstance().resetStatus();
@@ -334,14 +371,14 @@ void SparkDataControl::setAmpParameters() {
         sparkMsg.maxBlockSizeToSpark() = 0xAD;
         sparkMsg.withHeader() = true;
         bleControl->setMaxBleMsgSize(0xAD);
-        withDelay = false;
+        bleControl->setWriteDelay(false);
     }
     if (ampName == AMP_NAME_SPARK_MINI || ampName == AMP_NAME_SPARK_2) { // || ampName == AMP_NAME_SPARK_NEO) {
         sparkMsg.maxChunkSizeToSpark() = 0x80;
         sparkMsg.maxBlockSizeToSpark() = 0xAD;
         sparkMsg.withHeader() = true;
         bleControl->setMaxBleMsgSize(0x64);
-        withDelay = true;
+        bleControl->setWriteDelay(true);
     }
     sparkMsg.maxChunkSizeFromSpark() = 0x19;
     sparkMsg.maxBlockSizeFromSpark() = 0x6A;
@@ -361,13 +398,37 @@ void SparkDataControl::readPresetChecksums() {
 
 void SparkDataControl::checkForUpdates() {
 
-    if (msgQueue.size() > 0) {
-        processSparkData(msgQueue.front());
-        msgQueue.pop();
+#ifdef SIMULATE_AMP
+    SparkAmpSimulator::getInstance().update();
+#endif
+    if (receiveBuffer.pop(receivedBlock)) {
+        SparkCapture::getInstance().record(CAPTURE_IN, receivedBlock);
+        processSparkData(receivedBlock);
     }
 
     SparkPresetControl::getInstance().checkForUpdates(operationMode_);
 
+    uint8_t tunerUpdateCount = statusObject.tunerUpdateCount();
+    if (tunerUpdateCount != lastTunerUpdateCount_) {
+        lastTunerUpdateCount_ = tunerUpdateCount;
+        // Amp seems to be in tuner mode
+        if (operationMode_ == SPARK_MODE_APP && subMode_ != SUB_MODE_TUNER) {
+            // Switch off tuner
+            switchTuner(false);
+        }
+    }
+#ifdef DEBUG
+    if (subMode_ == SUB_MODE_TUNER && millis() - lastTunerStatsTime_ >= 5000) {
+        if (tunerFrameCount_ > 0) {
+            DEBUG_PRINTF("Tuner: %lu updates in %lu ms, average decoding time %lu us\n",
+                         tunerFrameCount_, millis() - lastTunerStatsTime_, tunerDecodeTime_ / tunerFrameCount_);
+        }
+        tunerFrameCount_ = 0;
+        tunerDecodeTime_ = 0;
+        lastTunerStatsTime_ = millis();
+    }
+#endif
+
     if (recordStartFlag) {
         if (looperControl_.currentBar() != 0) {
             sparkLooperCommand(SPK_LOOPER_CMD_REC);
@@ -397,30 +458,6 @@ void SparkDataControl::checkForUpdates() {
     }
 #endif
 #endif
-
-    if (operationMode_ == SPARK_MODE_AMP) {
-
-        // Read incoming (serial) Bluetooth data, if available
-        while (bleControl && bleControl->byteAvailable()) {
-            byte inputByte = bleControl->readByte();
-            currentBTMsg.push_back(inputByte);
-            int msgSize = currentBTMsg.size();
-            if (msgSize > 0) {
-                if (currentBTMsg[msgSize - 1] == 0xF7) {
-                    // DEBUG_PRINTF("Free Heap size: %d\n", ESP.getFreeHeap()); DEBUG_PRINTF("Max free Heap block: %d\n",
-                    //		ESP.getMaxAllocHeap());
-
-                    DEBUG_PRINTLN("Received a message");
-                    DEBUG_PRINTVECTOR(currentBTMsg);
-                    DEBUG_PRINTLN();
-                    // heap_caps_check_integrity_all(true) ;
-                    processSparkData(currentBTMsg);
-
-                    currentBTMsg.clear();
-                }
-            }
-        }
-    }
 }
 
 void SparkDataControl::processSparkData(ByteVector &blk) {
@@ -441,6 +478,24 @@ void SparkDataControl::processSparkData(ByteVector &blk) {
     }
 
     handleIncomingAck();
+    handleCorruptedMessage();
+}
+
+void SparkDataControl::handleCorruptedMessage() {
+    AckData corrupted;
+    if (!sparkSsr.getCorruptedMessageAndEmpty(corrupted)) {
+        return;
+    }
+    // Responses are sent with the message number of the request. Other messages
+    // (e.g. notifications of the amp) can't be requested again and are lost.
+    if (operationMode_ != SPARK_MODE_APP || pendingRequest.cmd != 0x02
+        || corrupted.msgNum != pendingRequest.msgNum || requestRetries >= maxRequestRetries) {
+        LOG_ERROR("Corrupted message %02x %02x received, ignoring\n", corrupted.cmd, corrupted.subcmd);
+        return;
+    }
+    LOG_INFO("Corrupted response %02x %02x received, sending request again\n", corrupted.cmd, corrupted.subcmd);
+    requestRetries++;
+    sendMessageToBT(pendingRequest.data);
 }
 
 bool SparkDataControl::processAction() {
@@ -467,11 +522,13 @@ bool SparkDataControl::switchPreset(int pre, bool isInitial) {
 bool SparkDataControl::changeHWPreset(int preset) {
 
     currentMsg = sparkMsg.changeHardwarePreset(nextMessageNum, preset);
+    TRACE_HOP(TRACE_HOP_MESSAGE, 0x38);
     return triggerCommand(currentMsg);
 }
 
 bool SparkDataControl::changePreset(Preset preset) {
     currentMsg = sparkMsg.changePreset(preset, DIR_TO_SPARK, nextMessageNum);
+    TRACE_HOP(TRACE_HOP_MESSAGE, 0x01);
     if (triggerCommand(currentMsg)) {
         customPresetNumberChangePending = true;
         return true;
@@ -483,13 +540,14 @@ bool SparkDataControl::switchEffectOnOff(const string &fxName, bool enable) {
 
     SparkPresetControl::getInstance().switchFXOnOff(fxName, enable);
     currentMsg = sparkMsg.turnEffectOnOff(nextMessageNum, fxName, enable);
+    TRACE_HOP(TRACE_HOP_MESSAGE, 0x15);
 
     return triggerCommand(currentMsg);
 }
 
 bool SparkDataControl::toggleEffect(int fxIdentifier) {
 
-    Preset activePreset = SparkPresetControl::getInstance().activePreset();
+    const Preset &activePreset = SparkPresetControl::getInstance().activePreset();
     if (!processAction() || operationMode_ == SPARK_MODE_AMP) {
         Serial.println("Not connected to Spark Amp or in AMP mode, doing nothing.");
         return false;
@@ -497,10 +555,11 @@ bool SparkDataControl::toggleEffect(int fxIdentifier) {
     if (activePreset.isEmpty) {
         return false;
     }
-    string fxName = activePreset.pedals[fxIdentifier].name;
-    bool fxIsOn = activePreset.pedals[fxIdentifier].isOn;
+    TRACE_ACTION(TRACE_ACTION_FX_TOGGLE);
+    // Pedal index is the effect type, see FxType
+    const Pedal &pedal = activePreset.pedals[fxIdentifier];
 
-    return switchEffectOnOff(fxName, fxIsOn ? false : true);
+    return switchEffectOnOff(pedal.name, pedal.isOn ? false : true);
 }
 
 bool SparkDataControl::getAmpName() {
@@ -548,10 +607,12 @@ bool SparkDataControl::getCurrentPreset(int num) {
     return triggerCommand(currentMsg);
 }
 
-bool SparkDataControl::triggerCommand(vector<CmdData> &msg) {
+bool SparkDataControl::triggerCommand(const vector<CmdData> &msg) {
     nextMessageNum++;
     if (msg.size() > 0) {
-        currentCommand.assign(msg.begin(), msg.end());
+        // Copy assignment reuses the capacity of currentCommand
+        currentCommand = msg;
+        nextCommandBlock = 0;
     }
     // sparkSsr.clearMessageBuffer();
     DEBUG_PRINTLN("Sending message via BT.");
@@ -560,20 +621,25 @@ bool SparkDataControl::triggerCommand(vector<CmdData> &msg) {
 }
 
 bool SparkDataControl::sendNextRequest() {
-    if (currentCommand.size() > 0) {
-        CmdData request = currentCommand.front();
-        ByteVector firstBlock = request.data;
+    if (nextCommandBlock < currentCommand.size()) {
+        const CmdData &request = currentCommand[nextCommandBlock];
         AckData currRequest;
         currRequest.cmd = request.cmd;
         currRequest.subcmd = request.subcmd;
         currRequest.detail = request.detail;
         currRequest.msgNum = request.msgNum;
 
-        if (sendMessageToBT(firstBlock)) {
-            pendingLooperAcks.push_back(currRequest);
-            if (currentCommand.size() > 0) {
-                currentCommand.pop_front();
+        if (sendMessageToBT(request.data)) {
+            TRACE_HOP(TRACE_HOP_BLE_WRITE, request.subcmd);
+            // Only looper commands are matched with their ack, see handleIncomingAck()
+            if (request.subcmd == 0x75) {
+                pendingLooperAcks.push_back(currRequest);
+            }
+            if (request.cmd == 0x02) {
+                pendingRequest = request;
+                requestRetries = 0;
             }
+            nextCommandBlock++;
             return true;
         }
     }
@@ -599,15 +665,15 @@ void SparkDataControl::handleSendingAck(const ByteVector &blk) {
         if (operationMode_ == SPARK_MODE_APP) {
             triggerCommand(ackMsg);
         } else if (operationMode_ == SPARK_MODE_AMP) {
-            bleControl->notifyClients(ackMsg);
+            sendToApp(ackMsg);
         }
     }
 }
 
 void SparkDataControl::handleAmpModeRequest() {
 
-    vector<CmdData> msg;
-    vector<CmdData> currentMessage = sparkSsr.lastMessage();
+    vector<CmdData> &msg = responseMsg;
+    const vector<MessageData> &currentMessage = sparkSsr.lastMessage();
     byte currentMessageNum = statusObject.lastMessageNum();
     byte subCmd_ = currentMessage.back().subcmd;
     SparkPresetControl &presetControl = SparkPresetControl::getInstance();
@@ -682,13 +748,12 @@ void SparkDataControl::handleAmpModeRequest() {
         break;
     }
     if (sendMessage) {
-        bleControl->notifyClients(msg);
+        sendToApp(msg);
     }
 }
 
 void SparkDataControl::handleAppModeResponse() {
 
-    string msgStr = sparkSsr.getJson();
     MessageType lastMessageType = statusObject.lastMessageType();
     byte lastMessageNumber = statusObject.lastMessageNum();
     // DEBUG_PRINTF("Last message number: %s\n", SparkHelper::intToHex(lastMessageNumber).c_str());
@@ -751,8 +816,7 @@ void SparkDataControl::handleAppModeResponse() {
 
         if (lastMessageType == MSG_TYPE_FX_ONOFF) {
             DEBUG_PRINTLN("Last message was a effect change.");
-            Pedal receivedEffect = statusObject.currentEffect();
-            SparkPresetControl::getInstance().toggleFX(receivedEffect);
+            SparkPresetControl::getInstance().toggleFX(statusObject.currentEffect());
             printMessage = true;
         }
 
@@ -793,14 +857,7 @@ void SparkDataControl::handleAppModeResponse() {
             // looperControl_.setMeasure(currentMeasure);
         }
 
-        if (lastMessageType == MSG_TYPE_TUNER_OUTPUT) {
-            // Amp seems to be in tuner mode
-            if (subMode_ != SUB_MODE_TUNER) {
-                // Switch off tuner
-                switchTuner(false);
-            }
-            // operationMode_ = SUB_MODE_TUNER;
-        }
+        // Tuner output (MSG_TYPE_TUNER_OUTPUT) is handled in checkForUpdates()
 
         // TODO: Check if this works
         if (lastMessageType == MSG_TYPE_TUNER_ON) {
@@ -819,16 +876,22 @@ void SparkDataControl::handleAppModeResponse() {
             printMessage = true;
         }
 
-        if (msgStr.length() > 0 && printMessage) {
-            Serial.println("Message processed:");
-            Serial.println(msgStr.c_str());
+        // JSON is written to the log buffer directly, without building a string first
+        if (printMessage && LOG_ENABLED(LOG_LEVEL_INFO) && sparkSsr.hasJson()) {
+            LOG_INFO("Message processed:\n");
+            sparkSsr.writeJson(SPARK_LOG);
+            LOG_INFO("\n");
         }
     }
 
     if (operationMode_ == SPARK_MODE_AMP) {
         if (lastMessageType == MSG_TYPE_PRESET) {
-
-            SparkPresetControl::getInstance().updateFromSparkResponseAmpPreset(&msgStr[0]);
+            unsigned long startTime = micros();
+            // Hand over the decoded preset, no need to parse it from JSON again
+            SparkPresetControl::getInstance().updateFromSparkResponseAmpPreset(move(statusObject.currentPreset()));
+            statusObject.currentPreset() = {};
+            DEBUG_PRINTF("Preset from app taken over in %lu us (free heap: %d, min free heap: %d)\n",
+                         micros() - startTime, ESP.getFreeHeap(), ESP.getMinFreeHeap());
             statusObject.resetPresetUpdateFlag();
             statusObject.resetPresetNumberUpdateFlag();
         }
@@ -852,6 +915,7 @@ void SparkDataControl::handleIncomingAck() {
     }
     if (lastAck.cmd == 0x04) {
         DEBUG_PRINTLN("Received final ACK");
+        TRACE_ACK(lastAck.subcmd);
         if (lastAck.subcmd == 0x01) {
             // only execute preset number change on last ack for preset change
             if (customPresetNumberChangePending) {
@@ -886,7 +950,7 @@ void SparkDataControl::handleIncomingAck() {
                 }
             }
             updateLooperCommand(looperCommand);
-            Serial.println(looperControl_.getLooperStatus().c_str());
+            looperControl_.logLooperStatus();
         }
     }
 }
@@ -908,17 +972,23 @@ void SparkDataControl::startBLEServer() {
 }
 
 bool SparkDataControl::checkBLEConnection() {
-    if (bleControl->isAmpConnected()) {
+    if (isConnectionLost_) {
+        isConnectionLost_ = false;
+        receiveBuffer.clear();
+        resetStatus();
+    }
+    if (transport->isConnected()) {
         return true;
     }
     if (bleControl->isConnectionFound()) {
         if (bleControl->connectToServer()) {
-            bleControl->subscribeToNotifications(&bleNotificationCallback);
+            bleControl->subscribeToNotifications();
             Serial.println("BLE connection to Spark established.");
             // delay(2000);
             return true;
         } else {
             Serial.println("Failed to connect, starting scan");
+            resetStatus();
             bleControl->startScan();
             return false;
         }
@@ -938,9 +1008,9 @@ void SparkDataControl::toggleBTMode() {
             currentBTMode_ = BT_MODE_BLE;
         }
         // Save new mode to file
-        File file = LittleFS.open(btModeFileName.c_str(), FILE_WRITE);
+        File file = SPARK_FS.open(btModeFileName.c_str(), FILE_WRITE);
         file.print(currentBTMode_);
-        file = LittleFS.open(sparkModeFileName.c_str(), FILE_WRITE);
+        file = SPARK_FS.open(sparkModeFileName.c_str(), FILE_WRITE);
         file.print(SPARK_MODE_AMP);
         file.close();
         Serial.println("Restarting in new BT mode");
@@ -949,40 +1019,77 @@ void SparkDataControl::toggleBTMode() {
 }
 
 bool SparkDataControl::isAmpConnected() {
-    return bleControl->isAmpConnected();
+    return operationMode_ == SPARK_MODE_APP && transport->isConnected();
 }
 
 bool SparkDataControl::isAppConnected() {
     return bleControl->isAppConnected();
 }
 
-void SparkDataControl::bleNotificationCallback(
-    NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData,
-    size_t length, bool isNotify) {
+void SparkDataControl::receiveData(const uint8_t *data, size_t length) {
+
+    // Triggered by the transport when data is received from Spark Amp/App
+#ifdef DEBUG
+    unsigned long startTime = micros();
+#endif
+    // Tuner output is streamed continuously, so it is decoded right here
+    // instead of going through the receive buffer
+    byte note;
+    float offset;
+    if (SparkStreamReader::readTunerFrame(data, length, note, offset)) {
+        SparkStatus::getInstance().updateTuner(note, offset);
+#ifdef DEBUG
+        tunerDecodeTime_ += micros() - startTime;
+        tunerFrameCount_++;
+#endif
+        return;
+    }
+
+    // Add incoming data to the receive buffer for processing in the main loop
+    if (!receiveBuffer.push(data, length)) {
+        LOG_ERROR("Receive buffer full, dropped %d bytes\n", (int)length);
+    }
+}
+
+void SparkDataControl::processReplayedData(const uint8_t *data, size_t length) {
+    byte note;
+    float offset;
+    if (SparkStreamReader::readTunerFrame(data, length, note, offset)) {
+        SparkStatus::getInstance().updateTuner(note, offset);
+        return;
+    }
+    static ByteVector packet;
+    packet.assign(data, data + length);
+    processSparkData(packet);
+}
 
-    // Triggered when data is received from Spark Amp in APP mode
-    //  Transform data into ByteVetor and process
-    ByteVector chunk(&pData[0], &pData[length]);
-    // DEBUG_PRINT("Incoming block: ");
-    // DEBUG_PRINTVECTOR(chunk);
-    // DEBUG_PRINTLN();
-    //  DEBUG_PRINTF("Is notify: %s\n", isNotify ? "true" : "false");
-    //   Add incoming data to message queue for processing
-    msgQueue.push(chunk);
-    // DEBUG_PRINTF("Seding back data via notify.");
-    // vector<ByteVector> notifyVector = { chunk };
-    // bleControl->writeBLE(notifyVector, false, false);
+bool SparkDataControl::isTransportConnected() {
+    return transport != nullptr && transport->isConnected();
+}
+
+void SparkDataControl::transportConnectionChanged(bool isConnected) {
+    // Only the connection to the amp is handled here, in AMP mode the app reconnects on its own
+    if (operationMode_ != SPARK_MODE_APP) {
+        return;
+    }
+    if (isConnected) {
+        getAmpName();
+    } else {
+        isConnectionLost_ = true;
+    }
 }
 
-void SparkDataControl::queueMessage(ByteVector &blk) {
-    if (blk.size() > 0) {
-        msgQueue.push(blk);
+void SparkDataControl::sendToApp(const vector<CmdData> &msg) {
+    for (const CmdData &block : msg) {
+        SparkCapture::getInstance().record(CAPTURE_OUT, block.data.data(), block.data.size());
+        transport->send(block.data);
     }
 }
 
-bool SparkDataControl::sendMessageToBT(ByteVector &msg) {
+bool SparkDataControl::sendMessageToBT(const BlockData &msg) {
     DEBUG_PRINTLN("Sending message via BT.");
-    return bleControl->writeBLE(msg, withDelay);
+    SparkCapture::getInstance().record(CAPTURE_OUT, msg.data(), msg.size());
+    return transport->send(msg);
 }
 
 /////////////////////////////////////////////////////////
@@ -992,7 +1099,7 @@ bool SparkDataControl::sendMessageToBT(ByteVector &msg) {
 void SparkDataControl::sendButtonPressAsKeyboard(keyboardKeyDefinition k) {
     if (bleKeyboard.isConnected()) {
 
-        Serial.printf("Sending button: %d - mod: %d - repeat: %d\n", k.key, k.modifier, k.repeat);
+        LOG_INFO("Sending button: %d - mod: %d - repeat: %d\n", k.key, k.modifier, k.repeat);
         if (k.modifier != 0)
             bleKeyboard.press(k.modifier);
         for (uint8_t i = 0; i <= k.repeat; i++) {
@@ -1034,6 +1141,7 @@ Looper commands end */
 
 bool SparkDataControl::sparkLooperCommand(LooperCommand command) {
 
+    TRACE_ACTION(TRACE_ACTION_LOOPER);
     currentMsg = sparkMsg.sparkLooperCommand(nextMessageNum, command);
     DEBUG_PRINTF("Spark Looper: %02x\n", command);
 
@@ -1045,7 +1153,7 @@ void SparkDataControl::tapTempoButton() {
     int bpm;
     unsigned long now = millis();
     unsigned long diff = now - lastTapButtonPressed_;
-    DEBUG_PRINTF("Tap data: now = %u, lastTapButton = %u, diff = %u\n", now, lastTapButtonPressed_, diff);
+    DEBUG_PRINTF("Tap data: now = %lu, lastTapButton = %lu, diff = %lu\n", now, lastTapButtonPressed_, diff);
     lastTapButtonPressed_ = now;
 
     if (diff > tapButtonThreshold_) {
@@ -1069,6 +1177,7 @@ void SparkDataControl::tapTempoButton() {
 
 bool SparkDataControl::switchTuner(bool on) {
     DEBUG_PRINTF("Switching Tuner %s\n", on ? "on" : "off");
+    TRACE_ACTION(TRACE_ACTION_TUNER);
     currentMsg = sparkMsg.switchTuner(nextMessageNum, on);
     return triggerCommand(currentMsg);
 }
@@ -1136,7 +1245,7 @@ void SparkDataControl::updateLooperCommand(byte lastCommand) {
         DEBUG_PRINTLN("Unknown looper command received.");
         break;
     }
-    Serial.println(looperControl_.getLooperStatus().c_str());
+    looperControl_.logLooperStatus();
 }
 
 bool SparkDataControl::sparkLooperStopAll() {
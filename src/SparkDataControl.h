@@ -16,12 +16,16 @@
 #include "SparkLooperControl.h"
 
 #include <Arduino.h>
-#include <queue>
+#include <atomic>
 #include <stdexcept>
 #include <vector>
 
+#include "SparkAmpSimulator.h"
+#include "SparkCapture.h"
 #include "SparkDisplayControl.h"
+#include "SparkLatencyTrace.h"
 #include "SparkMessage.h"
+#include "SparkPacketBuffer.h"
 #include "SparkPresetBuilder.h"
 #include "SparkPresetControl.h"
 #include "SparkStreamReader.h"
@@ -35,6 +39,9 @@ class SparkBTControl;
 class SparkDisplayControl;
 
 class SparkDataControl {
+    // Soak test checks the sizes of the internal containers
+    friend class SparkSoakTest;
+
 public:
     SparkDataControl();
     virtual ~SparkDataControl();
@@ -48,13 +55,15 @@ public:
     void startBLEServer();
     // static void onScanEnded(NimBLEScanResults results);
 
-    // Callback function when Spark notifies about a changed characteristic
-    static void bleNotificationCallback(NimBLERemoteCharacteristic *pRemoteCharacteristic,
-                                        uint8_t *pData, size_t length, bool isNotify);
-
-    static void queueMessage(ByteVector &blk);
+    // Receive callback of the transport, called when data from Spark Amp/App arrives
+    static void receiveData(const uint8_t *data, size_t length);
+    // Connection callback of the transport
+    static void transportConnectionChanged(bool isConnected);
     // methods to process any data from Spark (process with SparkStreamReader and send ack if required)
     static void processSparkData(ByteVector &blk);
+    // Packet of a capture replay, processed like received data, but right away in the main loop
+    static void processReplayedData(const uint8_t *data, size_t length);
+    static bool isTransportConnected();
 
     // Check if a preset has been updated (via ack or from Spark)
     void checkForUpdates();
@@ -167,6 +176,8 @@ private:
     static OperationMode operationMode_;
 
     static SparkBTControl *bleControl;
+    // Connection used to talk to Spark Amp/App, usually bleControl
+    static SparkTransport *transport;
     static SparkStreamReader sparkSsr;
     static SparkStatus &statusObject;
     static SparkMessage sparkMsg;
@@ -193,6 +204,14 @@ private:
     static bool recordStartFlag;
 
     static bool ampNameReceived_;
+    // Last tuner update handled, see SparkStatus::tunerUpdateCount()
+    uint8_t lastTunerUpdateCount_ = 0;
+#ifdef DEBUG
+    // Statistics of the tuner fast path, written in the BLE callback
+    static unsigned long tunerFrameCount_;
+    static unsigned long tunerDecodeTime_;
+    unsigned long lastTunerStatsTime_ = 0;
+#endif
     const unsigned int updateAmpBatteryInterval = 60000; // Update battery status every minute
     unsigned int lastAmpBatteryUpdate = 0;               // When battery level was last updated
 
@@ -201,6 +220,8 @@ private:
     // Messages to send to Spark
     static vector<CmdData> currentMsg;
     static vector<CmdData> ackMsg;
+    // Response to a request of the app in AMP mode
+    static vector<CmdData> responseMsg;
     static bool customPresetNumberChangePending;
 
     // Spark AMP mode
@@ -208,10 +229,8 @@ private:
     static BTMode currentBTMode_;
     static OperationMode sparkModeAmp;
     static OperationMode sparkModeApp;
-    ByteVector currentBTMsg;
     static AmpType sparkAmpType;
     static string sparkAmpName;
-    static bool withDelay;
     static ByteVector checksums;
 
 #ifdef ENABLE_BATTERY_STATUS_INDICATOR
@@ -224,12 +243,25 @@ private:
     static byte specialMsgNum;
 
     static byte nextMessageNum;
-    static queue<ByteVector> msgQueue;
-    static deque<CmdData> currentCommand;
+    // Received data waiting to be processed, the block is reused for each packet
+    static SparkPacketBuffer receiveBuffer;
+    static ByteVector receivedBlock;
+    // Set when the connection to the amp is lost, status is reset in the main loop
+    static atomic<bool> isConnectionLost_;
+    // Blocks of the message currently sent, nextCommandBlock is the next one to send.
+    // Kept as vector so the capacity is reused for the next message.
+    static vector<CmdData> currentCommand;
+    static int nextCommandBlock;
     static deque<AckData> pendingLooperAcks;
-
-    static bool sendMessageToBT(ByteVector &msg);
-    static bool triggerCommand(vector<CmdData> &msg);
+    // Last request (cmd 02) sent to Spark, sent again if its response is corrupted
+    static CmdData pendingRequest;
+    static int requestRetries;
+    static const int maxRequestRetries = 1;
+
+    static bool sendMessageToBT(const BlockData &msg);
+    // Sends all blocks of a message to the Spark App (AMP mode)
+    static void sendToApp(const vector<CmdData> &msg);
+    static bool triggerCommand(const vector<CmdData> &msg);
     static bool sendNextRequest();
 
     // Retrieves the current preset from Spark (required for HW presets)
@@ -241,6 +273,7 @@ private:
     static void handleAmpModeRequest();
     static void handleAppModeResponse();
     static void handleIncomingAck();
+    static void handleCorruptedMessage();
 
     // Read in all HW presets
     void readOpModeFromFile();
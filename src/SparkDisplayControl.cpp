@@ -40,19 +40,19 @@ SparkDisplayControl::~SparkDisplayControl() {
 void SparkDisplayControl::init(int mode) {
 #if defined(OLED_DRIVER_SSD1306)
     // SSD1306_SWITCHCAPVCC = generate display voltage from 3.3V internally
-    if (!display_.begin(SSD1306_SWITCHCAPVCC, 0x3C)) { // 0x3C required for this display
+    if (!display_.begin(SSD1306_SWITCHCAPVCC, i2cAddress)) { // 0x3C required for this display
         Serial.println(F("SSD1306 initialization failed"));
         for (;;)
             ; // Loop forever
     }
 #elif defined(OLED_DRIVER_SH1106)
-    if (!display_.begin(0x3C, true)) { // 0x3C required for this display
+    if (!display_.begin(i2cAddress, true)) { // 0x3C required for this display
         Serial.println(F("SH1106 initialization failed"));
         for (;;)
             ; // Loop forever
     }
 #elif defined(OLED_DRIVER_SH1107)
-    if (!display_.begin(0x3C, true)) { // 0x3C required for this display
+    if (!display_.begin(i2cAddress, true)) { // 0x3C required for this display
         Serial.println(F("SH1107 initialization failed"));
         for (;;)
             ; // Loop forever
@@ -105,41 +105,30 @@ void SparkDisplayControl::showBankAndPresetNum() {
     SparkPresetControl &presetControl = SparkPresetControl::getInstance();
     int pendingBank = presetControl.pendingBank();
 
-    // Configure numbers as strings
-    ostringstream selBankStr;
-    selBankStr << pendingBank;
-
-    ostringstream selPresetStr;
-    selPresetStr << presetControl.activePresetNum();
-
     // Bank number display
-    string bankDisplay = "";
-    if (pendingBank < 10) {
-        bankDisplay = "0";
-    }
-    bankDisplay += selBankStr.str();
+    char bankDisplay[8];
     if (pendingBank == 0) {
         if (presetControl.numberOfHWBanks() == 1) {
-            bankDisplay = "HW";
+            snprintf(bankDisplay, sizeof(bankDisplay), "HW");
         } else {
-            bankDisplay = "H" + to_string(presetControl.pendingHWBank() + 1);
+            snprintf(bankDisplay, sizeof(bankDisplay), "H%d", presetControl.pendingHWBank() + 1);
         }
+    } else {
+        snprintf(bankDisplay, sizeof(bankDisplay), "%02d", pendingBank);
     }
 
     display_.setCursor(0, 0);
-    display_.print(bankDisplay.c_str());
+    display_.print(bankDisplay);
 
     // Preset display
     display_.setCursor(display_.width() - 24, 0);
-    string presetText = "";
-    presetText = selPresetStr.str();
-    display_.print(presetText.c_str());
+    display_.print(presetControl.activePresetNum());
 }
 
 void SparkDisplayControl::showPresetName() {
 
     SparkPresetControl &presetControl = SparkPresetControl::getInstance();
-    const string msg = presetControl.responseMsg();
+    const string &msg = presetControl.responseMsg();
     int pendingBank = presetControl.pendingBank();
     int activeBank = presetControl.activeBank();
     int pendingHWBank = presetControl.pendingHWBank();
@@ -165,13 +154,14 @@ void SparkDisplayControl::showPresetName() {
     display_.setTextSize(2);
     unsigned long currentMillis = millis();
 
-    if (msg != "") { // message to show for some time
+    if (!msg.empty()) { // message to show for some time
         previousMillis = millis();
         primaryLineText = msg;
         presetControl.resetPresetEditResponse();
         showMsgFlag = true;
     }
     if (showMsgFlag) {
+        isAnimated_ = true;
         display_.setCursor(0, 32);
         if (currentMillis - previousMillis >= showMessageInterval) {
             // reset the show message flag to show preset data again
@@ -182,11 +172,11 @@ void SparkDisplayControl::showPresetName() {
         // If bank is not HW preset bank and the currently selected bank
         // is not the active one, show the pending preset name
         if (activeBank != pendingBank || activeHWBank != pendingHWBank) {
-            primaryLinePreset = presetControl.pendingPreset();
+            primaryLinePreset = &presetControl.pendingPreset();
         } else {
-            primaryLinePreset = presetControl.activePreset();
+            primaryLinePreset = &presetControl.activePreset();
         }
-        primaryLineText = primaryLinePreset.name;
+        primaryLineText = primaryLinePreset->name;
 
         // Reset scroll timer
         if (primaryLineText != previousText1_) {
@@ -196,8 +186,10 @@ void SparkDisplayControl::showPresetName() {
         }
         // double the preset text for scrolling if longer than threshold
         //  if text is too long and will be scrolled, double to "wrap around"
+        // Appending in place reuses the capacity of primaryLineText
         if (primaryLineText.length() > textScrollLimit_) {
-            primaryLineText = primaryLineText + textFiller_ + primaryLineText;
+            primaryLineText += textFiller_;
+            primaryLineText += primaryLinePreset->name;
         }
     }
     display_.print(primaryLineText.c_str());
@@ -209,7 +201,7 @@ void SparkDisplayControl::showFX_SecondaryName() {
 
     OperationMode opMode = sparkDC_->operationMode();
     SparkPresetControl &presetControl = SparkPresetControl::getInstance();
-    Preset presetFromApp = presetControl.appReceivedPreset();
+    const Preset &presetFromApp = presetControl.appReceivedPreset();
 
     secondaryLineText = "";
     if (opMode == SPARK_MODE_AMP) {
@@ -229,7 +221,8 @@ void SparkDisplayControl::showFX_SecondaryName() {
         }
         // if text is too long and will be scrolled, double to "wrap around"
         if (secondaryLineText.length() > textScrollLimit_) {
-            secondaryLineText = secondaryLineText + textFiller_ + secondaryLineText;
+            secondaryLineText += textFiller_;
+            secondaryLineText += presetFromApp.name;
         }
     } else if (opMode == SPARK_MODE_APP) {
 
@@ -239,24 +232,19 @@ void SparkDisplayControl::showFX_SecondaryName() {
         secondaryLinePreset = primaryLinePreset;
 
         // When we switched to FX mode, we always show the current selected preset
-        if (subMode == SUB_MODE_FX) {
-            secondaryLinePreset = presetControl.activePreset();
+        if (subMode == SUB_MODE_FX || secondaryLinePreset == nullptr) {
+            secondaryLinePreset = &presetControl.activePreset();
         }
 
-        if (!(secondaryLinePreset.isEmpty) || presetControl.pendingBank() > 0) {
+        if (!(secondaryLinePreset->isEmpty) || presetControl.pendingBank() > 0) {
             // Iterate through the corresponding preset's pedals and show indicators if switched on
+            // blank placeholder for Amp
+            static const char *fxIndicatorsOn[] = {"N", "C ", "D ", " ", "M ", "D ", "R"};
+            static const char *fxIndicatorsOff[] = {" ", "  ", "  ", " ", "  ", "  ", " "};
             for (int i = 0; i < 7; i++) { // 7 pedals, amp to be ignored
                 if (i != 3) {             // Amp is on position 3, ignore
-                    // blank placeholder for Amp
-                    string fxIndicatorsOn[] =
-                        {"N", "C ", "D ", " ", "M ", "D ", "R"};
-                    string fxIndicatorsOff[] = {" ", "  ", "  ", " ", "  ", "  ", " "};
-
-                    string currPedalStatus;
-                    Pedal currPedal = secondaryLinePreset.pedals[i];
-                    currPedalStatus =
-                        currPedal.isOn ? fxIndicatorsOn[i] : fxIndicatorsOff[i];
-                    secondaryLineText += currPedalStatus;
+                    const Pedal &currPedal = secondaryLinePreset->pedals[i];
+                    secondaryLineText += currPedal.isOn ? fxIndicatorsOn[i] : fxIndicatorsOff[i];
                 }
             }
         } else {
@@ -441,6 +429,7 @@ void SparkDisplayControl::showBatterySymbol() {
     switch (batteryLevel) {
     case BATTERY_LEVEL_CHARGING:
         battery_icon = rotateBatteryIcons();
+        isAnimated_ = true;
         break;
     case BATTERY_LEVEL_0:
         battery_icon = epdBitmapBatteryLevel0;
@@ -682,7 +671,9 @@ void SparkDisplayControl::showVolumeBar() {
     display_.setTextSize(2);
     int volumeNumberYPos = (display_.height() - barHeight) / 2 - 20;
     int volumeNumber = (int)(volume * 100); // Convert to percentage
-    drawCentreString(to_string(volumeNumber).c_str(), volumeNumberYPos);
+    char volumeText[8];
+    snprintf(volumeText, sizeof(volumeText), "%d", volumeNumber);
+    drawCentreString(volumeText, volumeNumberYPos);
 }
 
 void SparkDisplayControl::checkInvertDisplay(int subMode) {
@@ -698,13 +689,34 @@ void SparkDisplayControl::checkInvertDisplay(int subMode) {
         break;
     }
 
-    display_.invertDisplay(invertedDisplay);
+    // Sent only on change, it is a command to the display and not part of the frame
+    if (invertedDisplay != isInvertedOnDisplay_ || !isFlushedFrameValid_) {
+        display_.invertDisplay(invertedDisplay);
+        isInvertedOnDisplay_ = invertedDisplay;
+        i2cBytes_ += 2;
+    }
 }
 
 void SparkDisplayControl::update(bool isInitBoot) {
 
     OperationMode opMode = sparkDC_->operationMode();
     SubMode subMode = sparkDC_->subMode();
+
+#ifdef DEBUG
+    if (millis() - statsTimestamp_ >= statsInterval) {
+        reportStats();
+    }
+#endif
+    // Nothing to render if the state shown has not changed,
+    // e.g. the tuner is only redrawn when a new tuner value was received
+    uint32_t currentStateHash = stateHash(isInitBoot);
+    if (!isAnimated_ && currentStateHash == lastStateHash_ && isFlushedFrameValid_) {
+        skippedFrames_++;
+        return;
+    }
+    lastStateHash_ = currentStateHash;
+    isAnimated_ = false;
+
     display_.clearDisplay();
     checkInvertDisplay(subMode);
 
@@ -718,6 +730,10 @@ void SparkDisplayControl::update(bool isInitBoot) {
         lastKeyboardButtonPressedString = sparkDC_->lastKeyboardButtonPressedString();
         showPressedKey();
         showKeyboardLayout();
+        // Pressed key is shown for some time
+        if (showKeyboardPressedFlag) {
+            isAnimated_ = true;
+        }
     } else if (subMode == SUB_MODE_TUNER) {
         SparkStatus &statusObject = SparkStatus::getInstance();
         currentNote = statusObject.noteString();
@@ -738,6 +754,7 @@ void SparkDisplayControl::update(bool isInitBoot) {
         unsigned int now = millis();
         if (now - volumeChangedTimestamp <= showVolumeChangedInterval) {
             showVolumeBar();
+            isAnimated_ = true;
         } else {
             display_.setTextWrap(false);
             showConnection();
@@ -755,10 +772,179 @@ void SparkDisplayControl::update(bool isInitBoot) {
                 showBankAndPresetNum();
                 showFX_SecondaryName();
             }
+            // Long names are scrolled
+            if (primaryLineText.length() > textScrollLimit_
+                || (opMode == SPARK_MODE_AMP && secondaryLineText.length() > textScrollLimit_)) {
+                isAnimated_ = true;
+            }
         }
     }
     // logDisplay();
+    renderedFrames_++;
+    flushChangedPages();
+}
+
+void SparkDisplayControl::invalidate() {
+    isFlushedFrameValid_ = false;
+}
+
+uint32_t SparkDisplayControl::stateHash(bool isInitBoot) {
+    SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+    SparkStatus &statusObject = SparkStatus::getInstance();
+    SparkLooperControl &looperControl = sparkDC_->looperControl();
+    OperationMode opMode = sparkDC_->operationMode();
+
+    const int32_t values[] = {
+        isInitBoot,
+        opMode,
+        sparkDC_->subMode(),
+        sparkDC_->currentBTMode(),
+        sparkDC_->isAmpConnected() || sparkDC_->isAppConnected(),
+        presetControl.activeBank(),
+        presetControl.pendingBank(),
+        presetControl.activeHWBank(),
+        presetControl.pendingHWBank(),
+        presetControl.numberOfHWBanks(),
+        presetControl.activePresetNum(),
+        presetControl.presetEditMode(),
+        !presetControl.responseMsg().empty(),
+        looperControl.currentBar(),
+        looperControl.currentBeat(),
+        looperControl.totalBars(),
+        looperControl.bpm(),
+        statusObject.tunerUpdateCount(),
+        statusObject.isVolumeChanged(),
+        sparkDC_->keyboardChanged(),
+#ifdef ENABLE_BATTERY_STATUS_INDICATOR
+        sparkDC_->batteryLevel(),
+        statusObject.ampBatteryChargingStatus(),
+#endif
+    };
+    uint32_t hash = hashBytes(values, sizeof(values));
+    hash = hashPreset(presetControl.activePreset(), hash);
+    hash = hashPreset(presetControl.pendingPreset(), hash);
+    hash = hashPreset(presetControl.appReceivedPreset(), hash);
+    if (opMode == SPARK_MODE_KEYBOARD) {
+        string keyPressed = sparkDC_->lastKeyboardButtonPressedString();
+        hash = hashBytes(keyPressed.data(), keyPressed.size(), hash);
+    }
+    return hash;
+}
+
+uint32_t SparkDisplayControl::hashBytes(const void *data, size_t size, uint32_t hash) {
+    // FNV-1a hash
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t SparkDisplayControl::hashPreset(const Preset &preset, uint32_t hash) {
+    // Name and FX indicators are shown
+    hash = hashBytes(&preset.isEmpty, sizeof(preset.isEmpty), hash);
+    hash = hashBytes(preset.name.data(), preset.name.size(), hash);
+    for (int i = 0; i < preset.pedals.size(); i++) {
+        hash = hashBytes(&preset.pedals[i].isOn, sizeof(preset.pedals[i].isOn), hash);
+    }
+    return hash;
+}
+
+void SparkDisplayControl::flushChangedPages() {
+    const uint8_t *frame = display_.getBuffer();
+    bool isPageChanged[framePages];
+    bool isFrameChanged = false;
+    for (int page = 0; page < framePages; page++) {
+        isPageChanged[page] = !isFlushedFrameValid_
+                              || memcmp(frame + page * framePageSize, flushedFrame_ + page * framePageSize, framePageSize) != 0;
+        isFrameChanged |= isPageChanged[page];
+    }
+    if (!isFrameChanged) {
+        return;
+    }
+
+#if defined(OLED_DRIVER_SSD1306)
+    // Consecutive changed pages are sent in one go
+    int page = 0;
+    while (page < framePages) {
+        if (!isPageChanged[page]) {
+            page++;
+            continue;
+        }
+        int lastPage = page;
+        while (lastPage + 1 < framePages && isPageChanged[lastPage + 1]) {
+            lastPage++;
+        }
+        flushPages(page, lastPage);
+        page = lastPage + 1;
+    }
+#else
+    // Page addressing differs between the SH110x variants, the driver sends the full frame
     display_.display();
+    for (int page = 0; page < framePages; page++) {
+        isPageChanged[page] = true;
+    }
+    // Page address and column commands per page
+    i2cBytes_ += i2cDataBytes(framePages * framePageSize) + framePages * 3 * 2;
+#endif
+    for (int page = 0; page < framePages; page++) {
+        if (isPageChanged[page]) {
+            flushedPages_++;
+        }
+    }
+    memcpy(flushedFrame_, frame, sizeof(flushedFrame_));
+    isFlushedFrameValid_ = true;
+    flushedFrames_++;
+}
+
+void SparkDisplayControl::flushPages(int firstPage, int lastPage) {
+#if defined(OLED_DRIVER_SSD1306)
+    // Same as Adafruit_SSD1306::display() for a range of pages (horizontal addressing mode)
+    display_.ssd1306_command(SSD1306_PAGEADDR);
+    display_.ssd1306_command(firstPage);
+    display_.ssd1306_command(lastPage);
+    display_.ssd1306_command(SSD1306_COLUMNADDR);
+    display_.ssd1306_command(0);
+    display_.ssd1306_command(framePageSize - 1);
+    // Control byte and command per command
+    i2cBytes_ += 6 * 2;
+
+    const uint8_t *data = display_.getBuffer() + firstPage * framePageSize;
+    size_t count = (lastPage - firstPage + 1) * framePageSize;
+    i2cBytes_ += i2cDataBytes(count);
+    Wire.setClock(i2cClockDuringFlush);
+    while (count > 0) {
+        size_t transferSize = min(count, (size_t)(i2cTransferSize - 1));
+        Wire.beginTransmission(i2cAddress);
+        Wire.write((uint8_t)0x40); // Co = 0, D/C = 1: data follows
+        Wire.write(data, transferSize);
+        Wire.endTransmission();
+        data += transferSize;
+        count -= transferSize;
+    }
+    Wire.setClock(i2cClockAfterFlush);
+#endif
+}
+
+size_t SparkDisplayControl::i2cDataBytes(size_t count) {
+    return count + (count + i2cTransferSize - 2) / (i2cTransferSize - 1);
+}
+
+void SparkDisplayControl::reportStats() {
+    unsigned long now = millis();
+    unsigned long elapsed = now - statsTimestamp_;
+    if (elapsed > 0) {
+        Serial.printf("Display: %.1f fps, %.1f renders/s, %lu updates skipped, %lu pages flushed, %lu I2C bytes/s\n",
+                      flushedFrames_ * 1000.0 / elapsed, renderedFrames_ * 1000.0 / elapsed, skippedFrames_,
+                      flushedPages_, (unsigned long)(i2cBytes_ * 1000ULL / elapsed));
+    }
+    renderedFrames_ = 0;
+    skippedFrames_ = 0;
+    flushedFrames_ = 0;
+    flushedPages_ = 0;
+    i2cBytes_ = 0;
+    statsTimestamp_ = now;
 }
 
 void SparkDisplayControl::updateTextPositions() {
@@ -31,6 +31,19 @@ class SparkDataControl;
 class SparkLooperControl;
 
 class SparkDisplayControl {
+    // Display of the Ignitron
+    // -----------------------
+    // The screen is only rendered when the state it shows has changed (hash of the
+    // values shown by the widgets: bank, preset name, FX line, battery, BT icon, looper
+    // timer, ...) or when something on it changes over time (scrolling text, messages).
+    // The rendered frame is compared page by page (8 rows of pixels) with the last frame
+    // sent, only changed pages are sent over I2C. SH110x displays get the full frame if
+    // anything changed. Frames per second and I2C bytes per second are printed with
+    // command 'o' on Serial and every statsInterval in DEBUG.
+
+    // Benchmarks measure the display flush separately
+    friend class SparkBenchmark;
+
 public:
     SparkDisplayControl();
     SparkDisplayControl(SparkDataControl *dc);
@@ -40,6 +53,10 @@ public:
     void setDataControl(SparkDataControl *dc) {
         sparkDC_ = dc;
     }
+    // Next update renders and sends the full frame
+    void invalidate();
+    // Prints frame and I2C statistics since the last report
+    void reportStats();
 
 private:
     // OLED Screen config
@@ -62,9 +79,10 @@ private:
     SparkDataControl *sparkDC_;
 
     string primaryLineText;
-    Preset primaryLinePreset;
+    // Point to presets of SparkPresetControl, so no copy is needed on each update
+    const Preset *primaryLinePreset = nullptr;
     string secondaryLineText;
-    Preset secondaryLinePreset;
+    const Preset *secondaryLinePreset = nullptr;
     string currentBTModeText;
 
     string lowerButtonsShort;
@@ -111,6 +129,40 @@ private:
     string currentNote = "  ";
     int noteOffsetCents = 0;
 
+    // Dirty tracking, 128x64 pixels are 8 pages of 128 bytes
+    static const int framePages = 8;
+    static const int framePageSize = 128;
+    static const uint8_t i2cAddress = 0x3C;
+    // Same I2C settings as the Adafruit drivers use for display()
+    static const int i2cTransferSize = 32;
+    static const uint32_t i2cClockDuringFlush = 400000;
+    static const uint32_t i2cClockAfterFlush = 100000;
+    // Frame as sent to the display, only valid after the first flush
+    uint8_t flushedFrame_[framePages * framePageSize];
+    bool isFlushedFrameValid_ = false;
+    bool isInvertedOnDisplay_ = false;
+    uint32_t lastStateHash_ = 0;
+    // Set while rendering if the frame changes over time without a change of the state
+    bool isAnimated_ = true;
+
+    unsigned long renderedFrames_ = 0;
+    unsigned long skippedFrames_ = 0;
+    unsigned long flushedFrames_ = 0;
+    unsigned long flushedPages_ = 0;
+    unsigned long i2cBytes_ = 0;
+    unsigned long statsTimestamp_ = 0;
+    const unsigned long statsInterval = 10000;
+
+    // Hash of everything shown on the screen which is not animated
+    uint32_t stateHash(bool isInitBoot);
+    static uint32_t hashBytes(const void *data, size_t size, uint32_t hash = 2166136261u);
+    static uint32_t hashPreset(const Preset &preset, uint32_t hash);
+    // Sends the pages of the frame buffer which differ from the last frame sent
+    void flushChangedPages();
+    void flushPages(int firstPage, int lastPage);
+    // Bytes sent for count data bytes, including the control byte of each transfer
+    static size_t i2cDataBytes(size_t count);
+
     void showInitialMessage();
     void showConnection();
 
@@ -0,0 +1,91 @@
+/*
+ * SparkEffectCatalog.h
+ *
+ * Generated by build_effectcatalog.py from reference/EffectReference.csv.
+ * Do not edit manually, run the script again when the reference changes.
+ */
+
+#ifndef SPARK_EFFECT_CATALOG_H
+#define SPARK_EFFECT_CATALOG_H
+
+#include "SparkEffects.h"
+
+// Number of effects known from the reference, IDs 1 to NUMBER_OF_KNOWN_EFFECTS
+constexpr int NUMBER_OF_KNOWN_EFFECTS = 68;
+// Highest number of parameters of a known effect, see MAX_PEDAL_PARAMETERS
+constexpr int MAX_KNOWN_EFFECT_PARAMETERS = 8;
+
+// Known effects, sorted by technical name to allow binary search.
+// Index + 1 is the effect ID, 0 is used for no effect.
+constexpr SparkEffectInfo KNOWN_EFFECTS[NUMBER_OF_KNOWN_EFFECTS] = {
+    {"6505Plus", "Insane 6508", INDEX_FX_AMP, 5},
+    {"94MatchDCV2", "Match DC", INDEX_FX_AMP, 5},
+    {"AC Boost", "AC Boost", INDEX_FX_AMP, 5},
+    {"ADClean", "AD Clean", INDEX_FX_AMP, 5},
+    {"Acoustic", "Pure Acoustic", INDEX_FX_AMP, 5},
+    {"AcousticAmpV2", "Fishboy", INDEX_FX_AMP, 5},
+    {"AmericanHighGain", "American High Gain", INDEX_FX_AMP, 5},
+    {"BBEOpticalComp", "Optical Comp", INDEX_FX_COMP, 3},
+    {"BE101", "BE 101", INDEX_FX_AMP, 5},
+    {"BassBigMuff", "Bass Muff", INDEX_FX_DRIVE, 3},
+    {"BassComp", "Bass Comp", INDEX_FX_COMP, 2},
+    {"BassEQ6", "Bass EQ", INDEX_FX_MOD, 7},
+    {"Bassman", "Tweed Bass", INDEX_FX_AMP, 5},
+    {"BlueComp", "Sustain Comp", INDEX_FX_COMP, 4},
+    {"BluesJrTweed", "Blues Boy", INDEX_FX_AMP, 5},
+    {"Bogner", "RB 101", INDEX_FX_AMP, 5},
+    {"Booster", "Booster", INDEX_FX_DRIVE, 1},
+    {"Checkmate", "Checkmate", INDEX_FX_AMP, 5},
+    {"ChorusAnalog", "Chorus", INDEX_FX_MOD, 4},
+    {"Cloner", "Cloner Chorus", INDEX_FX_MOD, 2},
+    {"Compressor", "Red Comp", INDEX_FX_COMP, 2},
+    {"DelayEchoFilt", "Echo Filt", INDEX_FX_DELAY, 5},
+    {"DelayMono", "Digital Delay", INDEX_FX_DELAY, 5},
+    {"DelayMultiHead", "Multi Head", INDEX_FX_DELAY, 5},
+    {"DelayRe201", "Echo Tape", INDEX_FX_DELAY, 5},
+    {"DelayReverse", "Reverse Delay", INDEX_FX_DELAY, 5},
+    {"Deluxe65", "American Deluxe", INDEX_FX_AMP, 5},
+    {"DistortionTS9", "Tube Drive", INDEX_FX_DRIVE, 4},
+    {"EVH", "Insane", INDEX_FX_AMP, 5},
+    {"FatAcousticV2", "Jumbo", INDEX_FX_AMP, 5},
+    {"Flanger", "Flanger", INDEX_FX_MOD, 3},
+    {"FlatAcoustic", "Flat Acoustic", INDEX_FX_AMP, 5},
+    {"Fuzz", "Fuzz Face", INDEX_FX_DRIVE, 2},
+    {"GK800", "RB-800", INDEX_FX_AMP, 5},
+    {"GuitarEQ6", "Guitar EQ", INDEX_FX_MOD, 7},
+    {"GuitarMuff", "Guitar Muff", INDEX_FX_DRIVE, 3},
+    {"Hammer500", "Hammer 500", INDEX_FX_AMP, 5},
+    {"Invader", "Rocker V", INDEX_FX_AMP, 5},
+    {"KlonCentaurSilver", "Clone Drive", INDEX_FX_DRIVE, 3},
+    {"LA2AComp", "LA Comp", INDEX_FX_COMP, 3},
+    {"MaestroBassmaster", "Bassmaster", INDEX_FX_DRIVE, 3},
+    {"MiniVibe", "Classic Vibe", INDEX_FX_MOD, 2},
+    {"ODS50CN", "ODS 50", INDEX_FX_AMP, 5},
+    {"OrangeAD30", "British 30", INDEX_FX_AMP, 5},
+    {"OverDrivenJM45", "JM45", INDEX_FX_AMP, 5},
+    {"OverDrivenLuxVerb", "Lux Verb", INDEX_FX_AMP, 5},
+    {"Overdrive", "Over Drive", INDEX_FX_DRIVE, 3},
+    {"Phaser", "Phaser", INDEX_FX_MOD, 4},
+    {"Plexi", "Plexiglas", INDEX_FX_AMP, 5},
+    {"ProCoRat", "Black Op", INDEX_FX_DRIVE, 3},
+    {"Rectifier", "Treadplate", INDEX_FX_AMP, 5},
+    {"RolandJC120", "Silver 120", INDEX_FX_AMP, 5},
+    {"SABDriver", "SAB Driver", INDEX_FX_DRIVE, 4},
+    {"SLO100", "SLO 100", INDEX_FX_AMP, 5},
+    {"Sunny3000", "Sunny 3000", INDEX_FX_AMP, 5},
+    {"SwitchAxeLead", "SwitchAxe", INDEX_FX_AMP, 5},
+    {"Tremolator", "Tremolator", INDEX_FX_MOD, 3},
+    {"Tremolo", "Tremolo", INDEX_FX_MOD, 3},
+    {"TremoloSquare", "Tremolo Square", INDEX_FX_MOD, 3},
+    {"Twin", "Black Duo", INDEX_FX_AMP, 5},
+    {"TwoStoneSP50", "Two Stone SP50", INDEX_FX_AMP, 5},
+    {"UniVibe", "UniVibe", INDEX_FX_MOD, 3},
+    {"Vibrato01", "Vibrato", INDEX_FX_MOD, 2},
+    {"VintageDelay", "Vintage Delay", INDEX_FX_DELAY, 4},
+    {"W600", "W600", INDEX_FX_AMP, 5},
+    {"YJM100", "YJM100", INDEX_FX_AMP, 5},
+    {"bias.noisegate", "Noise Gate", INDEX_FX_NOISEGATE, 3},
+    {"bias.reverb", "Reverb", INDEX_FX_REVERB, 8},
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * SparkEffects.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkEffects.h"
+#include "SparkEffectCatalog.h"
+
+#include <cstring>
+
+const uint16_t SparkEffects::noEffect;
+const uint16_t SparkEffects::unknownEffect;
+const int SparkEffects::maxUnknownEffects;
+
+deque<string> &SparkEffects::names() {
+    // deque keeps references to existing names valid when adding new ones
+    static deque<string> names_;
+    if (names_.empty()) {
+        names_.push_back("");
+        for (int i = 0; i < NUMBER_OF_KNOWN_EFFECTS; i++) {
+            names_.push_back(KNOWN_EFFECTS[i].name);
+        }
+    }
+    return names_;
+}
+
+uint16_t SparkEffects::intern(const string &name) {
+    if (name.empty()) {
+        return noEffect;
+    }
+    // Known effects are sorted by name
+    int low = 0;
+    int high = NUMBER_OF_KNOWN_EFFECTS - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        int cmp = strcmp(name.c_str(), KNOWN_EFFECTS[mid].name);
+        if (cmp == 0) {
+            return mid + 1;
+        }
+        if (cmp < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    deque<string> &table = names();
+    for (int id = NUMBER_OF_KNOWN_EFFECTS + 1; id < (int)table.size(); id++) {
+        if (table[id] == name) {
+            return id;
+        }
+    }
+    if (table.size() > NUMBER_OF_KNOWN_EFFECTS + maxUnknownEffects) {
+        // Reported once, a corrupted stream can produce a new name per message
+        static bool isFullReported = false;
+        if (!isFullReported) {
+            LOG_ERROR("ERROR: Too many unknown effects, %s and later ones are not added\n", name.c_str());
+            isFullReported = true;
+        }
+        return unknownEffect;
+    }
+    table.push_back(name);
+    return table.size() - 1;
+}
+
+bool SparkEffects::isKnown(uint16_t id) {
+    return id != noEffect && id <= NUMBER_OF_KNOWN_EFFECTS;
+}
+
+const string &SparkEffects::name(uint16_t id) {
+    static const string unknownName = "unknown";
+    if (id == unknownEffect) {
+        return unknownName;
+    }
+    deque<string> &table = names();
+    if (id >= table.size()) {
+        return table[noEffect];
+    }
+    return table[id];
+}
+
+const SparkEffectInfo *SparkEffects::info(uint16_t id) {
+    if (!isKnown(id)) {
+        return nullptr;
+    }
+    return &KNOWN_EFFECTS[id - 1];
+}
+
+FxType SparkEffects::fxType(uint16_t id) {
+    const SparkEffectInfo *effectInfo = info(id);
+    return effectInfo ? effectInfo->fxType : INDEX_FX_INVALID;
+}
+
+int SparkEffects::numParameters(uint16_t id) {
+    const SparkEffectInfo *effectInfo = info(id);
+    return effectInfo ? effectInfo->numParameters : -1;
+}
@@ -0,0 +1,59 @@
+/*
+ * SparkEffects.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_EFFECTS_H
+#define SPARK_EFFECTS_H
+
+#include "Config_Definitions.h"
+#include <deque>
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+// Entry of the generated effect catalog (SparkEffectCatalog.h)
+struct SparkEffectInfo {
+    // Technical name as used in messages and preset files
+    const char *name;
+    // Name as shown in the Spark app
+    const char *appName;
+    // Position of the effect in a preset
+    FxType fxType;
+    uint8_t numParameters;
+};
+
+class SparkEffects {
+    // Interned effect names
+    // ---------------------
+    // Effect names are stored as IDs. IDs 1 to NUMBER_OF_KNOWN_EFFECTS refer to the
+    // generated effect catalog, names not in the catalog get the next free ID at runtime.
+    // IDs are not persisted, presets are always stored with the effect names.
+    // At most maxUnknownEffects names are added at runtime (the table is never shrunk),
+    // further names, e.g. from corrupted messages, all get the ID unknownEffect.
+
+public:
+    static const uint16_t noEffect = 0;
+    static const uint16_t unknownEffect = 0xFFFF;
+    static const int maxUnknownEffects = 64;
+
+    // Returns the ID of an effect name, unknown names are added to the table while there is space
+    static uint16_t intern(const string &name);
+    static const string &name(uint16_t id);
+    // True if the effect is part of the effect catalog
+    static bool isKnown(uint16_t id);
+    // Catalog entry of the effect, nullptr for unknown effects
+    static const SparkEffectInfo *info(uint16_t id);
+    // Position of the effect in a preset, INDEX_FX_INVALID for unknown effects
+    static FxType fxType(uint16_t id);
+    // Number of parameters from the catalog, -1 for unknown effects
+    static int numParameters(uint16_t id);
+
+private:
+    static deque<string> &names();
+};
+
+#endif
@@ -0,0 +1,21 @@
+/*
+ * SparkFileSystem.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_FILE_SYSTEM_H
+#define SPARK_FILE_SYSTEM_H
+
+// File system holding presets, preset index and settings. On the device this is
+// LittleFS. Other builds (e.g. on a host with LittleFS mapped onto a directory)
+// can provide their own fs::FS by defining SPARK_FS_HEADER and SPARK_FS.
+#ifdef SPARK_FS_HEADER
+#include SPARK_FS_HEADER
+#else
+#include <LittleFS.h>
+#define SPARK_FS LittleFS
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * SparkHeapAudit.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkHeapAudit.h"
+#include <new>
+#include <stdlib.h>
+
+static const char *scopeNames[HEAP_SCOPE_COUNT] = {"Data", "Buttons", "LEDs", "Display", "Storage"};
+
+SparkHeapAudit &SparkHeapAudit::getInstance() {
+    static SparkHeapAudit INSTANCE;
+    return INSTANCE;
+}
+
+void SparkHeapAudit::markSteadyState() {
+    auditedTask_ = xTaskGetCurrentTaskHandle();
+    steadyStateTimestamp_ = millis();
+    lastReportTimestamp_ = steadyStateTimestamp_ + settleTime;
+    steadyState_ = true;
+    for (int i = 0; i < HEAP_SCOPE_COUNT; i++) {
+        allocations_[i] = 0;
+        allocatedBytes_[i] = 0;
+        lastAllocationSize_[i] = 0;
+    }
+    otherTaskAllocations_ = 0;
+    Serial.printf("Heap audit: steady state marked, counting allocations in %lu ms\n", settleTime);
+}
+
+bool SparkHeapAudit::isAuditing() const {
+    return steadyState_ && !reporting_ && millis() - steadyStateTimestamp_ >= settleTime;
+}
+
+void SparkHeapAudit::recordAllocation(size_t size) {
+    if (!isAuditing()) {
+        return;
+    }
+    if (xTaskGetCurrentTaskHandle() != auditedTask_) {
+        otherTaskAllocations_++;
+        return;
+    }
+    allocations_[scope_]++;
+    if (scope_ != HEAP_SCOPE_STORAGE) {
+        totalAllocations_++;
+    }
+    allocatedBytes_[scope_] += size;
+    lastAllocationSize_[scope_] = size;
+}
+
+void SparkHeapAudit::reportPeriodically() {
+    if (!steadyState_ || (long)(millis() - lastReportTimestamp_) < (long)reportInterval) {
+        return;
+    }
+    lastReportTimestamp_ = millis();
+    report();
+}
+
+bool SparkHeapAudit::report() {
+    reporting_ = true;
+    bool noAllocations = true;
+    for (int i = 0; i < HEAP_SCOPE_COUNT; i++) {
+        if (allocations_[i] > 0 && i == HEAP_SCOPE_STORAGE) {
+            Serial.printf("Heap audit: %s allocated %lu times (%u bytes)\n", scopeNames[i], allocations_[i],
+                          allocatedBytes_[i]);
+        } else if (allocations_[i] > 0) {
+            noAllocations = false;
+            Serial.printf("Heap audit ERROR: %s allocated %lu times (%u bytes, last %u bytes) in steady state\n",
+                          scopeNames[i], allocations_[i], allocatedBytes_[i], lastAllocationSize_[i]);
+        }
+        allocations_[i] = 0;
+        allocatedBytes_[i] = 0;
+        lastAllocationSize_[i] = 0;
+    }
+    if (noAllocations) {
+        Serial.println("Heap audit: no allocations in main loop");
+    }
+    Serial.printf("Heap audit: %lu allocations in other tasks, free heap %d, max block %d\n",
+                  otherTaskAllocations_.exchange(0), ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+    reporting_ = false;
+    return noAllocations;
+}
+
+#ifdef AUDIT_HEAP_ALLOCATIONS
+#ifdef AUDIT_HEAP_WRAP_MALLOC
+// Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc: every reference to these
+// functions in the linked objects and static libraries comes here, operator new included
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    SparkHeapAudit::getInstance().recordAllocation(size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    SparkHeapAudit::getInstance().recordAllocation(count * size);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    SparkHeapAudit::getInstance().recordAllocation(size);
+    return __real_realloc(ptr, size);
+}
+}
+
+static void *allocate(size_t size) {
+    return malloc(size ? size : 1);
+}
+#else
+static void *allocate(size_t size) {
+    SparkHeapAudit::getInstance().recordAllocation(size);
+    return malloc(size ? size : 1);
+}
+#endif
+
+// Replacements of the global allocation functions, all other forms forward to these
+void *operator new(size_t size) {
+    void *ptr = allocate(size);
+    if (!ptr) {
+        abort();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](size_t size, const nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    free(ptr);
+}
+#endif
@@ -0,0 +1,96 @@
+/*
+ * SparkHeapAudit.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_HEAP_AUDIT_H
+#define SPARK_HEAP_AUDIT_H
+
+#include "Config_Definitions.h"
+#include <Arduino.h>
+#include <atomic>
+#include <stddef.h>
+
+using namespace std;
+
+// Subsystems of the main loop, allocations are counted per subsystem
+enum HeapAuditScope {
+    HEAP_SCOPE_DATA,
+    HEAP_SCOPE_BUTTONS,
+    HEAP_SCOPE_LEDS,
+    HEAP_SCOPE_DISPLAY,
+    // Writes to the file system, which allocates a handle for each open file.
+    // Reported, but not counted as an error nor in totalAllocations().
+    HEAP_SCOPE_STORAGE,
+    HEAP_SCOPE_COUNT
+};
+
+class SparkHeapAudit {
+    // Heap allocation audit
+    // ---------------------
+    // When AUDIT_HEAP_ALLOCATIONS is defined, operator new is replaced and every allocation
+    // of the main loop task is counted once the steady state has been marked (after the
+    // connection handshake) and the settle time has passed. Allocations are reported per
+    // subsystem over serial, any allocation in steady state is reported as an error.
+    // Allocations of other tasks (e.g. BLE callbacks) are only counted in total.
+    // Plain malloc(), calloc() and realloc() calls are only seen with AUDIT_HEAP_WRAP_MALLOC,
+    // which needs the linker option -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+    // (PlatformIO environment "heap_audit"). Calls inside the ROM of the ESP32 are not seen.
+
+public:
+    static SparkHeapAudit &getInstance();
+
+    SparkHeapAudit(const SparkHeapAudit &) = delete;
+    SparkHeapAudit &operator=(const SparkHeapAudit &) = delete;
+
+    // To be called from the main loop task when the connection handshake is done.
+    // Counting starts after settleTime, counters are reset.
+    void markSteadyState();
+    void setScope(HeapAuditScope scope) { scope_ = scope; }
+    // Called for every allocation
+    void recordAllocation(size_t size);
+    // Prints the allocations since the last report every reportInterval ms
+    void reportPeriodically();
+    // Prints and resets the counters, returns false if there were allocations in steady state
+    bool report();
+    // Allocations of the main loop task in steady state, storage excluded, not reset by report()
+    unsigned long totalAllocations() const { return totalAllocations_; }
+    // Allocations of the main loop task in a subsystem since the last report
+    unsigned long allocations(HeapAuditScope scope) const { return allocations_[scope]; }
+
+    static const unsigned long settleTime = 10000;
+    static const unsigned long reportInterval = 10000;
+
+private:
+    SparkHeapAudit() {}
+
+    bool isAuditing() const;
+
+    TaskHandle_t auditedTask_ = nullptr;
+    unsigned long steadyStateTimestamp_ = 0;
+    unsigned long lastReportTimestamp_ = 0;
+    bool steadyState_ = false;
+    // Allocations while reporting are not counted
+    bool reporting_ = false;
+    HeapAuditScope scope_ = HEAP_SCOPE_DATA;
+
+    unsigned long allocations_[HEAP_SCOPE_COUNT] = {};
+    size_t allocatedBytes_[HEAP_SCOPE_COUNT] = {};
+    size_t lastAllocationSize_[HEAP_SCOPE_COUNT] = {};
+    atomic<unsigned long> otherTaskAllocations_{0};
+    unsigned long totalAllocations_ = 0;
+};
+
+#ifdef AUDIT_HEAP_ALLOCATIONS
+#define HEAP_AUDIT_STEADY_STATE() SparkHeapAudit::getInstance().markSteadyState()
+#define HEAP_AUDIT_SCOPE(scope) SparkHeapAudit::getInstance().setScope(scope)
+#define HEAP_AUDIT_REPORT() SparkHeapAudit::getInstance().reportPeriodically()
+#else
+#define HEAP_AUDIT_STEADY_STATE()
+#define HEAP_AUDIT_SCOPE(scope)
+#define HEAP_AUDIT_REPORT()
+#endif
+
+#endif
@@ -83,7 +83,7 @@ void SparkHelper::printByteVector(const ByteVector &vec) {
 
 int SparkHelper::dataVectorNumOfBytes(const vector<ByteVector> &data) {
     int count = 0;
-    for (auto vec : data) {
+    for (const auto &vec : data) {
         count += vec.size();
     }
     return count;
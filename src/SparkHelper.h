@@ -15,6 +15,7 @@
 #include <cstdio>
 
 #include "Config_Definitions.h"
+#include "InlineVector.h"
 #include <Arduino.h>
 
 using namespace std;
@@ -40,6 +41,12 @@ public:
     static void printDataAsHexString(const vector<ByteVector> &data);
     // Print a byte vector
     static void printByteVector(const ByteVector &vec);
+    template <int N>
+    static void printByteVector(const InlineVector<byte, N> &vec) {
+        for (auto by : vec) {
+            Serial.print(SparkHelper::intToHex(by).c_str());
+        }
+    }
     // get a byteVector from int value
     // static ByteVector bytes(int value);
 
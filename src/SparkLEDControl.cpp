@@ -53,7 +53,7 @@ void SparkLEDControl::init() {
 void SparkLEDControl::updateLEDs() {
 
     operationMode = sparkDC->operationMode();
-    activePreset = SparkPresetControl::getInstance().activePreset();
+    activePreset = &SparkPresetControl::getInstance().activePreset();
     activePresetNum = SparkPresetControl::getInstance().activePresetNum();
 
     switch (operationMode) {
@@ -106,11 +106,11 @@ void SparkLEDControl::updateLedAppPresetMode() {
 }
 
 void SparkLEDControl::updateLedAppFXMode() {
-    if (!activePreset.isEmpty) {
+    if (!activePreset->isEmpty) {
         for (int btnNumber = 1; btnNumber <= 6; btnNumber++) {
             FxLedButtonNumber fxButton = static_cast<FxLedButtonNumber>(btnNumber);
             FxType fxIndex = SparkHelper::getFXIndexFromButtonNumber(fxButton);
-            Pedal currentFX = activePreset.pedals[(int)fxIndex];
+            const Pedal &currentFX = activePreset->pedals[(int)fxIndex];
             switchLed(btnNumber, currentFX.isOn, true);
         }
     }
@@ -34,7 +34,7 @@ private:
     KeyboardMapping mapping;
 
     OperationMode operationMode = SPARK_MODE_APP;
-    Preset activePreset;
+    const Preset *activePreset = nullptr;
     int activePresetNum = 1;
 
     // For blinking mode
@@ -0,0 +1,116 @@
+/*
+ * SparkLatencyTrace.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkLatencyTrace.h"
+
+#ifdef TRACE_LATENCY
+
+static const char *actionNames[TRACE_ACTION_COUNT] = {"None", "HW preset", "Preset", "FX toggle", "Looper", "Tuner"};
+
+SparkLatencyTrace &SparkLatencyTrace::getInstance() {
+    static SparkLatencyTrace INSTANCE;
+    return INSTANCE;
+}
+
+void SparkLatencyTrace::record(TraceHop hop, uint8_t detail) {
+    TraceEvent &event = ring_[ringPos_ % ringSize];
+    event.timestamp = micros();
+    event.actionId = actionId_;
+    event.action = action_;
+    event.hop = hop;
+    event.detail = detail;
+    ringPos_++;
+}
+
+void SparkLatencyTrace::buttonPressed() {
+    if (inFlight_) {
+        abandonedActions_++;
+    }
+    inFlight_ = true;
+    actionId_++;
+    action_ = TRACE_ACTION_NONE;
+    record(TRACE_HOP_BUTTON, 0);
+    pressTimestamp_ = ring_[(ringPos_ - 1) % ringSize].timestamp;
+}
+
+void SparkLatencyTrace::setAction(TraceAction action) {
+    if (!inFlight_) {
+        return;
+    }
+    action_ = action;
+    record(TRACE_HOP_SWITCH, action);
+}
+
+void SparkLatencyTrace::hop(TraceHop hop, uint8_t detail) {
+    if (!inFlight_) {
+        return;
+    }
+    record(hop, detail);
+}
+
+void SparkLatencyTrace::ackReceived(uint8_t subCmd) {
+    if (!inFlight_) {
+        return;
+    }
+    record(TRACE_HOP_ACK, subCmd);
+
+    bool isFinalAck = false;
+    switch (action_) {
+    case TRACE_ACTION_HW_PRESET:
+    case TRACE_ACTION_CUSTOM_PRESET:
+        // Custom presets are sent with 01 01 and then activated with 01 38
+        isFinalAck = (subCmd == 0x38);
+        break;
+    case TRACE_ACTION_FX_TOGGLE:
+        isFinalAck = (subCmd == 0x15);
+        break;
+    case TRACE_ACTION_LOOPER:
+        isFinalAck = (subCmd == 0x75);
+        break;
+    case TRACE_ACTION_TUNER:
+        isFinalAck = (subCmd == 0x65);
+        break;
+    default:
+        break;
+    }
+    if (isFinalAck) {
+        uint32_t latency = ring_[(ringPos_ - 1) % ringSize].timestamp - pressTimestamp_;
+        latencies_[action_].add(latency);
+        lastLatency_ = latency;
+        completedActions_++;
+        inFlight_ = false;
+        LOG_INFO("Latency %s: %lu us\n", actionNames[action_], (unsigned long)latency);
+    }
+}
+
+void SparkLatencyTrace::dump() {
+    Serial.println("Button to ack latency (us):");
+    Serial.println("Action         count      min      avg      p99      max");
+    for (int i = TRACE_ACTION_NONE + 1; i < TRACE_ACTION_COUNT; i++) {
+        const DurationHistogram &histogram = latencies_[i];
+        Serial.printf("%-10s %9lu %8lu %8lu %8lu %8lu\n", actionNames[i],
+                      (unsigned long)histogram.count(), (unsigned long)histogram.min(),
+                      (unsigned long)histogram.average(), (unsigned long)histogram.percentile(99),
+                      (unsigned long)histogram.max());
+    }
+    Serial.printf("Abandoned actions: %lu\n", abandonedActions_);
+
+    // Binary trace, oldest event first: timestamp (4 bytes, little endian), action id,
+    // action, hop, detail
+    int numberOfEvents = ringPos_ < ringSize ? ringPos_ : ringSize;
+    Serial.printf("Trace: %d events of %d bytes\n", numberOfEvents, (int)sizeof(TraceEvent));
+    for (int i = 0; i < numberOfEvents; i++) {
+        const TraceEvent &event = ring_[(ringPos_ - numberOfEvents + i) % ringSize];
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&event);
+        for (int b = 0; b < sizeof(TraceEvent); b++) {
+            Serial.printf("%02X", bytes[b]);
+        }
+        Serial.println();
+    }
+}
+
+#endif
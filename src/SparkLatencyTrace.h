@@ -0,0 +1,113 @@
+/*
+ * SparkLatencyTrace.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_LATENCY_TRACE_H
+#define SPARK_LATENCY_TRACE_H
+
+#include "Config_Definitions.h"
+#include "DurationHistogram.h"
+#include <Arduino.h>
+#include <stdint.h>
+
+using namespace std;
+
+// Actions started by a button press
+enum TraceAction {
+    TRACE_ACTION_NONE,
+    TRACE_ACTION_HW_PRESET,
+    TRACE_ACTION_CUSTOM_PRESET,
+    TRACE_ACTION_FX_TOGGLE,
+    TRACE_ACTION_LOOPER,
+    TRACE_ACTION_TUNER,
+    TRACE_ACTION_COUNT
+};
+
+// Steps from button press to the final acknowledgment of the amp
+enum TraceHop {
+    TRACE_HOP_BUTTON,
+    TRACE_HOP_SWITCH,
+    TRACE_HOP_MESSAGE,
+    TRACE_HOP_BLE_WRITE,
+    TRACE_HOP_ACK,
+    TRACE_HOP_COUNT
+};
+
+// Entry of the binary trace ring
+struct TraceEvent {
+    uint32_t timestamp; // micros()
+    uint8_t actionId;   // running number of the action
+    uint8_t action;     // TraceAction
+    uint8_t hop;        // TraceHop
+    uint8_t detail;     // e.g. sub command of the written block or the ack
+};
+
+class SparkLatencyTrace {
+    // Button to amp latency tracing
+    // -----------------------------
+    // When TRACE_LATENCY is defined, each hop of a button action (button press, preset
+    // switch, message built, BLE write, amp ack) is stored with a timestamp in a ring of
+    // TraceEvents. The action is complete when the final ack arrives (04 38 for presets,
+    // 04 15 for effects, 04 75 for looper commands, 04 65 for the tuner), the latency
+    // from button press to that ack is collected per action type. Only one action is
+    // traced at a time, a new button press replaces an action that has not been
+    // acknowledged yet.
+    // dump() prints the latency distributions and the trace ring (command 't' on Serial).
+
+public:
+    static SparkLatencyTrace &getInstance();
+
+    SparkLatencyTrace(const SparkLatencyTrace &) = delete;
+    SparkLatencyTrace &operator=(const SparkLatencyTrace &) = delete;
+
+    void buttonPressed();
+    void setAction(TraceAction action);
+    void hop(TraceHop hop, uint8_t detail = 0);
+    // Final ack of the amp, completes the action if it is the expected ack
+    void ackReceived(uint8_t subCmd);
+
+    const DurationHistogram &latency(TraceAction action) const { return latencies_[action]; }
+    bool isInFlight() const { return inFlight_; }
+    // Latency of the last completed action
+    uint32_t lastLatency() const { return lastLatency_; }
+    unsigned long completedActions() const { return completedActions_; }
+    void dump();
+
+    static const int ringSize = 256;
+
+private:
+    SparkLatencyTrace() {}
+
+    void record(TraceHop hop, uint8_t detail);
+
+    TraceEvent ring_[ringSize] = {};
+    uint32_t ringPos_ = 0;
+
+    bool inFlight_ = false;
+    uint8_t actionId_ = 0;
+    TraceAction action_ = TRACE_ACTION_NONE;
+    uint32_t pressTimestamp_ = 0;
+    unsigned long abandonedActions_ = 0;
+    unsigned long completedActions_ = 0;
+    uint32_t lastLatency_ = 0;
+
+    // Latency in microseconds per action type
+    DurationHistogram latencies_[TRACE_ACTION_COUNT];
+};
+
+#ifdef TRACE_LATENCY
+#define TRACE_BUTTON_PRESS() SparkLatencyTrace::getInstance().buttonPressed()
+#define TRACE_ACTION(action) SparkLatencyTrace::getInstance().setAction(action)
+#define TRACE_HOP(...) SparkLatencyTrace::getInstance().hop(__VA_ARGS__)
+#define TRACE_ACK(subCmd) SparkLatencyTrace::getInstance().ackReceived(subCmd)
+#else
+#define TRACE_BUTTON_PRESS()
+#define TRACE_ACTION(action)
+#define TRACE_HOP(...)
+#define TRACE_ACK(subCmd)
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * SparkLog.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkLog.h"
+#include "Config_Definitions.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+SparkLog &SparkLog::getInstance() {
+    static SparkLog INSTANCE;
+    return INSTANCE;
+}
+
+void SparkLog::begin() {
+    if (started_) {
+        return;
+    }
+    started_ = true;
+    // Low priority on the protocol core, so sending to Serial never delays the main loop
+    xTaskCreatePinnedToCore(
+        drainTask,
+        "SparkLog",
+        4096,
+        this,
+        1,
+        NULL,
+        0);
+}
+
+size_t SparkLog::write(uint8_t by) {
+    return write(&by, 1);
+}
+
+size_t SparkLog::write(const uint8_t *data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    unsigned long startTime = micros();
+    if (isDirect_) {
+        size = Serial.write(data, size);
+        recordWriteTime(startTime);
+        return size;
+    }
+    // A single record may use at most half of the buffer
+    size = min(size, bufferSize / 2 - recordHeaderSize);
+    uint32_t recordSize = size + recordHeaderSize;
+
+    uint32_t start = head_.load(memory_order_relaxed);
+    do {
+        if (start + recordSize - tail_.load(memory_order_acquire) > bufferSize) {
+            dropped_++;
+            return 0;
+        }
+    } while (!head_.compare_exchange_weak(start, start + recordSize, memory_order_acq_rel, memory_order_relaxed));
+
+    buffer_[(start + 1) & indexMask] = size & 0xFF;
+    buffer_[(start + 2) & indexMask] = size >> 8;
+    uint32_t dataStart = (start + recordHeaderSize) & indexMask;
+    size_t firstPart = min(size, bufferSize - dataStart);
+    memcpy(&buffer_[dataStart], data, firstPart);
+    memcpy(buffer_, data + firstPart, size - firstPart);
+    // Record is complete, make it visible to the drain task
+    __atomic_store_n(&buffer_[start & indexMask], 1, __ATOMIC_RELEASE);
+
+    recordWriteTime(startTime);
+    return size;
+}
+
+void SparkLog::recordWriteTime(unsigned long startTime) {
+    unsigned long writeTime = micros() - startTime;
+    if (writeTime > maxWriteTime_.load(memory_order_relaxed)) {
+        maxWriteTime_ = writeTime;
+    }
+}
+
+size_t SparkLog::printf(const char *format, ...) {
+    char line[maxLineLength];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    return write((const uint8_t *)line, min((size_t)length, sizeof(line) - 1));
+}
+
+bool SparkLog::drain() {
+    uint32_t tail = tail_.load(memory_order_relaxed);
+    bool hasSent = false;
+    while (tail != head_.load(memory_order_acquire)) {
+        if (__atomic_load_n(&buffer_[tail & indexMask], __ATOMIC_ACQUIRE) == 0) {
+            // Reserved, but still being written
+            break;
+        }
+        size_t size = buffer_[(tail + 1) & indexMask] | (buffer_[(tail + 2) & indexMask] << 8);
+        uint32_t dataStart = (tail + recordHeaderSize) & indexMask;
+        size_t firstPart = min(size, bufferSize - dataStart);
+        Serial.write(&buffer_[dataStart], firstPart);
+        if (size > firstPart) {
+            Serial.write(buffer_, size - firstPart);
+        }
+
+        // Clear the record so the ready flag of the next record at this position starts at 0
+        uint32_t recordStart = tail & indexMask;
+        uint32_t recordSize = size + recordHeaderSize;
+        size_t firstClear = min((size_t)recordSize, bufferSize - recordStart);
+        memset(&buffer_[recordStart], 0, firstClear);
+        memset(buffer_, 0, recordSize - firstClear);
+
+        tail += recordSize;
+        tail_.store(tail, memory_order_release);
+        hasSent = true;
+    }
+    return hasSent;
+}
+
+void SparkLog::drainNow() {
+    // The drain task is the only reader once it is started
+    if (!started_) {
+        drain();
+    }
+}
+
+void SparkLog::drainTask(void *parameter) {
+    SparkLog *log = static_cast<SparkLog *>(parameter);
+    unsigned long reportedDrops = 0;
+#ifdef DEBUG
+    unsigned long lastStatsTime = millis();
+#endif
+    for (;;) {
+        if (!log->drain()) {
+            vTaskDelay(10 / portTICK_PERIOD_MS);
+        }
+        unsigned long drops = log->droppedCount();
+        if (drops != reportedDrops) {
+            Serial.printf("[Log] %lu messages dropped, longest write %lu us\n",
+                          drops - reportedDrops, log->maxWriteTime());
+            reportedDrops = drops;
+        }
+#ifdef DEBUG
+        // Longest time the main loop or a callback was held up by logging
+        if (millis() - lastStatsTime >= 10000) {
+            Serial.printf("[Log] longest write %lu us, %lu messages dropped in total\n",
+                          log->maxWriteTime(), drops);
+            lastStatsTime = millis();
+        }
+#endif
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * SparkLog.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_LOG_H
+#define SPARK_LOG_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <stddef.h>
+
+using namespace std;
+
+class SparkLog : public Print {
+    // Non-blocking logging
+    // --------------------
+    // Log output is written to a ring buffer and sent to Serial by a low priority task,
+    // so logging does not block the main loop or the BLE callbacks. If the buffer is full,
+    // the output is dropped and counted instead of waiting.
+    // Each write is stored as one record (ready flag, 2 bytes length, data). Writers reserve
+    // space by a compare-and-swap on the head index and set the ready flag when the data
+    // is complete, the drain task is the only reader. Consumed records are cleared, so the
+    // ready flag of a new record is always 0 until it is set by the writer.
+    // setDirect() writes straight to Serial instead, as before the buffer was added, so the
+    // stall of both ways can be compared with the same measurement (maxWriteTime).
+
+public:
+    static SparkLog &getInstance();
+
+    SparkLog(const SparkLog &) = delete;
+    SparkLog &operator=(const SparkLog &) = delete;
+
+    // Starts the task sending the buffered output to Serial
+    void begin();
+
+    size_t write(uint8_t by) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+    // Formats into a stack buffer, longer lines are truncated to maxLineLength
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    unsigned long droppedCount() const { return dropped_.load(); }
+    // Longest time a single write took, in microseconds
+    unsigned long maxWriteTime() const { return maxWriteTime_.load(); }
+    void resetMaxWriteTime() { maxWriteTime_ = 0; }
+
+    // Blocking output to Serial, for comparison only
+    void setDirect(bool isDirect) { isDirect_ = isDirect; }
+    // Sends the buffered output to Serial, only if begin() has not been called
+    void drainNow();
+
+    // Must be a power of 2
+    static const size_t bufferSize = 4096;
+    static const size_t maxLineLength = 192;
+
+private:
+    SparkLog() {}
+
+    static void drainTask(void *parameter);
+    // Sends all complete records to Serial, returns false if there was nothing to send
+    bool drain();
+    void recordWriteTime(unsigned long startTime);
+
+    static const size_t recordHeaderSize = 3;
+    static const uint32_t indexMask = bufferSize - 1;
+
+    uint8_t buffer_[bufferSize] = {};
+    // Free running indexes, position in buffer is index & indexMask
+    atomic<uint32_t> head_{0};
+    atomic<uint32_t> tail_{0};
+    atomic<unsigned long> dropped_{0};
+    atomic<unsigned long> maxWriteTime_{0};
+    bool started_ = false;
+    bool isDirect_ = false;
+};
+
+#endif
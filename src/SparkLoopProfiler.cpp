@@ -0,0 +1,90 @@
+/*
+ * SparkLoopProfiler.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkLoopProfiler.h"
+
+#ifdef PROFILE_LOOP
+
+static const char *stageNames[LOOP_STAGE_COUNT] = {"Updates", "Buttons", "Battery", "LEDs", "Display", "Total"};
+
+SparkLoopProfiler &SparkLoopProfiler::getInstance() {
+    static SparkLoopProfiler INSTANCE;
+    return INSTANCE;
+}
+
+SparkLoopProfiler::SparkLoopProfiler() {
+    clock_ = cycleClock;
+    ticksPerMicrosecond_ = ESP.getCpuFreqMHz();
+    if (ticksPerMicrosecond_ == 0) {
+        // CPU frequency unknown (host build), the cycle counter can't be converted
+        clock_ = microsClock;
+        ticksPerMicrosecond_ = 1;
+    }
+}
+
+uint32_t SparkLoopProfiler::cycleClock() {
+    return ESP.getCycleCount();
+}
+
+uint32_t SparkLoopProfiler::microsClock() {
+    return micros();
+}
+
+void SparkLoopProfiler::setClock(ClockFunction clock, uint32_t ticksPerMicrosecond) {
+    clock_ = clock;
+    ticksPerMicrosecond_ = ticksPerMicrosecond > 0 ? ticksPerMicrosecond : 1;
+    reset();
+}
+
+uint32_t SparkLoopProfiler::elapsedMicros(uint32_t since, uint32_t now) const {
+    // Unsigned difference handles the wrap around of the cycle counter
+    return (now - since) / ticksPerMicrosecond_;
+}
+
+void SparkLoopProfiler::beginLoop() {
+    loopStart_ = clock_();
+    stageStart_ = loopStart_;
+}
+
+void SparkLoopProfiler::endStage(LoopStage stage) {
+    uint32_t now = clock_();
+    histograms_[stage].add(elapsedMicros(stageStart_, now));
+    stageStart_ = now;
+}
+
+void SparkLoopProfiler::endLoop() {
+    histograms_[LOOP_STAGE_TOTAL].add(elapsedMicros(loopStart_, clock_()));
+
+    if (reportRequested_ || millis() - lastReportTimestamp_ >= reportInterval) {
+        report();
+        reset();
+        reportRequested_ = false;
+        lastReportTimestamp_ = millis();
+    }
+}
+
+void SparkLoopProfiler::report() {
+    Serial.printf("Loop profile (us), %lu loops:\n", (unsigned long)histograms_[LOOP_STAGE_TOTAL].count());
+    Serial.println("Stage        min      avg      p99      max");
+    for (int i = 0; i < LOOP_STAGE_COUNT; i++) {
+        const DurationHistogram &histogram = histograms_[i];
+        if (histogram.count() == 0) {
+            continue;
+        }
+        Serial.printf("%-8s %8lu %8lu %8lu %8lu\n", stageNames[i],
+                      (unsigned long)histogram.min(), (unsigned long)histogram.average(),
+                      (unsigned long)histogram.percentile(99), (unsigned long)histogram.max());
+    }
+}
+
+void SparkLoopProfiler::reset() {
+    for (int i = 0; i < LOOP_STAGE_COUNT; i++) {
+        histograms_[i].reset();
+    }
+}
+
+#endif
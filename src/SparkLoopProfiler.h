@@ -0,0 +1,89 @@
+/*
+ * SparkLoopProfiler.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_LOOP_PROFILER_H
+#define SPARK_LOOP_PROFILER_H
+
+#include "Config_Definitions.h"
+#include "DurationHistogram.h"
+#include <Arduino.h>
+#include <stdint.h>
+
+using namespace std;
+
+// Stages of the main loop
+enum LoopStage {
+    LOOP_STAGE_UPDATES,
+    LOOP_STAGE_BUTTONS,
+    LOOP_STAGE_BATTERY,
+    LOOP_STAGE_LEDS,
+    LOOP_STAGE_DISPLAY,
+    LOOP_STAGE_TOTAL,
+    LOOP_STAGE_COUNT
+};
+
+class SparkLoopProfiler {
+    // Main loop profiler
+    // ------------------
+    // When PROFILE_LOOP is defined, the time of each stage of loop() is measured with the
+    // CPU cycle counter and collected in histograms. A report (min/avg/p99/max per stage)
+    // is printed every reportInterval ms or on request (command 'p' on Serial).
+    // The clock can be replaced (setClock), e.g. by a virtual clock when simulating on a host.
+    // Without PROFILE_LOOP the macros below are empty and nothing is compiled in.
+
+public:
+    typedef uint32_t (*ClockFunction)();
+
+    static SparkLoopProfiler &getInstance();
+
+    SparkLoopProfiler(const SparkLoopProfiler &) = delete;
+    SparkLoopProfiler &operator=(const SparkLoopProfiler &) = delete;
+
+    // Clock returning ticks, ticksPerMicrosecond to convert them
+    void setClock(ClockFunction clock, uint32_t ticksPerMicrosecond);
+
+    void beginLoop();
+    // Adds the time since the last stage (or loop begin) to the given stage
+    void endStage(LoopStage stage);
+    void endLoop();
+    // Report is printed at the end of the current loop
+    void requestReport() { reportRequested_ = true; }
+
+    const DurationHistogram &histogram(LoopStage stage) const { return histograms_[stage]; }
+    void report();
+    void reset();
+
+    static const unsigned long reportInterval = 30000;
+
+private:
+    SparkLoopProfiler();
+
+    uint32_t elapsedMicros(uint32_t since, uint32_t now) const;
+    static uint32_t cycleClock();
+    static uint32_t microsClock();
+
+    ClockFunction clock_;
+    uint32_t ticksPerMicrosecond_;
+    uint32_t loopStart_ = 0;
+    uint32_t stageStart_ = 0;
+    unsigned long lastReportTimestamp_ = 0;
+    bool reportRequested_ = false;
+
+    DurationHistogram histograms_[LOOP_STAGE_COUNT];
+};
+
+#ifdef PROFILE_LOOP
+#define PROFILE_LOOP_BEGIN() SparkLoopProfiler::getInstance().beginLoop()
+#define PROFILE_STAGE_END(stage) SparkLoopProfiler::getInstance().endStage(stage)
+#define PROFILE_LOOP_END() SparkLoopProfiler::getInstance().endLoop()
+#else
+#define PROFILE_LOOP_BEGIN()
+#define PROFILE_STAGE_END(stage)
+#define PROFILE_LOOP_END()
+#endif
+
+#endif
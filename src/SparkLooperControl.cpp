@@ -35,21 +35,25 @@ void SparkLooperControl::init() {
 void SparkLooperControl::run(void *args) {
 
     while (true) {
-        int bpm = looperSetting_.bpm;
-        if (bpm > 0) {
-            beatInterval_ = (float)60000 / bpm;
-        }
-        if (resetTrigger_) {
-            reset();
-        }
+        update();
+    }
+}
+
+void SparkLooperControl::update() {
+    int bpm = looperSetting_.bpm;
+    if (bpm > 0) {
+        beatInterval_ = (float)60000 / bpm;
+    }
+    if (resetTrigger_) {
+        reset();
+    }
 
-        unsigned long now = millis();
-        if ((now - lastBeatTimestamp) >= (beatInterval_ / 2)) {
-            lastBeatTimestamp = now;
-            beatOnOff_ = !(beatOnOff_);
-            if (looperStarted && beatOnOff_) {
-                increaseBeat();
-            }
+    unsigned long now = millis();
+    if ((now - lastBeatTimestamp) >= (beatInterval_ / 2)) {
+        lastBeatTimestamp = now;
+        beatOnOff_ = !(beatOnOff_);
+        if (looperStarted && beatOnOff_) {
+            increaseBeat();
         }
     }
 }
@@ -82,17 +86,12 @@ void SparkLooperControl::setMeasure(float measure) {
     // DEBUG_PRINTF("Current beat: %f, (%d) %d / %d \n", measure, totalBeat, currentBar_, currentBeat_);
 }
 
-string SparkLooperControl::getLooperStatus() {
-    string str = "{ ";
-    str = str + "Recording running: " + (isRecRunning_ ? "true" : "false");
-    str += ", ";
-    str = str + "Recording available: " + (isRecAvailable_ ? "true" : "false");
-    str += ", ";
-    str = str + "Is Playing: " + (isPlaying_ ? "true" : "false");
-    str += ", ";
-    str = str + "Redo available: " + (canRedo_ ? "true" : "false");
-    str += " }";
-    return str;
+void SparkLooperControl::logLooperStatus() const {
+    LOG_INFO("{ Recording running: %s, Recording available: %s, Is Playing: %s, Redo available: %s }\n",
+             isRecRunning_ ? "true" : "false",
+             isRecAvailable_ ? "true" : "false",
+             isPlaying_ ? "true" : "false",
+             canRedo_ ? "true" : "false");
 }
 
 void SparkLooperControl::increaseBeat() {
@@ -28,7 +28,10 @@ public:
     const int bpm() const { return looperSetting_.bpm; }
     const int beatOnOff() const { return beatOnOff_; }
     void init();
+    // Task of the looper timer, calls update() in a loop
     static void run(void *args);
+    // Advances beat and bar on the clock, the host build calls it from its main loop
+    static void update();
     void stop();
     void start();
     static void reset();
@@ -59,7 +62,8 @@ public:
     bool &canRedo() { return canRedo_; }
     int &loopCount() { return loopCount_; }
 
-    string getLooperStatus();
+    // Writes the looper status to the log
+    void logLooperStatus() const;
 
 private:
     static LooperSetting looperSetting_;
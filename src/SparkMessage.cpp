@@ -13,9 +13,9 @@ SparkMessage::SparkMessage() : data{}, splitData8{}, splitData7{}, cmd(0), subCm
 void SparkMessage::startMessage(byte _cmd, byte _subCmd) {
     cmd = _cmd;
     subCmd = _subCmd;
-    data = {};
-    splitData8 = {};
-    splitData7 = {};
+    // clear() keeps the capacity, the message buffers are reused for each message
+    data.clear();
+    numChunks_ = 0;
 };
 
 void SparkMessage::splitDataToChunks(int dir) {
@@ -36,6 +36,13 @@ void SparkMessage::splitDataToChunks(int dir) {
     if (dataLen > 0) {
         numChunks = int((dataLen + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE);
     }
+    numChunks_ = numChunks;
+    // Chunk buffers are only added, never removed, so they keep their capacity
+    if (splitData8.size() < numChunks) {
+        splitData8.resize(numChunks);
+        splitData7.resize(numChunks);
+        allChunks.resize(numChunks);
+    }
 
     // split the data into chunks of maximum 0x80 bytes (still 8 bit bytes)
     // and add a chunk sub-header if a multi-chunk message
@@ -43,18 +50,16 @@ void SparkMessage::splitDataToChunks(int dir) {
     for (int thisChunk = 0; thisChunk < numChunks; thisChunk++) {
         int chunkLen = min(MAX_CHUNK_SIZE,
                            dataLen - (thisChunk * MAX_CHUNK_SIZE));
-        ByteVector data8;
+        ByteVector &data8 = splitData8[thisChunk];
+        data8.clear();
         if (numChunks > 1) {
             // we need the chunk sub-header
             data8.push_back(numChunks);
             data8.push_back(thisChunk);
             data8.push_back(chunkLen);
-        } else {
-            data8 = {};
         }
         data8.insert(data8.end(), data.begin() + (thisChunk * MAX_CHUNK_SIZE),
                      data.begin() + (thisChunk * MAX_CHUNK_SIZE + chunkLen));
-        splitData8.push_back(data8);
     }
 }
 
@@ -64,16 +69,20 @@ void SparkMessage::convertDataTo7Bit() {
     // and in each chunk loop over every sequence of (max) 7 bytes
     // and extract the 8th bit and put in 'bit8'
     // and then add bit8 and the 7-bit sequence to data7
-    for (auto chunk : splitData8) {
+    for (int thisChunk = 0; thisChunk < numChunks_; thisChunk++) {
+        const ByteVector &chunk = splitData8[thisChunk];
 
         int chunkLen = chunk.size();
         int numberOfSequences = int((chunkLen + 6) / 7);
-        ByteVector bytes7 = {};
+        ByteVector &bytes7 = splitData7[thisChunk];
+        bytes7.clear();
 
         for (int thisSeq = 0; thisSeq < numberOfSequences; thisSeq++) {
             int seqLen = min(7, chunkLen - (thisSeq * 7));
             byte bit8 = 0;
-            ByteVector seq = {};
+            // bit8 goes in front of the sequence, it is set once the sequence is done
+            int bit8Pos = bytes7.size();
+            bytes7.push_back(0);
             for (int ind = 0; ind < seqLen; ind++) {
                 byte dat = chunk[thisSeq * 7 + ind];
                 if ((dat & 0x80) == 0x80) {
@@ -81,19 +90,15 @@ void SparkMessage::convertDataTo7Bit() {
                 }
                 dat &= 0x7f;
 
-                seq.push_back((byte)dat);
+                bytes7.push_back((byte)dat);
             }
-
-            bytes7.push_back(bit8);
-            bytes7.insert(bytes7.end(), seq.begin(), seq.end());
+            bytes7[bit8Pos] = bit8;
         }
-        splitData7.push_back(bytes7);
     }
 }
 
 void SparkMessage::buildChunkData(byte msgNumber) {
 
-    ByteVector chunkHeader = {0xF0, 0x01};
     byte msgNum;
     if (msgNumber == 0) {
         msgNum = 0x01;
@@ -103,80 +108,80 @@ void SparkMessage::buildChunkData(byte msgNumber) {
     byte trailer = 0xF7;
 
     // build F0 01 chunks:
-    for (auto data7bit : splitData7) {
+    for (int thisChunk = 0; thisChunk < numChunks_; thisChunk++) {
+        const ByteVector &data7bit = splitData7[thisChunk];
         byte checksum = calculateChecksum(data7bit);
 
-        ByteVector completeChunk = chunkHeader;
+        ByteVector &completeChunk = allChunks[thisChunk];
+        completeChunk.clear();
+        completeChunk.push_back(0xF0);
+        completeChunk.push_back(0x01);
         completeChunk.push_back(msgNum);
         completeChunk.push_back(checksum);
         completeChunk.push_back(cmd);
         completeChunk.push_back(subCmd);
         completeChunk.insert(completeChunk.end(), data7bit.begin(), data7bit.end());
         completeChunk.push_back(trailer);
-
-        allChunks.push_back(completeChunk);
     }
 }
 
-vector<CmdData> SparkMessage::buildMessage(MessageDirection dir, byte msgNum) {
+const vector<CmdData> &SparkMessage::buildMessage(MessageDirection dir, byte msgNum) {
 
-    vector<CmdData> finalMessage = {};
+    // Blocks are written in place, clear() keeps the capacity of the previous message
+    finalMessage.clear();
 
-    int totalBytesToProcess = SparkHelper::dataVectorNumOfBytes(allChunks);
     int blockPrefixSize = withHeader_ ? 16 : 0;
 
-    // Maximum block size depending on direction.
-    int MAX_BLOCK_SIZE = (dir == DIR_TO_SPARK) ? maxBlockSizeToSpark() : maxBlockSizeFromSpark();
+    // Maximum block size depending on direction, limited by the inline block storage
+    int maxBlockSize = (dir == DIR_TO_SPARK) ? maxBlockSizeToSpark() : maxBlockSizeFromSpark();
+    maxBlockSize = min(maxBlockSize, MAX_BLOCK_SIZE);
 
     // now we can create the final message with the message header and the chunk header
-    ByteVector blockHeader = {0x01, 0xFE, 0x00, 0x00};
-    ByteVector blockHeaderDirection = (dir == DIR_TO_SPARK) ? msgToSpark : msgFromSpark;
-    ByteVector blockFiller = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                              0x00};
-
-    // read all chunks into one big chunk for splitting
-    std::deque<byte> dataToSplit = {};
-    for (auto chunk : allChunks) {
-        dataToSplit.insert(dataToSplit.end(), chunk.begin(), chunk.end());
+    const byte blockHeader[] = {0x01, 0xFE, 0x00, 0x00};
+    const ByteVector &blockHeaderDirection = (dir == DIR_TO_SPARK) ? msgToSpark : msgFromSpark;
+    const byte blockFiller[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                0x00};
+
+    int dataSize = 0;
+    for (int thisChunk = 0; thisChunk < numChunks_; thisChunk++) {
+        dataSize += allChunks[thisChunk].size();
     }
-    allChunks.clear();
+    int chunkIndex = 0;
+    int chunkPos = 0;
 
-    // create block
-    ByteVector currentBlock = {};
-    int dataSize;
-
-    // create blocks from all data with headers.
-    while (dataToSplit.size() > 0) {
-        dataSize = (int)dataToSplit.size();
-        if (withHeader_) {
-
-            int blockSize = min(MAX_BLOCK_SIZE,
-                                dataSize + blockPrefixSize);
-            currentBlock = blockHeader;
-            currentBlock.insert(currentBlock.end(),
-                                blockHeaderDirection.begin(),
-                                blockHeaderDirection.end());
-            currentBlock.push_back(blockSize);
-            currentBlock.insert(currentBlock.end(), blockFiller.begin(),
-                                blockFiller.end());
-        }
-        int remainingSize = MAX_BLOCK_SIZE - currentBlock.size();
-        int bytesToInsert = min(remainingSize, dataSize);
-        std::deque<byte>::iterator numOfBytes = dataToSplit.begin() + bytesToInsert;
-        currentBlock.insert(currentBlock.end(), dataToSplit.begin(), numOfBytes);
-        dataToSplit.erase(dataToSplit.begin(), numOfBytes);
-        CmdData dataItem;
-        dataItem.data = currentBlock;
+    // create blocks from all chunks with headers.
+    while (dataSize > 0) {
+        finalMessage.emplace_back();
+        CmdData &dataItem = finalMessage.back();
         dataItem.cmd = cmd;
         dataItem.subcmd = subCmd;
         dataItem.detail = cmdDetail;
         dataItem.msgNum = msgNum;
-        finalMessage.push_back(dataItem);
-        currentBlock.clear();
+        BlockData &currentBlock = dataItem.data;
+
+        if (withHeader_) {
+            int blockSize = min(maxBlockSize, dataSize + blockPrefixSize);
+            currentBlock.append(begin(blockHeader), end(blockHeader));
+            currentBlock.append(blockHeaderDirection.begin(), blockHeaderDirection.end());
+            currentBlock.push_back(blockSize);
+            currentBlock.append(begin(blockFiller), end(blockFiller));
+        }
+        // fill the block with chunk data, chunks may span several blocks
+        while (currentBlock.size() < maxBlockSize && dataSize > 0) {
+            const ByteVector &chunk = allChunks[chunkIndex];
+            int bytesToInsert = min(maxBlockSize - currentBlock.size(), (int)chunk.size() - chunkPos);
+            currentBlock.append(chunk.begin() + chunkPos, chunk.begin() + chunkPos + bytesToInsert);
+            chunkPos += bytesToInsert;
+            dataSize -= bytesToInsert;
+            if (chunkPos == chunk.size()) {
+                chunkIndex++;
+                chunkPos = 0;
+            }
+        }
     }
 
     DEBUG_PRINTLN("COMPLETE MESSAGE: ");
-    for (auto block : finalMessage) {
+    for (const CmdData &block : finalMessage) {
         DEBUG_PRINTVECTOR(block.data);
         DEBUG_PRINTLN();
     }
@@ -184,7 +189,7 @@ vector<CmdData> SparkMessage::buildMessage(MessageDirection dir, byte msgNum) {
     return finalMessage;
 }
 
-vector<CmdData> SparkMessage::endMessage(MessageDirection dir, byte msgNumber) {
+const vector<CmdData> &SparkMessage::endMessage(MessageDirection dir, byte msgNumber) {
 
     DEBUG_PRINT("MESSAGE NUMBER: ");
     DEBUG_PRINT(msgNumber);
@@ -214,28 +219,22 @@ void SparkMessage::addPrefixedString(const string &packStr, int lengthOverride)
     int strLength = lengthOverride;
     if (strLength == 0)
         strLength = packStr.size();
-    ByteVector bytePack;
-    bytePack.push_back((byte)strLength);
-    bytePack.push_back((byte)(strLength + 0xa0));
-    copy(packStr.begin(), packStr.end(), back_inserter<ByteVector>(bytePack));
-    addBytes(bytePack);
+    data.push_back((byte)strLength);
+    data.push_back((byte)(strLength + 0xa0));
+    data.insert(data.end(), packStr.begin(), packStr.end());
 }
 
 void SparkMessage::addString(const string &packStr) {
     int strLength = packStr.size();
-    ByteVector bytePack;
-    bytePack.push_back((byte)(strLength + 0xa0));
-    copy(packStr.begin(), packStr.end(), back_inserter<ByteVector>(bytePack));
-    addBytes(bytePack);
+    data.push_back((byte)(strLength + 0xa0));
+    data.insert(data.end(), packStr.begin(), packStr.end());
 }
 
 void SparkMessage::addLongString(const string &packStr) {
     int strLength = packStr.size();
-    ByteVector bytePack;
-    bytePack.push_back((0xD9));
-    bytePack.push_back((byte)strLength);
-    copy(packStr.begin(), packStr.end(), back_inserter<ByteVector>(bytePack));
-    addBytes(bytePack);
+    data.push_back((0xD9));
+    data.push_back((byte)strLength);
+    data.insert(data.end(), packStr.begin(), packStr.end());
 }
 
 void SparkMessage::addFloat(float flt) {
@@ -247,18 +246,11 @@ void SparkMessage::addFloat(float flt) {
     // Overwrite bytes of union with float variable
     // ROundign float to 4 digits before converting to avoid rounding errors during conversion
     u.floatVariable = roundf(flt * 10000) / 10000;
-    ByteVector bytePack;
-    bytePack.push_back((byte)0xca);
+    data.push_back((byte)0xca);
     // Assign bytes to input array
     for (int i = 3; i >= 0; i--) {
-        bytePack.push_back(u.tempArray[i]);
+        data.push_back(u.tempArray[i]);
     }
-    // DEBUG_PRINTF("Converting float %f to HEX: ", u.floatVariable);
-    // for (auto byte : bytePack) {
-    //	DEBUG_PRINTF("%s", SparkHelper::intToHex(byte).c_str());
-    // }
-    // DEBUG_PRINTLN();
-    addBytes(bytePack);
 }
 
 void SparkMessage::addOnOff(boolean enable) {
@@ -272,16 +264,13 @@ void SparkMessage::addOnOff(boolean enable) {
 }
 
 void SparkMessage::addInt16(unsigned int number) {
-    ByteVector bytepack;
     // Converting number to 16 bit INT
-    bytepack.push_back(0xCD);
-    bytepack.push_back(number >> 8);
-    bytepack.push_back(number & 0xFF);
-
-    addBytes(bytepack);
+    data.push_back(0xCD);
+    data.push_back(number >> 8);
+    data.push_back(number & 0xFF);
 }
 
-vector<CmdData> SparkMessage::getCurrentPresetNum(byte msgNum) {
+const vector<CmdData> &SparkMessage::getCurrentPresetNum(byte msgNum) {
     // hardcoded message
     /*
     vector<ByteVector> msg;
@@ -298,7 +287,7 @@ vector<CmdData> SparkMessage::getCurrentPresetNum(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getCurrentPreset(byte msgNum, int hw_preset) {
+const vector<CmdData> &SparkMessage::getCurrentPreset(byte msgNum, int hw_preset) {
 
     cmd = 0x02;
     subCmd = 0x01;
@@ -320,7 +309,7 @@ vector<CmdData> SparkMessage::getCurrentPreset(byte msgNum, int hw_preset) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::changeEffectParameter(byte msgNum, const string &pedal, int param, float val) {
+const vector<CmdData> &SparkMessage::changeEffectParameter(byte msgNum, const string &pedal, int param, float val) {
     cmd = 0x01;
     subCmd = 0x04;
 
@@ -331,7 +320,7 @@ vector<CmdData> SparkMessage::changeEffectParameter(byte msgNum, const string &p
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::changeEffect(byte msgNum, const string &pedal1, const string &pedal2) {
+const vector<CmdData> &SparkMessage::changeEffect(byte msgNum, const string &pedal1, const string &pedal2) {
     cmd = 0x01;
     subCmd = 0x06;
 
@@ -341,7 +330,7 @@ vector<CmdData> SparkMessage::changeEffect(byte msgNum, const string &pedal1, co
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::changeHardwarePreset(byte msgNum, int preset_num) {
+const vector<CmdData> &SparkMessage::changeHardwarePreset(byte msgNum, int preset_num) {
     cmd = 0x01;
     subCmd = 0x38;
 
@@ -351,7 +340,7 @@ vector<CmdData> SparkMessage::changeHardwarePreset(byte msgNum, int preset_num)
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getAmpName(byte msgNum) {
+const vector<CmdData> &SparkMessage::getAmpName(byte msgNum) {
 
     cmd = 0x02;
     subCmd = 0x11;
@@ -360,7 +349,7 @@ vector<CmdData> SparkMessage::getAmpName(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getSerialNumber(byte msgNum) {
+const vector<CmdData> &SparkMessage::getSerialNumber(byte msgNum) {
     cmd = 0x02;
     subCmd = 0x23;
 
@@ -368,7 +357,7 @@ vector<CmdData> SparkMessage::getSerialNumber(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getHwChecksums(byte msgNum) {
+const vector<CmdData> &SparkMessage::getHwChecksums(byte msgNum) {
     cmd = 0x02;
     subCmd = 0x2a;
 
@@ -382,7 +371,7 @@ vector<CmdData> SparkMessage::getHwChecksums(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getHWChecksumsExtended(byte msgNum) {
+const vector<CmdData> &SparkMessage::getHWChecksumsExtended(byte msgNum) {
     cmd = 0x02;
     subCmd = 0x2b;
 
@@ -391,7 +380,7 @@ vector<CmdData> SparkMessage::getHWChecksumsExtended(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getFirmwareVersion(byte msgNum) {
+const vector<CmdData> &SparkMessage::getFirmwareVersion(byte msgNum) {
     cmd = 0x02;
     subCmd = 0x2f;
 
@@ -399,7 +388,7 @@ vector<CmdData> SparkMessage::getFirmwareVersion(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::getAmpStatus(byte msgNum) {
+const vector<CmdData> &SparkMessage::getAmpStatus(byte msgNum) {
     cmd = 0x02;
     subCmd = 0x71;
 
@@ -407,7 +396,7 @@ vector<CmdData> SparkMessage::getAmpStatus(byte msgNum) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::turnEffectOnOff(byte msgNum, const string &pedal, boolean enable) {
+const vector<CmdData> &SparkMessage::turnEffectOnOff(byte msgNum, const string &pedal, boolean enable) {
     cmd = 0x01;
     subCmd = 0x15;
 
@@ -418,7 +407,7 @@ vector<CmdData> SparkMessage::turnEffectOnOff(byte msgNum, const string &pedal,
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::switchTuner(byte msgNum, boolean enable) {
+const vector<CmdData> &SparkMessage::switchTuner(byte msgNum, boolean enable) {
     cmd = 0x01;
     subCmd = 0x65;
 
@@ -427,7 +416,7 @@ vector<CmdData> SparkMessage::switchTuner(byte msgNum, boolean enable) {
     return endMessage(DIR_TO_SPARK, msgNum);
 }
 
-vector<CmdData> SparkMessage::sendSerialNumber(byte msgNumber) {
+const vector<CmdData> &SparkMessage::sendSerialNumber(byte msgNumber) {
     cmd = 0x03;
     subCmd = 0x23;
 
@@ -440,7 +429,7 @@ vector<CmdData> SparkMessage::sendSerialNumber(byte msgNumber) {
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sendFirmwareVersion(byte msgNumber) {
+const vector<CmdData> &SparkMessage::sendFirmwareVersion(byte msgNumber) {
     cmd = 0x03;
     subCmd = 0x2F;
 
@@ -456,7 +445,7 @@ vector<CmdData> SparkMessage::sendFirmwareVersion(byte msgNumber) {
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sendHWChecksums(byte msgNumber, ByteVector checksums) {
+const vector<CmdData> &SparkMessage::sendHWChecksums(byte msgNumber, ByteVector checksums) {
     cmd = 0x03;
     subCmd = 0x2A;
 
@@ -491,18 +480,43 @@ vector<CmdData> SparkMessage::sendHWChecksums(byte msgNumber, ByteVector checksu
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sendHWPresetNumber(byte msgNumber) {
+const vector<CmdData> &SparkMessage::sendHWChecksumsExtended(byte msgNumber, const ByteVector &checksums) {
+    cmd = 0x03;
+    subCmd = 0x2B;
+
+    startMessage(cmd, subCmd);
+    // Array of 8 checksums, values above 127 are prefixed with CC
+    addByte(0x90 + checksums.size());
+    for (byte bt : checksums) {
+        if (bt >= 0x80) {
+            addByte(0xCC);
+        }
+        addByte(bt);
+    }
+    return endMessage(DIR_FROM_SPARK, msgNumber);
+}
+
+const vector<CmdData> &SparkMessage::sendHWPresetNumber(byte msgNumber, int presetNumber) {
     cmd = 0x03;
     subCmd = 0x10;
 
     startMessage(cmd, subCmd);
     addByte(0x00);
+    addByte((byte)presetNumber - 1);
     addByte(0x00);
-    addByte(0x00);
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::changePreset(const Preset &presetData,
+const vector<CmdData> &SparkMessage::sendAmpName(byte msgNumber, const string &ampName) {
+    cmd = 0x03;
+    subCmd = 0x11;
+
+    startMessage(cmd, subCmd);
+    addPrefixedString(ampName);
+    return endMessage(DIR_FROM_SPARK, msgNumber);
+}
+
+const vector<CmdData> &SparkMessage::changePreset(const Preset &presetData,
                                            MessageDirection direction, byte msgNum) {
 
     if (direction == DIR_TO_SPARK) {
@@ -518,7 +532,7 @@ vector<CmdData> SparkMessage::changePreset(const Preset &presetData,
 }
 
 // This prepares a message to send an acknowledgement
-vector<CmdData> SparkMessage::sendAck(byte msgNum, byte subCmd,
+const vector<CmdData> &SparkMessage::sendAck(byte msgNum, byte subCmd,
                                       MessageDirection dir) {
 
     byte cmd = 0x04;
@@ -578,10 +592,10 @@ ByteVector SparkMessage::buildPresetData(const Preset &presetData, MessageDirect
     addFloat(presetData.bpm);
     addByte((byte)(0x90 + 7)); // 7 pedals
     for (int i = 0; i < 7; i++) {
-        Pedal currPedal = presetData.pedals[i];
+        const Pedal &currPedal = presetData.pedals[i];
         addString(currPedal.name);
         addOnOff(currPedal.isOn);
-        vector<Parameter> currPedalParams = currPedal.parameters;
+        const auto &currPedalParams = currPedal.parameters;
         int numberOfParameters = currPedalParams.size();
         addByte((byte)(numberOfParameters + 0x90));
         for (int p = 0; p < numberOfParameters; p++) {
@@ -598,7 +612,7 @@ ByteVector SparkMessage::buildPresetData(const Preset &presetData, MessageDirect
     return data;
 }
 
-vector<CmdData> SparkMessage::sendAmpStatus(byte msgNumber) {
+const vector<CmdData> &SparkMessage::sendAmpStatus(byte msgNumber) {
 
     // f0 01 03 13 03 71 10 0c 04 01 02 4d 0e 51 05 4d 06 49 1d f7
     // 10 = 0 0 0 1 0 0 0 0 ==> 0 0 0 0 1 0 0 0
@@ -633,7 +647,7 @@ vector<CmdData> SparkMessage::sendAmpStatus(byte msgNumber) {
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sendResponse72(byte msgNumber) {
+const vector<CmdData> &SparkMessage::sendResponse72(byte msgNumber) {
 
     // f0 01 02 53 03 72 01 43 1e 00 0f f7
     cmd = 0x03;
@@ -647,7 +661,25 @@ vector<CmdData> SparkMessage::sendResponse72(byte msgNumber) {
     return endMessage(DIR_FROM_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sparkLooperCommand(byte msgNumber, LooperCommand command) {
+const vector<CmdData> &SparkMessage::sendTunerOutput(byte msgNumber, byte note, float offset) {
+    cmd = 0x03;
+    subCmd = 0x64;
+
+    startMessage(cmd, subCmd);
+    addByte(note);
+    addFloat(offset);
+    return endMessage(DIR_FROM_SPARK, msgNumber);
+}
+
+const vector<CmdData> &SparkMessage::sendIntermediateAck(byte msgNum, byte subCmd) {
+    // Sent by the amp for each block of a multi block message except the last one
+    byte cmd = 0x05;
+
+    startMessage(cmd, subCmd);
+    return endMessage(DIR_FROM_SPARK, msgNum);
+}
+
+const vector<CmdData> &SparkMessage::sparkLooperCommand(byte msgNumber, LooperCommand command) {
 
     cmd = 0x01;
     subCmd = 0x75;
@@ -658,7 +690,7 @@ vector<CmdData> SparkMessage::sparkLooperCommand(byte msgNumber, LooperCommand c
     return endMessage(DIR_TO_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::sparkConfigAfterIntro(byte msgNumber, byte command) {
+const vector<CmdData> &SparkMessage::sparkConfigAfterIntro(byte msgNumber, byte command) {
 
     cmd = 0x02;
     subCmd = command;
@@ -671,14 +703,30 @@ vector<CmdData> SparkMessage::sparkConfigAfterIntro(byte msgNumber, byte command
     return endMessage(DIR_TO_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::updateLooperSettings(byte msgNumber, const LooperSetting &setting) {
+const vector<CmdData> &SparkMessage::updateLooperSettings(byte msgNumber, const LooperSetting &setting) {
 
     cmd = 0x01;
     subCmd = 0x76;
-    vector<CmdData> message;
 
     DEBUG_PRINTF("LPSetting: BPM: %d, Count: %02x, Bars: %d, Free?: %d, Click: %d, Max duration: %d\n ", setting.bpm, setting.count, setting.bars, setting.freeIndicator, setting.click, setting.maxDuration);
     startMessage(cmd, subCmd);
+    addLooperSetting(setting);
+
+    return endMessage(DIR_TO_SPARK, msgNumber);
+}
+
+const vector<CmdData> &SparkMessage::sendLooperSettings(byte msgNumber, const LooperSetting &setting) {
+
+    cmd = 0x03;
+    subCmd = 0x76;
+
+    startMessage(cmd, subCmd);
+    addLooperSetting(setting);
+
+    return endMessage(DIR_FROM_SPARK, msgNumber);
+}
+
+void SparkMessage::addLooperSetting(const LooperSetting &setting) {
     if (setting.bpm >= 128) {
         addByte(0xCC);
     }
@@ -689,26 +737,23 @@ vector<CmdData> SparkMessage::updateLooperSettings(byte msgNumber, const LooperS
     addOnOff(setting.click);
     addOnOff(setting.unknownOnOff);
     addInt16(setting.maxDuration);
-
-    message = endMessage(DIR_TO_SPARK, msgNumber);
-    return message;
 }
 
-vector<CmdData> SparkMessage::getLooperStatus(byte msgNumber) {
+const vector<CmdData> &SparkMessage::getLooperStatus(byte msgNumber) {
     cmd = 0x02;
     subCmd = 0x78;
     startMessage(cmd, subCmd);
     return endMessage(DIR_TO_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::getLooperConfig(byte msgNumber) {
+const vector<CmdData> &SparkMessage::getLooperConfig(byte msgNumber) {
     cmd = 0x02;
     subCmd = 0x76;
     startMessage(cmd, subCmd);
     return endMessage(DIR_TO_SPARK, msgNumber);
 }
 
-vector<CmdData> SparkMessage::getLooperRecordStatus(byte msgNumber) {
+const vector<CmdData> &SparkMessage::getLooperRecordStatus(byte msgNumber) {
     cmd = 0x02;
     subCmd = 0x75;
     startMessage(cmd, subCmd);
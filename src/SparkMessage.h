@@ -34,7 +34,11 @@ private:
     vector<ByteVector> splitData8;
     vector<ByteVector> splitData7;
     vector<ByteVector> allChunks;
+    // Chunks of the current message, the chunk vectors above may hold more from earlier messages
+    int numChunks_ = 0;
     byte currentMsgNumber_ = 0x00;
+    // Blocks of the last built message, the capacity is reused for each message
+    vector<CmdData> finalMessage;
 
     const ByteVector msgFromSpark = {0x41, 0xff};
     const ByteVector msgToSpark = {0x53, 0xfe};
@@ -50,13 +54,13 @@ private:
     bool withHeader_ = true;
 
     void startMessage(byte cmd_, byte sub_cmd_);
-    vector<CmdData> endMessage(MessageDirection dir = DIR_TO_SPARK,
-                               byte msgNumber = 0x00);
+    const vector<CmdData> &endMessage(MessageDirection dir = DIR_TO_SPARK,
+                                      byte msgNumber = 0x00);
 
     void splitDataToChunks(int dir);
     void convertDataTo7Bit();
     void buildChunkData(byte msgNumber);
-    vector<CmdData> buildMessage(MessageDirection dir, byte msgNum = 0);
+    const vector<CmdData> &buildMessage(MessageDirection dir, byte msgNum = 0);
     // ByteVector endMessage();
     void addBytes(const ByteVector &bytes8);
     void addByte(byte by);
@@ -67,6 +71,7 @@ private:
     void addFloat(float flt);
     void addOnOff(boolean onoff);
     void addInt16(unsigned int number);
+    void addLooperSetting(const LooperSetting &setting);
     byte calculateChecksum(const ByteVector &chunk);
     byte calculatePresetChecksum(const ByteVector &chunk);
     ByteVector buildPresetData(const Preset &preset, MessageDirection direction = DIR_TO_SPARK);
@@ -75,37 +80,42 @@ public:
     SparkMessage();
 
     // Command messages to send to Spark
-    vector<CmdData> changeEffectParameter(byte msgNum, const string &pedal, int param, float val);
-    vector<CmdData> changeEffect(byte msgNum, const string &pedal1, const string &pedal2);
-    vector<CmdData> changeHardwarePreset(byte msgNum, int preset_num);
-    vector<CmdData> turnEffectOnOff(byte msgNum, const string &pedal, boolean enable);
-    vector<CmdData> switchTuner(byte msgNum, boolean enable);
-    vector<CmdData> changePreset(const Preset &presetData, MessageDirection dir = DIR_TO_SPARK, byte msgNum = 0x00);
-    vector<CmdData> getCurrentPresetNum(byte msgNum);
-    vector<CmdData> getCurrentPreset(byte msgNum, int hwPreset = -1);
-    vector<CmdData> sendAck(byte seq, byte cmd_, MessageDirection direction = DIR_TO_SPARK);
-
-    vector<CmdData> getAmpName(byte msgNum);
-    vector<CmdData> getSerialNumber(byte msgNum);
-    vector<CmdData> getHwChecksums(byte msgNum);
-    vector<CmdData> getHWChecksumsExtended(byte msgNum);
-    vector<CmdData> getFirmwareVersion(byte msgNum);
-    vector<CmdData> getAmpStatus(byte msgNum);
-
-    vector<CmdData> sendSerialNumber(byte msgNumber);
-    vector<CmdData> sendFirmwareVersion(byte msgNumber);
-    vector<CmdData> sendHWChecksums(byte msgNumber, ByteVector checksums = {});
-    vector<CmdData> sendHWPresetNumber(byte msgNumber);
-    vector<CmdData> sendAmpStatus(byte msgNumber);
-    vector<CmdData> sendResponse72(byte msgNumber);
-
-    vector<CmdData> sparkLooperCommand(byte msgNumber, LooperCommand command);
-    vector<CmdData> sparkConfigAfterIntro(byte msgNumber, byte command);
-
-    vector<CmdData> updateLooperSettings(byte msgNumber, const LooperSetting &setting);
-    vector<CmdData> getLooperStatus(byte msgNumber);
-    vector<CmdData> getLooperConfig(byte msgNumber);
-    vector<CmdData> getLooperRecordStatus(byte msgNumber); // To test if that is correct
+    const vector<CmdData> &changeEffectParameter(byte msgNum, const string &pedal, int param, float val);
+    const vector<CmdData> &changeEffect(byte msgNum, const string &pedal1, const string &pedal2);
+    const vector<CmdData> &changeHardwarePreset(byte msgNum, int preset_num);
+    const vector<CmdData> &turnEffectOnOff(byte msgNum, const string &pedal, boolean enable);
+    const vector<CmdData> &switchTuner(byte msgNum, boolean enable);
+    const vector<CmdData> &changePreset(const Preset &presetData, MessageDirection dir = DIR_TO_SPARK, byte msgNum = 0x00);
+    const vector<CmdData> &getCurrentPresetNum(byte msgNum);
+    const vector<CmdData> &getCurrentPreset(byte msgNum, int hwPreset = -1);
+    const vector<CmdData> &sendAck(byte seq, byte cmd_, MessageDirection direction = DIR_TO_SPARK);
+
+    const vector<CmdData> &getAmpName(byte msgNum);
+    const vector<CmdData> &getSerialNumber(byte msgNum);
+    const vector<CmdData> &getHwChecksums(byte msgNum);
+    const vector<CmdData> &getHWChecksumsExtended(byte msgNum);
+    const vector<CmdData> &getFirmwareVersion(byte msgNum);
+    const vector<CmdData> &getAmpStatus(byte msgNum);
+
+    const vector<CmdData> &sendSerialNumber(byte msgNumber);
+    const vector<CmdData> &sendFirmwareVersion(byte msgNumber);
+    const vector<CmdData> &sendHWChecksums(byte msgNumber, ByteVector checksums = {});
+    const vector<CmdData> &sendHWChecksumsExtended(byte msgNumber, const ByteVector &checksums);
+    const vector<CmdData> &sendHWPresetNumber(byte msgNumber, int presetNumber = 1);
+    const vector<CmdData> &sendAmpName(byte msgNumber, const string &ampName);
+    const vector<CmdData> &sendAmpStatus(byte msgNumber);
+    const vector<CmdData> &sendResponse72(byte msgNumber);
+    const vector<CmdData> &sendTunerOutput(byte msgNumber, byte note, float offset);
+    const vector<CmdData> &sendLooperSettings(byte msgNumber, const LooperSetting &setting);
+    const vector<CmdData> &sendIntermediateAck(byte msgNum, byte subCmd);
+
+    const vector<CmdData> &sparkLooperCommand(byte msgNumber, LooperCommand command);
+    const vector<CmdData> &sparkConfigAfterIntro(byte msgNumber, byte command);
+
+    const vector<CmdData> &updateLooperSettings(byte msgNumber, const LooperSetting &setting);
+    const vector<CmdData> &getLooperStatus(byte msgNumber);
+    const vector<CmdData> &getLooperConfig(byte msgNumber);
+    const vector<CmdData> &getLooperRecordStatus(byte msgNumber); // To test if that is correct
 
     byte getPresetChecksum(const Preset &preset);
 
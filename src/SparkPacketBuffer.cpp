@@ -0,0 +1,58 @@
+/*
+ * SparkPacketBuffer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkPacketBuffer.h"
+
+bool SparkPacketBuffer::push(const uint8_t *data, size_t length) {
+    uint32_t head = head_.load(memory_order_relaxed);
+    uint32_t tail = tail_.load(memory_order_acquire);
+    uint32_t freeSpace = capacity - (head - tail);
+    if (length == 0 || length > 0xFFFF || length + 2 > freeSpace) {
+        dropped_.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    uint8_t lengthBytes[2] = {(uint8_t)(length & 0xFF), (uint8_t)(length >> 8)};
+    copyIn(head, lengthBytes, 2);
+    copyIn(head + 2, data, length);
+    // Publish the packet after it has been written completely
+    head_.store(head + 2 + length, memory_order_release);
+    return true;
+}
+
+bool SparkPacketBuffer::pop(ByteVector &packet) {
+    uint32_t tail = tail_.load(memory_order_relaxed);
+    uint32_t head = head_.load(memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+    uint8_t lengthBytes[2];
+    copyOut(tail, lengthBytes, 2);
+    size_t length = lengthBytes[0] | (lengthBytes[1] << 8);
+    packet.resize(length);
+    copyOut(tail + 2, packet.data(), length);
+    // Release the space after the packet has been read
+    tail_.store(tail + 2 + length, memory_order_release);
+    return true;
+}
+
+void SparkPacketBuffer::clear() {
+    tail_.store(head_.load(memory_order_acquire), memory_order_release);
+}
+
+void SparkPacketBuffer::copyIn(uint32_t pos, const uint8_t *data, size_t length) {
+    uint32_t offset = pos & (capacity - 1);
+    size_t first = min((size_t)(capacity - offset), length);
+    memcpy(buffer_ + offset, data, first);
+    memcpy(buffer_, data + first, length - first);
+}
+
+void SparkPacketBuffer::copyOut(uint32_t pos, uint8_t *data, size_t length) const {
+    uint32_t offset = pos & (capacity - 1);
+    size_t first = min((size_t)(capacity - offset), length);
+    memcpy(data, buffer_ + offset, first);
+    memcpy(data + first, buffer_, length - first);
+}
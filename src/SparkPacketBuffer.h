@@ -0,0 +1,50 @@
+/*
+ * SparkPacketBuffer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_PACKET_BUFFER_H
+#define SPARK_PACKET_BUFFER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+using ByteVector = vector<byte>;
+
+class SparkPacketBuffer {
+    // Ring buffer for received packets
+    // --------------------------------
+    // Fixed size ring with one writer (the task receiving the data) and one
+    // reader (the main loop), no locks and no allocations on the writing side.
+    // Each packet is stored with a 2 byte length prefix. If a packet does not
+    // fit, it is dropped and counted.
+
+public:
+    static const uint32_t capacity = 4096; // power of two
+
+    // Writer side, returns false if the packet has been dropped
+    bool push(const uint8_t *data, size_t length);
+    // Reader side, moves the oldest packet into packet (capacity of packet is reused)
+    bool pop(ByteVector &packet);
+    void clear();
+
+    const bool isEmpty() const { return head_.load(memory_order_acquire) == tail_.load(memory_order_relaxed); }
+    const unsigned long dropped() const { return dropped_.load(memory_order_relaxed); }
+
+private:
+    void copyIn(uint32_t pos, const uint8_t *data, size_t length);
+    void copyOut(uint32_t pos, uint8_t *data, size_t length) const;
+
+    uint8_t buffer_[capacity];
+    // Running positions, only the writer changes head_, only the reader changes tail_
+    atomic<uint32_t> head_{0};
+    atomic<uint32_t> tail_{0};
+    atomic<unsigned long> dropped_{0};
+};
+
+#endif
@@ -7,11 +7,35 @@
 
 #include "SparkPresetBuilder.h"
 
-void SparkPresetBuilder::updatePresetListUUID(int bnk, int pre, string uuid) {
-    presetUUIDs[uuid] = make_pair(bnk, pre);
+void SparkPresetBuilder::updateHWPresetUUID(int pre, const string &uuid) {
+    hwPresetUUIDs[uuid] = pre;
 }
 
-SparkPresetBuilder::SparkPresetBuilder() : presetBanksNames{} {
+SparkPresetBuilder::SparkPresetBuilder() {
+    initPresetFilter();
+}
+
+void SparkPresetBuilder::initPresetFilter() {
+    presetFilter["PresetNumber"] = true;
+    presetFilter["UUID"] = true;
+    presetFilter["Name"] = true;
+    presetFilter["Version"] = true;
+    presetFilter["Description"] = true;
+    presetFilter["Icon"] = true;
+    presetFilter["BPM"] = true;
+    // Filter of first array element is applied to all pedals
+    presetFilter["Pedals"][0]["Name"] = true;
+    presetFilter["Pedals"][0]["IsOn"] = true;
+    presetFilter["Pedals"][0]["Parameters"] = true;
+    presetFilter["Checksum"] = true;
+    presetFilter["Filler"] = true;
+}
+
+void SparkPresetBuilder::setDirectory(const string &directory) {
+    directory_ = directory;
+    presetListFileName = path("PresetList.txt");
+    presetListUUIDFileName = path("PresetListUUIDs.txt");
+    presetIndex.setDirectory(directory);
 }
 
 void SparkPresetBuilder::init() {
@@ -19,42 +43,70 @@ void SparkPresetBuilder::init() {
     // SPIFFS.begin(true);
     //  Creating vector of presets
     Serial.println("Initializing PresetBuilder");
+    DEBUG_PRINTF("Preset size: %d bytes (pedal %d, parameter %d)\n", (int)sizeof(Preset), (int)sizeof(Pedal), (int)sizeof(Parameter));
     resetHWPresets();
     initializePresetListFromFS();
 }
 
-Preset SparkPresetBuilder::getPresetFromJson(char *json) {
-    string jsonString(json);
-
-    JsonDocument jsonPreset;
-    DeserializationError err = deserializeJson(jsonPreset, json);
+Preset SparkPresetBuilder::getPresetFromJson(const char *json) {
+    presetDoc.clear();
+    DeserializationError err = deserializeJson(presetDoc, json, DeserializationOption::Filter(presetFilter));
 
     if (err) {
         Serial.print(F("deserializeJson() failed with code "));
         Serial.println(err.f_str());
     }
-    return getPresetFromJsonDocument(jsonPreset, jsonString);
+    return getPresetFromJsonDocument(presetDoc);
 }
 
-Preset SparkPresetBuilder::getPresetFromJson(File file) {
+// Reads the file in small blocks for ArduinoJson, single byte reads
+// through the file system are slow and the file is not held in RAM as a whole
+class BufferedFileReader {
+public:
+    BufferedFileReader(File &file) : file_(file) {}
+
+    int read() {
+        if (pos_ == length_) {
+            pos_ = 0;
+            length_ = file_.read(buffer_, sizeof buffer_);
+            if (length_ == 0) {
+                return -1;
+            }
+        }
+        return buffer_[pos_++];
+    }
 
-    JsonDocument jsonPreset;
-    DeserializationError err = deserializeJson(jsonPreset, file);
+    size_t readBytes(char *buffer, size_t length) {
+        size_t count = 0;
+        int c;
+        while (count < length && (c = read()) >= 0) {
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+
+private:
+    File &file_;
+    uint8_t buffer_[64];
+    size_t pos_ = 0;
+    size_t length_ = 0;
+};
+
+Preset SparkPresetBuilder::getPresetFromJson(File file) {
+    presetDoc.clear();
+    BufferedFileReader reader(file);
+    DeserializationError err = deserializeJson(presetDoc, reader, DeserializationOption::Filter(presetFilter));
 
     if (err) {
         Serial.print(F("deserializeJson() failed with code "));
         Serial.println(err.f_str());
     }
-    string jsonString;
-    serializeJson(jsonPreset, jsonString);
-    return getPresetFromJsonDocument(jsonPreset, jsonString);
+    return getPresetFromJsonDocument(presetDoc);
 }
 
-Preset SparkPresetBuilder::getPresetFromJsonDocument(JsonDocument jsonPreset, string jsonString) {
+Preset SparkPresetBuilder::getPresetFromJsonDocument(const JsonDocument &jsonPreset) {
     Preset resultPreset;
 
-    DEBUG_PRINTF("JSON STRING: %s\n", jsonString.c_str());
-
     // Preset number is not used currently
     resultPreset.presetNumber = jsonPreset["PresetNumber"].as<int>();
     // resultPreset.presetNumber = stoi(presetNumber, 0, 16);
@@ -84,22 +136,28 @@ Preset SparkPresetBuilder::getPresetFromJsonDocument(JsonDocument jsonPreset, st
     resultPreset.bpm = presetBpm;
 
     // all pedals
-    JsonArray pedalArray = jsonPreset["Pedals"];
-    for (JsonObject currentJsonPedal : pedalArray) {
+    JsonArrayConst pedalArray = jsonPreset["Pedals"];
+    for (JsonObjectConst currentJsonPedal : pedalArray) {
         Pedal currentPedal;
         currentPedal.name = currentJsonPedal["Name"].as<string>();
         currentPedal.isOn = currentJsonPedal["IsOn"].as<bool>();
 
-        JsonArray pedalParamArray = currentJsonPedal["Parameters"];
+        JsonArrayConst pedalParamArray = currentJsonPedal["Parameters"];
         int i = 0;
         for (float currentJsonPedalParam : pedalParamArray) {
             Parameter currentParam;
             currentParam.number = i;
             currentParam.special = 0x91;
             currentParam.value = currentJsonPedalParam;
-            currentPedal.parameters.push_back(currentParam);
+            if (!currentPedal.parameters.push_back(currentParam)) {
+                Serial.printf("ERROR: Too many parameters for effect %s, ignoring parameter %d\n", currentPedal.name.c_str(), i);
+            }
             i++;
         }
+        if (currentPedal.name.isKnown() && i > currentPedal.name.numParameters()) {
+            Serial.printf("WARNING: Effect %s has %d parameters, %d in effect catalog\n", currentPedal.name.c_str(), i,
+                          currentPedal.name.numParameters());
+        }
         resultPreset.pedals.push_back(currentPedal);
     }
     // preset checksum
@@ -115,87 +173,27 @@ Preset SparkPresetBuilder::getPresetFromJsonDocument(JsonDocument jsonPreset, st
     resultPreset.checksum = stoi(presetChecksum, 0, 16);
 
     resultPreset.isEmpty = false;
-    resultPreset.json = jsonString;
-    // DEBUG_PRINTLN("JSON:");
-    // DEBUG_PRINTLN(resultPreset.json.c_str());
     return resultPreset;
 }
 
-// string SparkPresetBuilder::getJsonFromPreset(preset pset){};
-
 void SparkPresetBuilder::initializePresetListFromFS() {
 
-    presetUUIDs.clear();
     Serial.println("Reading custom presets from filesystem.");
-    presetBanksNames.clear();
-    string allPresetsAsText;
-    vector<string> tmpVector;
-    bool createUUIDFile = false;
     DEBUG_PRINTLN("Trying to read preset list file");
-    File file = LittleFS.open(presetListUUIDFileName);
-
-    if (!file) {
+    if (SPARK_FS.exists(presetListUUIDFileName.c_str())) {
+        presetIndex.build(presetListUUIDFileName.c_str());
+    } else {
         Serial.println("ERROR while trying to open presets list file");
-        createUUIDFile = true;
-    }
-
-    if (createUUIDFile) {
-        file = LittleFS.open(presetListFileName);
-    }
-    string fileContent;
-    if (file) {
-        size_t size = file.size();
-        if (size > 0) {
-            fileContent.reserve(size); // avoid repeated reallocations
-            std::unique_ptr<char[]> buf(new char[size + 1]);
-            file.readBytes(buf.get(), size);
-            buf[size] = '\0';
-            fileContent.assign(buf.get(), size);
-            DEBUG_PRINTF("File read: %s\n", fileContent.c_str());
-        }
-    }
-    stringstream fileStream(fileContent);
-    file.close();
-
-    string line;
-    int bank = 1;
-    int preset = 1;
-    while (getline(fileStream, line)) {
-        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
-        line.erase(remove(line.begin(), line.end(), '\n'), line.end());
-
-        // Lines starting with '-' and empty lines
-        // are ignored and can be used for comments in the file
-        if (line.rfind("-", 0) != 0 && !line.empty()) {
-            // store UUIDs into filename
-            string presetFilename;
-            string uuid;
-            stringstream lineStream = stringstream(line);
-            lineStream >> presetFilename;
-            if (!createUUIDFile) {
-                lineStream >> uuid;
-                presetUUIDs[uuid] = make_pair(bank, preset);
-            }
-            tmpVector.push_back(presetFilename);
-            preset++;
-            if (tmpVector.size() == PRESETS_PER_BANK) {
-                presetBanksNames.push_back(tmpVector);
-                tmpVector.clear();
-                bank++;
-                preset = 1;
-            }
-        }
+        // Index from plain preset list first, it is used to read the UUIDs from the presets
+        presetIndex.build(presetListFileName.c_str(), false);
+        buildPresetUUIDs();
+        presetIndex.build(presetListUUIDFileName.c_str());
     }
-    if (tmpVector.size() > 0) {
-        while (tmpVector.size() < 4) {
-            Serial.println("Last bank not full, filling with last preset to get bank complete");
-            tmpVector.push_back(tmpVector.back());
-        }
-        presetBanksNames.push_back(tmpVector);
+    if (presetIndex.isJournalFull()) {
+        compactPresetList();
     }
-
-    if (createUUIDFile) {
-        buildPresetUUIDs();
+    if (presetIndex.numberOfPresets() % PRESETS_PER_BANK != 0) {
+        Serial.println("Last bank not full, filling with last preset to get bank complete");
     }
 }
 
@@ -209,8 +207,7 @@ void SparkPresetBuilder::initHWPresets() {
         Preset hwPreset = readPresetFromFile(filename);
         if (!(hwPreset.isEmpty)) {
             hwPresets.at(presetNum - 1) = hwPreset;
-            string uuid = hwPreset.uuid;
-            updatePresetListUUID(0, presetNum, uuid);
+            updateHWPresetUUID(presetNum, hwPreset.uuid);
         }
     }
 }
@@ -218,20 +215,20 @@ void SparkPresetBuilder::initHWPresets() {
 void SparkPresetBuilder::buildPresetUUIDs() {
 
     Serial.print("Building UUID file from scratch...");
-    File presetUUIDFile = LittleFS.open(presetListUUIDFileName, FILE_WRITE);
+    File presetUUIDFile = SPARK_FS.open(presetListUUIDFileName.c_str(), FILE_WRITE);
     if (!presetUUIDFile) {
         Serial.println("ERROR: Could not open preset UUID file");
     }
 
-    for (int bnk = 1; bnk <= getNumberOfBanks(); bnk++) {
-        for (int pre = 1; pre <= PRESETS_PER_BANK; pre++) {
-            Preset tmpPreset = getPreset(bnk, pre);
-            string uuid = tmpPreset.uuid;
-            string presetName = presetBanksNames[bnk - 1][pre - 1];
-            string printLine = presetName + " " + uuid + "\n";
-            presetUUIDFile.print(printLine.c_str());
-            presetUUIDs[uuid] = make_pair(bnk, pre);
+    PresetIndexRecord record;
+    for (int position = 0; position < presetIndex.numberOfPresets(); position++) {
+        if (!presetIndex.getRecord(position, record)) {
+            continue;
         }
+        string presetName = record.filename;
+        Preset tmpPreset = readPresetFromFile(presetName);
+        string printLine = presetName + " " + tmpPreset.uuid + "\n";
+        presetUUIDFile.print(printLine.c_str());
     }
     presetUUIDFile.close();
     Serial.println("done.");
@@ -256,32 +253,52 @@ Preset SparkPresetBuilder::getPreset(int bank, int pre) {
             return retPreset;
         }
 
-        if (bank > presetBanksNames.size()) {
+        if (bank > getNumberOfBanks()) {
             Serial.println("Requested bank out of bounds.");
             return retPreset;
         }
 
-        string presetFilename = presetBanksNames[bank - 1][pre - 1];
+        // Last bank is filled up with the last preset
+        int position = min(PRESETS_PER_BANK * (bank - 1) + pre - 1, presetIndex.numberOfPresets() - 1);
+        PresetIndexRecord record;
+        if (!presetIndex.getRecord(position, record)) {
+            return retPreset;
+        }
+        string presetFilename = record.filename;
         DEBUG_PRINTF("Reading preset filename: %s\n", presetFilename.c_str());
         return readPresetFromFile(presetFilename);
     }
     return retPreset;
 }
 
+void SparkPresetBuilder::getPreset(int bank, int pre, Preset &preset) {
+    if (bank == 0 && pre >= 1 && pre <= (int)hwPresets.size()) {
+        DEBUG_PRINTF("Getting preset number %d - %02d\n", bank, pre);
+        preset = hwPresets.at(pre - 1);
+        return;
+    }
+    preset = getPreset(bank, pre);
+}
+
 pair<int, int> SparkPresetBuilder::getBankPresetNumFromUUID(string uuid) {
-    pair<int, int> result;
-    try {
-        result = presetUUIDs.at(uuid);
-        DEBUG_PRINTF("Found UUID %s as preset %d - %d\n", uuid.c_str(), std::get<0>(result), std::get<1>(result));
-    } catch (std::out_of_range exception) {
-        Serial.print("Preset not found.");
-        result = make_pair(0, 0);
+    pair<int, int> result = make_pair(0, 0);
+    auto hwPresetUUID = hwPresetUUIDs.find(uuid);
+    if (hwPresetUUID != hwPresetUUIDs.end()) {
+        result = make_pair(0, hwPresetUUID->second);
+    } else {
+        int position = presetIndex.findUUID(uuid);
+        if (position < 0) {
+            Serial.print("Preset not found.");
+            return result;
+        }
+        result = make_pair(position / PRESETS_PER_BANK + 1, position % PRESETS_PER_BANK + 1);
     }
+    DEBUG_PRINTF("Found UUID %s as preset %d - %d\n", uuid.c_str(), std::get<0>(result), std::get<1>(result));
     return result;
 }
 
 const int SparkPresetBuilder::getNumberOfBanks() const {
-    return presetBanksNames.size();
+    return (presetIndex.numberOfPresets() + PRESETS_PER_BANK - 1) / PRESETS_PER_BANK;
 }
 
 PresetStoreResult SparkPresetBuilder::storePreset(Preset newPreset, int bnk, int pre) {
@@ -292,169 +309,53 @@ PresetStoreResult SparkPresetBuilder::storePreset(Preset newPreset, int bnk, int
     }
 
     string presetFileName = processFilename(presetNamePrefix, newPreset);
-
-    // Then insert the preset into the right position
-    string filestrPreset = "";
-    string filestrPresetUUID = "";
-    string oldListFile;
-    int lineCount = 1;
-    int insertPosition = 4 * (bnk - 1) + pre;
-
-    File presetListFile;
-    File presetUUIDListFile;
-    presetUUIDListFile = LittleFS.open(presetListUUIDFileName);
-    if (!presetUUIDListFile) {
-        Serial.println("ERROR while trying to open presets list file");
-        return STORE_PRESET_ERROR_OPEN;
-    }
-
-    string fileContent;
-    if (presetUUIDListFile) {
-        size_t size = presetUUIDListFile.size();
-        if (size > 0) {
-            fileContent.reserve(size);
-            std::unique_ptr<char[]> buf(new char[size + 1]);
-            presetUUIDListFile.readBytes(buf.get(), size);
-            buf[size] = '\0';
-            fileContent.assign(buf.get(), size);
-        }
+    // Preset list stores names without directory
+    if (presetFileName.rfind(path(""), 0) == 0) {
+        presetFileName.erase(0, path("").size());
     }
 
-    stringstream stream(fileContent);
-    string line;
-
-    while (getline(stream, line)) {
-        string preset;
-        string uuid;
-        stringstream(line) >> preset >> uuid;
-        if (lineCount != insertPosition) {
-            // Lines starting with '-' and empty lines
-            // are ignored and can be used for comments in the file
-            if (line.rfind("-", 0) != 0 && !line.empty()) {
-                if (((lineCount - 1) % 4) == 0) {
-                    // New bank separator addd to file for better readability
-                    char bankString[20] = "";
-                    int size = sizeof bankString;
-                    snprintf(bankString, size, "%d ", ((lineCount - 1) / 4) + 1);
-                    filestrPreset += "-- Bank ";
-                    filestrPreset += bankString;
-                    filestrPreset += "\n";
-                }
-                lineCount++;
-                filestrPreset += preset + "\n";
-                filestrPresetUUID += preset + " " + uuid + "\n";
-            }
-        } else {
-            filestrPreset += presetFileName + "\n";
-            filestrPresetUUID += presetFileName + " " + presetUUID + "\n";
-            // Adding old line so it is not lost.
-            filestrPreset += preset + "\n";
-            filestrPresetUUID += preset + " " + uuid + "\n";
-            lineCount++;
-        }
-    }
-    presetListFile = LittleFS.open(presetListFileName, FILE_WRITE);
-    presetUUIDListFile = LittleFS.open(presetListUUIDFileName, FILE_WRITE);
-    if (!presetListFile || !presetUUIDListFile) {
-        Serial.println("ERROR while trying to open presets list files for writing.");
+    // Then insert the preset into the right position, presets at and
+    // after that position are moved back by one
+    int insertPosition = min(PRESETS_PER_BANK * (bnk - 1) + pre - 1, presetIndex.numberOfPresets());
+    if (!presetIndex.insert(insertPosition, presetFileName, presetUUID)) {
+        Serial.println("ERROR while trying to add preset to preset journal.");
         return STORE_PRESET_ERROR_OPEN;
     }
-    bool success = presetListFile.print(filestrPreset.c_str()) && presetUUIDListFile.print(filestrPresetUUID.c_str());
-    presetListFile.close();
-    presetUUIDListFile.close();
-    if (success) {
-        Serial.printf("Successfully stored new preset to %d-%d\n", bnk, pre);
-        initializePresetListFromFS();
-        return STORE_PRESET_OK;
+    Serial.printf("Successfully stored new preset to %d-%d\n", bnk, pre);
+    if (presetIndex.isJournalFull()) {
+        compactPresetList();
     }
-    return STORE_PRESET_UNKNOWN_ERROR;
+    return STORE_PRESET_OK;
 }
 
 PresetDeleteResult SparkPresetBuilder::deletePreset(int bnk, int pre) {
 
-    // Remove the preset
-    string filestrPreset = "";
-    string filestrPresetUUID = "";
-    File presetListFile;
-    File presetListUUIDFile;
-
-    string presetFileToDelete = "";
-    int lineCount = 1;
-    int presetCount = 1;
-    int deletePosition = 4 * (bnk - 1) + pre;
-    presetListUUIDFile = LittleFS.open(presetListUUIDFileName);
-    if (!presetListUUIDFile) {
-        Serial.println("ERROR while trying to open presets list file");
-        return DELETE_PRESET_ERROR_OPEN;
+    int deletePosition = PRESETS_PER_BANK * (bnk - 1) + pre - 1;
+    PresetIndexRecord record;
+    // Presets filling up the last bank are not in the list
+    if (!presetIndex.getRecord(deletePosition, record)) {
+        return DELETE_PRESET_FILE_NOT_EXIST;
     }
+    string presetFileToDelete = path(record.filename);
+    DEBUG_PRINTF("DELETE - Preset file: %s\n", presetFileToDelete.c_str());
 
-    // Read file content into stream
-    string fileContent;
-    if (presetListUUIDFile) {
-        size_t size = presetListUUIDFile.size();
-        if (size > 0) {
-            fileContent.reserve(size);
-            std::unique_ptr<char[]> buf(new char[size + 1]);
-            presetListUUIDFile.readBytes(buf.get(), size);
-            buf[size] = '\0';
-            fileContent.assign(buf.get(), size);
-        }
-    }
-    presetListUUIDFile.close();
-    stringstream stream(fileContent);
-    string line;
-
-    DEBUG_PRINTF("DELETE - File content: %s\n", fileContent.c_str());
-    string preset;
-    string uuid;
-    while (getline(stream, line)) {
-        if (lineCount != deletePosition) {
-            // Lines starting with '-' and empty lines
-            // are ignored and can be used for comments in the file
-            if (line.rfind("-", 0) != 0 && !line.empty()) {
-                stringstream(line) >> preset >> uuid;
-                if (((lineCount - 1) % 4) == 0) {
-                    // New bank separator added to file for better readability
-                    char bankString[20] = "";
-                    int size = sizeof bankString;
-                    snprintf(bankString, size, "%d ", ((lineCount - 1) / 4) + 1);
-                    filestrPreset += "-- Bank ";
-                    filestrPreset += bankString;
-                    filestrPreset += "\n";
-                }
-                filestrPreset += preset + "\n";
-                filestrPresetUUID += preset + " " + uuid + "\n";
-                lineCount++;
-                presetCount++;
-            }
-        } else {
-            // Just increase the line counter, so deleted line
-            // does not get into new content.
-            // presetCounter not increased to count presets properly
-            stringstream(line) >> preset >> uuid;
-            presetFileToDelete = "/" + preset;
-            lineCount++;
-        }
-    }
-    presetListFile = LittleFS.open(presetListFileName, FILE_WRITE);
-    presetListUUIDFile = LittleFS.open(presetListUUIDFileName, FILE_WRITE);
-    if (!presetListFile || !presetListUUIDFile) {
-        Serial.println("ERROR opening preset files for writing.");
+    if (!presetIndex.remove(deletePosition)) {
+        Serial.println("ERROR while trying to remove preset from preset journal.");
         return DELETE_PRESET_ERROR_OPEN;
     }
-    bool success = presetListFile.print(filestrPreset.c_str()) && presetListUUIDFile.print(filestrPresetUUID.c_str());
-    presetListFile.close();
-    presetListUUIDFile.close();
-    if (success) {
-        initializePresetListFromFS();
+    if (presetIndex.isJournalFull()) {
+        compactPresetList();
+    }
 
-        if (LittleFS.remove(presetFileToDelete.c_str())) {
-            return DELETE_PRESET_OK;
-        } else {
-            return DELETE_PRESET_FILE_NOT_EXIST;
-        }
+    if (SPARK_FS.remove(presetFileToDelete.c_str())) {
+        return DELETE_PRESET_OK;
+    } else {
+        return DELETE_PRESET_FILE_NOT_EXIST;
     }
-    return DELETE_PRESET_UNKNOWN_ERROR;
+}
+
+bool SparkPresetBuilder::compactPresetList() {
+    return presetIndex.compact(presetListFileName.c_str(), presetListUUIDFileName.c_str(), PRESETS_PER_BANK);
 }
 
 void SparkPresetBuilder::insertHWPreset(int number, const Preset &preset) {
@@ -466,14 +367,16 @@ void SparkPresetBuilder::insertHWPreset(int number, const Preset &preset) {
     hwPresets.at(number) = preset;
     string filename = "HW" + to_string(number + 1) + "_" + SparkStatus::getInstance().ampSerialNumber();
     processFilename(filename, preset, true);
-    string uuid = preset.uuid;
-    updatePresetListUUID(0, number + 1, uuid);
+    updateHWPresetUUID(number + 1, preset.uuid);
 }
 
 string SparkPresetBuilder::processFilename(string filename, const Preset &preset, bool overwrite) {
 
-    Serial.println("Saving preset:");
-    Serial.println(preset.json.c_str());
+    if (LOG_ENABLED(LOG_LEVEL_INFO)) {
+        LOG_INFO("Saving preset:\n");
+        preset.writeJson(SPARK_LOG);
+        LOG_INFO("\n");
+    }
     string presetNameWithPath;
     // remove any blanks from the name for a new filename
 
@@ -490,9 +393,9 @@ string SparkPresetBuilder::processFilename(string filename, const Preset &preset
     string presetFileName = filename + ".json";
     int counter = 0;
 
-    presetFileName = "/" + presetFileName;
+    presetFileName = path(presetFileName);
     Serial.printf("Store preset with filename %s\n", presetFileName.c_str());
-    File presetFile = LittleFS.open(presetFileName.c_str());
+    File presetFile = SPARK_FS.open(presetFileName.c_str());
 
     if (!overwrite) {
         while (presetFile && presetFile.size() != 0) {
@@ -501,17 +404,19 @@ string SparkPresetBuilder::processFilename(string filename, const Preset &preset
             char counterStr[2];
             int size = sizeof counterStr;
             snprintf(counterStr, size, "%d", counter);
-            presetFileName = filename + counterStr + ".json";
+            presetFileName = path(filename + counterStr + ".json");
             presetFile.close();
-            presetFile = LittleFS.open(presetFileName.c_str());
+            presetFile = SPARK_FS.open(presetFileName.c_str());
         }
     }
     presetFile.close();
-    presetFile = LittleFS.open(presetFileName.c_str(), FILE_WRITE);
+    presetFile = SPARK_FS.open(presetFileName.c_str(), FILE_WRITE);
     // Store the json string to a new file
-    presetFile.print(preset.json.c_str());
+    unsigned long startTime = micros();
+    preset.writeJson(presetFile);
     presetFile.close();
-    presetFile = LittleFS.open(presetFileName.c_str());
+    DEBUG_PRINTF("Preset written in %lu us\n", micros() - startTime);
+    presetFile = SPARK_FS.open(presetFileName.c_str());
     presetFile.close();
     return presetFileName;
 }
@@ -521,15 +426,17 @@ Preset SparkPresetBuilder::readPresetFromFile(string fname) {
     Preset retPreset;
     string presetJsonString;
 
-    string fullFilename = "/" + fname;
+    string fullFilename = path(fname);
     // DEBUG_PRINTF("Trying to read preset %s ...", fullFilename.c_str());
-    File file = LittleFS.open(fullFilename.c_str());
+    File file = SPARK_FS.open(fullFilename.c_str());
     if (file) {
+        unsigned long startTime = micros();
         retPreset = getPresetFromJson(file);
         file.close();
 
-        DEBUG_PRINTLN("done.");
-        DEBUG_PRINTF("Preset read: %s\n", retPreset.json.c_str());
+        DEBUG_PRINTF("done in %lu us (free heap: %d, min free heap: %d).\n",
+                     micros() - startTime, ESP.getFreeHeap(), ESP.getMinFreeHeap());
+        DEBUG_PRINTF("Preset read: %s\n", retPreset.name.c_str());
         return retPreset;
     } else {
         Serial.printf("Error while opening file %s, returning empty preset.\n", fullFilename.c_str());
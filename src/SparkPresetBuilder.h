@@ -10,15 +10,17 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include <LittleFS.h>
 #include <algorithm>
 #include <regex>
 
 #include "Config_Definitions.h"
 
+#include "SparkFileSystem.h"
 #include "SparkHelper.h"
+#include "SparkPresetIndex.h"
 #include "SparkStatus.h"
 #include "SparkTypes.h"
+#include "StringBuilder.h"
 
 const int PRESETS_PER_BANK = 4;
 
@@ -42,24 +44,37 @@ using ByteVector = vector<byte>;
 class SparkPresetBuilder {
 
 private:
-    vector<vector<string>> presetBanksNames;
-    std::map<string, pair<int, int>> presetUUIDs;
+    // Custom presets are looked up via the on-flash index,
+    // HW preset UUIDs are kept in RAM as there are only a few
+    SparkPresetIndex presetIndex;
+    std::map<string, int> hwPresetUUIDs;
     vector<Preset> hwPresets;
 
+    // Document reused for parsing presets, the filter drops all keys not used in presets
+    JsonDocument presetDoc;
+    JsonDocument presetFilter;
+    void initPresetFilter();
+
     int numberOfHWBanks_ = 1;
     int numberOfHWPresets_ = PRESETS_PER_BANK;
 
-    const char *presetListFileName = "/PresetList.txt";
-    const char *presetListUUIDFileName = "/PresetListUUIDs.txt";
+    // Directory of the preset list and the custom presets, empty for the root
+    string directory_;
+    string presetListFileName = "/PresetList.txt";
+    string presetListUUIDFileName = "/PresetListUUIDs.txt";
+    string path(const string &fileName) const { return directory_ + "/" + fileName; }
     bool deletePresetFile(int bnk, int pre);
-    void updatePresetListUUID(int bnk, int pre, string uuid);
+    void updateHWPresetUUID(int pre, const string &uuid);
     void initializePresetListFromFS();
+    bool compactPresetList();
 
     void buildPresetUUIDs();
 
 public:
     SparkPresetBuilder();
-    // string getJsonFromPreset(preset pset);
+    // Preset list and custom presets are read from and written to this directory instead
+    // of the root, e.g. a scratch directory for the storage benchmarks. Call before init().
+    void setDirectory(const string &directory);
     void init();
     void initHWPresets();
 
@@ -71,11 +86,15 @@ public:
 
     void validateChecksums(vector<byte> checksums);
     Preset getPreset(int bank, int preset);
+    // Same as above, assigns to preset. Its strings keep their capacity, so a
+    // HW preset is copied without allocations once preset has held one before.
+    void getPreset(int bank, int pre, Preset &preset);
     pair<int, int> getBankPresetNumFromUUID(string uuid);
     const int getNumberOfBanks() const;
-    Preset getPresetFromJson(char *json);
+    const int numberOfPresets() const { return presetIndex.numberOfPresets(); }
+    Preset getPresetFromJson(const char *json);
     Preset getPresetFromJson(File file);
-    Preset getPresetFromJsonDocument(JsonDocument doc, string jsonString);
+    Preset getPresetFromJsonDocument(const JsonDocument &doc);
     PresetStoreResult storePreset(Preset newPreset, int bnk, int pre);
     PresetDeleteResult deletePreset(int bnk, int pre);
 
@@ -1,4 +1,5 @@
 #include "SparkPresetControl.h"
+#include "SparkHeapAudit.h"
 
 SparkPresetControl::SparkPresetControl() {
 }
@@ -236,7 +237,7 @@ void SparkPresetControl::updatePendingWithActive() {
 
 void SparkPresetControl::setActiveHWPreset() {
 
-    activePreset_ = presetBuilder.getPreset(pendingBank_, pendingPresetNum_);
+    presetBuilder.getPreset(pendingBank_, pendingPresetNum_, activePreset_);
     activePresetNum_ = pendingPresetNum_;
     activeHWBank_ = pendingHWBank_;
     if (activePreset_.isEmpty) {
@@ -272,7 +273,8 @@ bool SparkPresetControl::switchPreset(int pre, bool isInitial) {
             if (bnk == 0) {
                 int presetNum = pre + pendingHWBank_ * PRESETS_PER_BANK;
                 Serial.printf("Changing to HW preset %d...", presetNum);
-                pendingPreset_ = presetBuilder.getPreset(bnk, presetNum);
+                TRACE_ACTION(TRACE_ACTION_HW_PRESET);
+                presetBuilder.getPreset(bnk, presetNum, pendingPreset_);
                 if (pendingPreset_.isEmpty) {
                     DEBUG_PRINTLN("Pending preset empty");
                 }
@@ -281,6 +283,7 @@ bool SparkPresetControl::switchPreset(int pre, bool isInitial) {
             // Switch to custom preset
             else {
                 Serial.printf("Changing to preset %02d-%d...", bnk, pre);
+                TRACE_ACTION(TRACE_ACTION_CUSTOM_PRESET);
                 pendingPreset_ = presetBuilder.getPreset(bnk, pre);
                 if (activePreset_.isEmpty) {
                     Serial.println("Active preset empty, initializing.");
@@ -327,35 +330,37 @@ void SparkPresetControl::updateFromSparkResponseHWPreset(int presetNum) {
     */
 }
 
-void SparkPresetControl::toggleFX(Pedal receivedEffect) {
-    DEBUG_PRINTF("Received FX: %s, Status: %s\n", receivedEffect.name, receivedEffect.isOn ? "on" : "off");
-    for (Pedal &pdl : activePreset_.pedals) {
-        if (pdl.name == receivedEffect.name) {
-            DEBUG_PRINTF("activePreset before: %s, Status: %s\n", pdl.name, pdl.isOn ? "on" : "off");
-        }
+Pedal *SparkPresetControl::findPedal(Preset &preset, const EffectName &fxName) {
+    // Known effects have a fixed position in the preset
+    FxType fxType = fxName.fxType();
+    if (fxType != INDEX_FX_INVALID && fxType < preset.pedals.size() && preset.pedals[fxType].name == fxName) {
+        return &preset.pedals[fxType];
     }
-    for (Pedal &pdl : activePreset_.pedals) {
-        if (pdl.name == receivedEffect.name) {
-            pdl.isOn = receivedEffect.isOn;
+    for (Pedal &pdl : preset.pedals) {
+        if (pdl.name == fxName) {
+            return &pdl;
         }
     }
-    for (Pedal &pdl : activePreset_.pedals) {
-        if (pdl.name == receivedEffect.name) {
-            DEBUG_PRINTF("activePreset after: %s, Status: %s\n", pdl.name, pdl.isOn ? "on" : "off");
-        }
+    return nullptr;
+}
+
+void SparkPresetControl::toggleFX(const Pedal &receivedEffect) {
+    DEBUG_PRINTF("Received FX: %s, Status: %s\n", receivedEffect.name.c_str(), receivedEffect.isOn ? "on" : "off");
+    Pedal *pdl = findPedal(activePreset_, receivedEffect.name);
+    if (pdl) {
+        DEBUG_PRINTF("activePreset before: %s, Status: %s\n", pdl->name.c_str(), pdl->isOn ? "on" : "off");
+        pdl->isOn = receivedEffect.isOn;
+        DEBUG_PRINTF("activePreset after: %s, Status: %s\n", pdl->name.c_str(), pdl->isOn ? "on" : "off");
     }
     updatePendingWithActive();
 }
 
-void SparkPresetControl::switchFXOnOff(const string fxName, bool onOff) {
+void SparkPresetControl::switchFXOnOff(const EffectName &fxName, bool onOff) {
     Serial.printf("Switching %s effect %s...", onOff ? "On" : "Off",
                   fxName.c_str());
-    for (Pedal &pdl : pendingPreset_.pedals) {
-        //    for (int i = 0; i < pendingPreset.pedals.size(); i++) {
-        if (pdl.name == fxName) {
-            pdl.isOn = onOff;
-            break;
-        }
+    Pedal *pdl = findPedal(pendingPreset_, fxName);
+    if (pdl) {
+        pdl->isOn = onOff;
     }
 }
 
@@ -392,11 +397,12 @@ void SparkPresetControl::updateFromSparkResponsePreset(bool isSpecial) {
     }
 }
 
-void SparkPresetControl::updateFromSparkResponseAmpPreset(char *presetJson) {
+void SparkPresetControl::updateFromSparkResponseAmpPreset(Preset &&preset) {
     presetEditMode_ = PRESET_EDIT_STORE;
-    appReceivedPreset_ = presetBuilder.getPresetFromJson(presetJson);
+    // Preset is taken over as decoded, JSON is only needed when storing it
+    appReceivedPreset_ = move(preset);
     DEBUG_PRINTLN("received from app:");
-    DEBUG_PRINTLN(appReceivedPreset_.json.c_str());
+    DEBUG_PRINTLN(appReceivedPreset_.name.c_str());
     presetNumToEdit_ = 0;
 }
 
@@ -520,7 +526,7 @@ bool SparkPresetControl::readLastPresetFromFile() {
 
     string fileName = lastPresetFileNamePrefix + "_" + SparkStatus::getInstance().ampSerialNumber() + ".txt";
     DEBUG_PRINTF("Reading last preset from file %s\n", fileName.c_str());
-    File file = LittleFS.open(fileName.c_str());
+    File file = SPARK_FS.open(fileName.c_str());
     if (!file) {
         Serial.println("Last preset file not found.");
         return false;
@@ -550,15 +556,22 @@ bool SparkPresetControl::writeCurrentPresetToFile() {
 
     // in case of multiple HW banks, calculate "real" preset number
     int currentPresetNum = activeHWBank_ * PRESETS_PER_BANK + activePresetNum_;
-    string currentPresetString = to_string(activeBank_) + " " + to_string(currentPresetNum);
-    DEBUG_PRINTF("Preset cached: %s\n", currentPresetString.c_str());
-
-    // Seperate cache file per amp type
-    sparkPresetFileName = lastPresetFileNamePrefix + "_" + SparkStatus::getInstance().ampSerialNumber() + ".txt";
+    char currentPresetString[24];
+    snprintf(currentPresetString, sizeof(currentPresetString), "%d %d", activeBank_, currentPresetNum);
+    DEBUG_PRINTF("Preset cached: %s\n", currentPresetString);
+
+    // Seperate cache file per amp type, built in place to reuse the capacity of the file name
+    sparkPresetFileName.assign(lastPresetFileNamePrefix);
+    sparkPresetFileName += "_";
+    sparkPresetFileName += SparkStatus::getInstance().ampSerialNumber();
+    sparkPresetFileName += ".txt";
     DEBUG_PRINTF("Storing current preset in file %s\n", sparkPresetFileName.c_str());
-    File file = LittleFS.open(sparkPresetFileName.c_str(), FILE_WRITE);
-    file.print(currentPresetString.c_str());
+    // Called on the data path of the main loop
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_STORAGE);
+    File file = SPARK_FS.open(sparkPresetFileName.c_str(), FILE_WRITE);
+    file.print(currentPresetString);
     file.close();
+    HEAP_AUDIT_SCOPE(HEAP_SCOPE_DATA);
     return true;
 }
 
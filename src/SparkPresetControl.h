@@ -15,6 +15,9 @@ enum PresetEditMode {
 class SparkDataControl;
 
 class SparkPresetControl {
+    // Benchmarks use the preset builder directly
+    friend class SparkBenchmark;
+
 public:
     static SparkPresetControl &getInstance();
     SparkPresetControl(const SparkPresetControl &) = delete; // Disable copy constructor
@@ -46,7 +49,7 @@ public:
     const bool allHWPresetsAvailable() const { return allHWPresetsAvailable_; }
 
     const int presetNumToEdit() const { return presetNumToEdit_; }
-    const string responseMsg() const { return responseMsg_; }
+    const string &responseMsg() const { return responseMsg_; }
     const PresetEditMode presetEditMode() const { return presetEditMode_; }
 
     void setAmpParameters(string ampName);
@@ -58,12 +61,12 @@ public:
     bool decreasePresetLooper();
     bool switchPreset(int pre, bool isInitial);
     void updateFromSparkResponseHWPreset(int presetNum);
-    void toggleFX(Pedal receivedEffect);
+    void toggleFX(const Pedal &receivedEffect);
     // TODO: Clean up with toggleFX
-    void switchFXOnOff(const string name, bool onOff);
+    void switchFXOnOff(const EffectName &fxName, bool onOff);
 
     void updateFromSparkResponsePreset(bool isSpecial);
-    void updateFromSparkResponseAmpPreset(char *presetJson);
+    void updateFromSparkResponseAmpPreset(Preset &&preset);
     void updateFromSparkResponseACK();
 
     void processPresetEdit(int presetNum = 0);
@@ -109,6 +112,9 @@ private:
     int lastUpdateCheck = 0;
     int updateInterval = 3000;
 
+    // Returns the pedal of the preset with the given effect, nullptr if not found
+    static Pedal *findPedal(Preset &preset, const EffectName &fxName);
+
     SparkPresetBuilder presetBuilder;
     SparkDataControl *sparkDC;
     SparkStatus &statusObject = SparkStatus::getInstance();
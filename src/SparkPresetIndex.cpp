@@ -0,0 +1,548 @@
+/*
+ * SparkPresetIndex.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkPresetIndex.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+SparkPresetIndex::SparkPresetIndex() {
+}
+
+SparkPresetIndex::~SparkPresetIndex() {
+    close();
+}
+
+bool SparkPresetIndex::build(const char *listFileName, bool withUUIDs) {
+
+    close();
+    unsigned long startTime = millis();
+
+    File listFile = SPARK_FS.open(listFileName);
+    if (!listFile) {
+        Serial.printf("ERROR while trying to open preset list file %s\n", listFileName);
+        return false;
+    }
+
+    uint32_t sourceSize = 0;
+    int sourceLines = 0;
+    uint32_t sourceHash = hashFile(listFile, sourceSize, sourceLines);
+    // A list without UUIDs is only used temporarily to rebuild the UUID list,
+    // so such an index is never regarded as current.
+    if (!withUUIDs) {
+        sourceHash = 0;
+    }
+
+    if (withUUIDs && isIndexCurrent(sourceSize, sourceHash)) {
+        listFile.close();
+        DEBUG_PRINTLN("Preset index is up to date.");
+    } else {
+        Serial.println("Building preset index.");
+        listFile.seek(0);
+        bool success = writeIndex(listFile, withUUIDs, sourceSize, sourceHash, sourceLines);
+        listFile.close();
+        if (!success) {
+            Serial.println("ERROR while writing preset index.");
+            return false;
+        }
+    }
+
+    if (!open(withUUIDs)) {
+        return false;
+    }
+    Serial.printf("Preset index with %d presets (%d journal entries) ready after %lu ms (free heap: %u bytes).\n",
+                  count_, (int)journal.size(), millis() - startTime, ESP.getFreeHeap());
+    return true;
+}
+
+void SparkPresetIndex::close() {
+    if (isOpen_) {
+        indexFile.close();
+    }
+    isOpen_ = false;
+    header_ = {};
+    count_ = 0;
+    journal.clear();
+    invalidateCache();
+}
+
+void SparkPresetIndex::setDirectory(const string &directory) {
+    close();
+    indexFileName = directory + "/PresetIndex.bin";
+    journalFileName = directory + "/PresetList.journal";
+}
+
+uint32_t SparkPresetIndex::hashBytes(const byte *data, size_t size, uint32_t hash) {
+    // FNV-1a hash, used to detect changes of the preset list and torn journal entries
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t SparkPresetIndex::hashFile(File &file, uint32_t &size, int &lines) {
+    uint32_t hash = hashBytes(nullptr, 0);
+    byte buf[64];
+    size = 0;
+    lines = 0;
+    byte lastByte = '\n';
+    size_t bytesRead;
+    while ((bytesRead = file.read(buf, sizeof buf)) > 0) {
+        hash = hashBytes(buf, bytesRead, hash);
+        size += bytesRead;
+        lines += count(buf, buf + bytesRead, '\n');
+        lastByte = buf[bytesRead - 1];
+    }
+    // Last line without newline
+    if (lastByte != '\n') {
+        lines++;
+    }
+    return hash;
+}
+
+bool SparkPresetIndex::isIndexCurrent(uint32_t sourceSize, uint32_t sourceHash) {
+    File file = SPARK_FS.open(indexFileName.c_str());
+    if (!file) {
+        return false;
+    }
+    PresetIndexHeader header;
+    bool isCurrent = file.read((byte *)&header, sizeof header) == sizeof header
+                     && header.magic == indexMagic
+                     && header.version == indexVersion
+                     && header.sourceSize == sourceSize
+                     && header.sourceHash == sourceHash
+                     && file.size() == sizeof header + header.count * (sizeof(PresetIndexRecord) + sizeof(PresetIndexUUIDRecord));
+    file.close();
+    return isCurrent;
+}
+
+void SparkPresetIndex::copyField(char *dest, const char *src, int size) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+bool SparkPresetIndex::parseLine(char *line, char *filename, char *uuid) {
+    // Lines starting with '-' and empty lines
+    // are ignored and can be used for comments in the file
+    if (line[0] == '-') {
+        return false;
+    }
+    char *savePtr;
+    char *token = strtok_r(line, " \t\r", &savePtr);
+    if (token == nullptr) {
+        return false;
+    }
+    copyField(filename, token, PRESET_INDEX_FILENAME_SIZE);
+    token = strtok_r(nullptr, " \t\r", &savePtr);
+    copyField(uuid, token == nullptr ? "" : token, PRESET_INDEX_UUID_SIZE);
+    return true;
+}
+
+uint32_t SparkPresetIndex::hashUUID(const char *uuid) {
+    return hashBytes((const byte *)uuid, strnlen(uuid, PRESET_INDEX_UUID_SIZE));
+}
+
+bool SparkPresetIndex::readLine(File &file, char *line, size_t size) {
+    size_t length = file.readBytesUntil('\n', line, size - 1);
+    line[length] = '\0';
+    if (length < size - 1) {
+        return true;
+    }
+    // Buffer is full: the rest of the line is skipped so it is not read as another record.
+    // The line still fits if only the line end follows.
+    bool isTooLong = false;
+    int next;
+    while ((next = file.read()) >= 0 && next != '\n') {
+        if (next != '\r') {
+            isTooLong = true;
+        }
+    }
+    return !isTooLong;
+}
+
+bool SparkPresetIndex::writeIndex(File &listFile, bool withUUIDs, uint32_t sourceSize, uint32_t sourceHash, int sourceLines) {
+
+    File file = SPARK_FS.open(indexFileName.c_str(), FILE_WRITE);
+    if (!file) {
+        return false;
+    }
+
+    // Header is written again with magic and final count at the end. Without the magic,
+    // an interrupted write cannot be taken for a valid (empty) index.
+    PresetIndexHeader header = {};
+    header.version = indexVersion;
+    header.sourceSize = sourceSize;
+    header.sourceHash = sourceHash;
+    bool success = file.write((byte *)&header, sizeof header) == sizeof header;
+
+    // UUID records are only held in RAM while building to sort them. Reserved
+    // up front, growing the vector would need up to three times the memory.
+    vector<PresetIndexUUIDRecord> uuidRecords;
+    uuidRecords.reserve(sourceLines);
+    char line[128];
+    int lineNumber = 0;
+    while (success && listFile.available()) {
+        lineNumber++;
+        if (!readLine(listFile, line, sizeof line)) {
+            Serial.printf("ERROR: Line %d of preset list is longer than %d characters, skipped.\n", lineNumber,
+                          (int)sizeof line - 1);
+            continue;
+        }
+        PresetIndexRecord record = {};
+        if (!parseLine(line, record.filename, record.uuid)) {
+            continue;
+        }
+        if (!withUUIDs) {
+            record.uuid[0] = '\0';
+        }
+        PresetIndexUUIDRecord uuidRecord = {};
+        uuidRecord.uuidHash = hashUUID(record.uuid);
+        uuidRecord.position = header.count;
+        uuidRecords.push_back(uuidRecord);
+
+        success = file.write((byte *)&record, sizeof record) == sizeof record;
+        header.count++;
+    }
+
+    sort(uuidRecords.begin(), uuidRecords.end(),
+         [](const PresetIndexUUIDRecord &a, const PresetIndexUUIDRecord &b) {
+             return a.uuidHash < b.uuidHash || (a.uuidHash == b.uuidHash && a.position < b.position);
+         });
+    for (const PresetIndexUUIDRecord &uuidRecord : uuidRecords) {
+        if (!success) {
+            break;
+        }
+        success = file.write((byte *)&uuidRecord, sizeof uuidRecord) == sizeof uuidRecord;
+    }
+
+    header.magic = indexMagic;
+    success = success && file.seek(0) && file.write((byte *)&header, sizeof header) == sizeof header;
+    file.close();
+    return success;
+}
+
+bool SparkPresetIndex::open(bool withJournal) {
+    indexFile = SPARK_FS.open(indexFileName.c_str());
+    if (!indexFile) {
+        Serial.println("ERROR while trying to open preset index.");
+        return false;
+    }
+    if (indexFile.read((byte *)&header_, sizeof header_) != sizeof header_ || header_.magic != indexMagic) {
+        Serial.println("ERROR: Preset index is corrupt.");
+        indexFile.close();
+        header_ = {};
+        return false;
+    }
+    isOpen_ = true;
+    count_ = header_.count;
+    invalidateCache();
+    if (withJournal) {
+        loadJournal();
+    } else if (SPARK_FS.exists(journalFileName.c_str())) {
+        SPARK_FS.remove(journalFileName.c_str());
+    }
+    return true;
+}
+
+void SparkPresetIndex::loadJournal() {
+    journal.clear();
+    if (!SPARK_FS.exists(journalFileName.c_str())) {
+        return;
+    }
+    File file = SPARK_FS.open(journalFileName.c_str());
+    if (!file) {
+        return;
+    }
+    PresetJournalHeader header;
+    if (file.read((byte *)&header, sizeof header) != sizeof header
+        || header.magic != journalMagic
+        || header.version != journalVersion
+        || header.sourceSize != header_.sourceSize
+        || header.sourceHash != header_.sourceHash) {
+        // Journal has already been compacted into the preset list or is unreadable
+        Serial.println("Discarding outdated preset journal.");
+        file.close();
+        SPARK_FS.remove(journalFileName.c_str());
+        return;
+    }
+
+    bool isTorn = false;
+    PresetJournalEntry entry;
+    while (file.available()) {
+        if (file.read((byte *)&entry, sizeof entry) != sizeof entry
+            || entry.checksum != hashBytes((byte *)&entry, offsetof(PresetJournalEntry, checksum))) {
+            isTorn = true;
+            break;
+        }
+        journal.push_back(entry);
+        count_ += entry.operation == PRESET_JOURNAL_INSERT ? 1 : -1;
+    }
+    file.close();
+
+    if (isTorn) {
+        // Last write was interrupted, rewrite journal with the valid entries only. Written to
+        // a temporary file first, an interrupted rewrite must not lose the valid entries.
+        Serial.println("ERROR: Preset journal incomplete, dropping last entry.");
+        string journalTmpFileName = tmpFileName(journalFileName.c_str());
+        file = SPARK_FS.open(journalTmpFileName.c_str(), FILE_WRITE);
+        bool success = file && file.write((byte *)&header, sizeof header) == sizeof header;
+        for (const PresetJournalEntry &validEntry : journal) {
+            success = success && file.write((byte *)&validEntry, sizeof validEntry) == sizeof validEntry;
+        }
+        file.close();
+        if (!success || !SPARK_FS.rename(journalTmpFileName.c_str(), journalFileName.c_str())) {
+            Serial.println("ERROR while rewriting preset journal.");
+        }
+    }
+}
+
+bool SparkPresetIndex::appendJournal(PresetJournalEntry &entry) {
+    if (!isOpen_) {
+        return false;
+    }
+    entry.checksum = hashBytes((byte *)&entry, offsetof(PresetJournalEntry, checksum));
+
+    File file = SPARK_FS.open(journalFileName.c_str(), FILE_APPEND);
+    if (!file) {
+        Serial.println("ERROR while trying to open preset journal.");
+        return false;
+    }
+    bool success = true;
+    if (file.size() == 0) {
+        PresetJournalHeader header = {};
+        header.magic = journalMagic;
+        header.version = journalVersion;
+        header.sourceSize = header_.sourceSize;
+        header.sourceHash = header_.sourceHash;
+        success = file.write((byte *)&header, sizeof header) == sizeof header;
+    }
+    success = success && file.write((byte *)&entry, sizeof entry) == sizeof entry;
+    file.close();
+    if (!success) {
+        Serial.println("ERROR while writing preset journal.");
+        return false;
+    }
+    journal.push_back(entry);
+    count_ += entry.operation == PRESET_JOURNAL_INSERT ? 1 : -1;
+    return true;
+}
+
+void SparkPresetIndex::invalidateCache() {
+    for (CachePage &page : cache) {
+        page.section = -1;
+        page.page = -1;
+        page.lastUsed = 0;
+    }
+    cacheTick = 0;
+}
+
+int SparkPresetIndex::recordSize(int section) const {
+    return section == 0 ? sizeof(PresetIndexRecord) : sizeof(PresetIndexUUIDRecord);
+}
+
+uint32_t SparkPresetIndex::sectionOffset(int section) const {
+    uint32_t offset = sizeof(PresetIndexHeader);
+    if (section == 1) {
+        offset += header_.count * sizeof(PresetIndexRecord);
+    }
+    return offset;
+}
+
+bool SparkPresetIndex::readRecord(int section, int num, void *record) {
+    if (!isOpen_ || num < 0 || num >= header_.count) {
+        return false;
+    }
+    int size = recordSize(section);
+    int recordsPerPage = PRESET_INDEX_PAGE_SIZE / size;
+    int pageNum = num / recordsPerPage;
+
+    // Find page in cache, otherwise replace least recently used one
+    CachePage *page = &cache[0];
+    for (CachePage &candidate : cache) {
+        if (candidate.section == section && candidate.page == pageNum) {
+            page = &candidate;
+            break;
+        }
+        if (candidate.lastUsed < page->lastUsed) {
+            page = &candidate;
+        }
+    }
+    if (page->section != section || page->page != pageNum) {
+        int firstRecord = pageNum * recordsPerPage;
+        size_t bytesToRead = min(recordsPerPage, header_.count - firstRecord) * size;
+        if (!indexFile.seek(sectionOffset(section) + firstRecord * size)
+            || indexFile.read(page->data, bytesToRead) != bytesToRead) {
+            Serial.println("ERROR while reading preset index.");
+            page->section = -1;
+            page->page = -1;
+            return false;
+        }
+        page->section = section;
+        page->page = pageNum;
+    }
+    page->lastUsed = ++cacheTick;
+    memcpy(record, page->data + (num % recordsPerPage) * size, size);
+    return true;
+}
+
+bool SparkPresetIndex::getRecord(int position, PresetIndexRecord &record) {
+    if (position < 0 || position >= count_) {
+        return false;
+    }
+    // Walk back through the journal to find the position in the index file
+    for (int i = journal.size() - 1; i >= 0; i--) {
+        const PresetJournalEntry &entry = journal[i];
+        if (entry.operation == PRESET_JOURNAL_INSERT) {
+            if (position == entry.position) {
+                record = entry.record;
+                return true;
+            }
+            if (position > entry.position) {
+                position--;
+            }
+        } else if (position >= entry.position) {
+            position++;
+        }
+    }
+    return readRecord(0, position, &record);
+}
+
+int SparkPresetIndex::mapJournalPosition(int position, int firstEntry) const {
+    // Apply journal entries starting at firstEntry to a position,
+    // returns -1 if the preset has been deleted
+    for (int i = firstEntry; i < (int)journal.size(); i++) {
+        const PresetJournalEntry &entry = journal[i];
+        if (entry.operation == PRESET_JOURNAL_INSERT) {
+            if (position >= entry.position) {
+                position++;
+            }
+        } else if (position == entry.position) {
+            return -1;
+        } else if (position > entry.position) {
+            position--;
+        }
+    }
+    return position;
+}
+
+int SparkPresetIndex::findUUID(const string &uuid) {
+    if (uuid.empty()) {
+        return -1;
+    }
+    // Most recently inserted presets first
+    for (int i = journal.size() - 1; i >= 0; i--) {
+        const PresetJournalEntry &entry = journal[i];
+        if (entry.operation == PRESET_JOURNAL_INSERT
+            && strncmp(uuid.c_str(), entry.record.uuid, PRESET_INDEX_UUID_SIZE) == 0) {
+            int position = mapJournalPosition(entry.position, i + 1);
+            if (position >= 0) {
+                return position;
+            }
+        }
+    }
+
+    // First record with the hash of the UUID, then all records with the same hash
+    uint32_t uuidHash = hashUUID(uuid.c_str());
+    int low = 0;
+    int high = header_.count;
+    PresetIndexUUIDRecord uuidRecord;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (!readRecord(1, mid, &uuidRecord)) {
+            return -1;
+        }
+        if (uuidRecord.uuidHash < uuidHash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    PresetIndexRecord record;
+    for (int num = low; num < header_.count; num++) {
+        if (!readRecord(1, num, &uuidRecord) || uuidRecord.uuidHash != uuidHash) {
+            break;
+        }
+        if (readRecord(0, uuidRecord.position, &record)
+            && strncmp(uuid.c_str(), record.uuid, PRESET_INDEX_UUID_SIZE) == 0) {
+            return mapJournalPosition(uuidRecord.position, 0);
+        }
+    }
+    return -1;
+}
+
+bool SparkPresetIndex::insert(int position, const string &filename, const string &uuid) {
+    if (position < 0 || position > count_) {
+        return false;
+    }
+    PresetJournalEntry entry = {};
+    entry.operation = PRESET_JOURNAL_INSERT;
+    entry.position = position;
+    copyField(entry.record.filename, filename.c_str(), PRESET_INDEX_FILENAME_SIZE);
+    copyField(entry.record.uuid, uuid.c_str(), PRESET_INDEX_UUID_SIZE);
+    return appendJournal(entry);
+}
+
+bool SparkPresetIndex::remove(int position) {
+    if (position < 0 || position >= count_) {
+        return false;
+    }
+    PresetJournalEntry entry = {};
+    entry.operation = PRESET_JOURNAL_DELETE;
+    entry.position = position;
+    return appendJournal(entry);
+}
+
+string SparkPresetIndex::tmpFileName(const char *fileName) {
+    return string(fileName) + ".tmp";
+}
+
+bool SparkPresetIndex::compact(const char *listFileName, const char *uuidListFileName, int presetsPerBank) {
+    // Write the current preset list including all journal changes to temporary files,
+    // then replace the lists by renaming. Renaming the UUID list is the commit point:
+    // the journal only matches the old list. It is removed right after, otherwise a new
+    // list that is identical to the old one (e.g. after storing and deleting a preset)
+    // would pick up the full journal again.
+    if (!isOpen_) {
+        return false;
+    }
+    Serial.println("Compacting preset list.");
+    string listTmpFileName = tmpFileName(listFileName);
+    string uuidListTmpFileName = tmpFileName(uuidListFileName);
+    File listFile = SPARK_FS.open(listTmpFileName.c_str(), FILE_WRITE);
+    File uuidListFile = SPARK_FS.open(uuidListTmpFileName.c_str(), FILE_WRITE);
+    if (!listFile || !uuidListFile) {
+        Serial.println("ERROR while trying to open presets list files for writing.");
+        return false;
+    }
+
+    bool success = true;
+    PresetIndexRecord record;
+    for (int position = 0; success && position < count_; position++) {
+        success = getRecord(position, record);
+        if (success && position % presetsPerBank == 0) {
+            // New bank separator added to file for better readability
+            success = listFile.printf("-- Bank %d \n", position / presetsPerBank + 1) > 0;
+        }
+        success = success
+                  && listFile.printf("%s\n", record.filename) > 0
+                  && uuidListFile.printf("%s %s\n", record.filename, record.uuid) > 0;
+    }
+    listFile.close();
+    uuidListFile.close();
+
+    success = success
+              && SPARK_FS.rename(listTmpFileName.c_str(), listFileName)
+              && SPARK_FS.rename(uuidListTmpFileName.c_str(), uuidListFileName);
+    if (!success) {
+        Serial.println("ERROR while compacting preset list, keeping journal.");
+        return false;
+    }
+    SPARK_FS.remove(journalFileName.c_str());
+    return build(uuidListFileName);
+}
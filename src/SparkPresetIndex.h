@@ -0,0 +1,162 @@
+/*
+ * SparkPresetIndex.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_PRESET_INDEX_H // include guard
+#define SPARK_PRESET_INDEX_H
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+#include "Config_Definitions.h"
+#include "SparkFileSystem.h"
+
+using namespace std;
+
+// Fixed record sizes of the index file. Filenames are cut to 24 characters
+// plus counter and extension when stored, UUIDs have 36 characters.
+const int PRESET_INDEX_FILENAME_SIZE = 40;
+const int PRESET_INDEX_UUID_SIZE = 40;
+// Size of a single cached page and number of pages kept in RAM
+const int PRESET_INDEX_PAGE_SIZE = 256;
+const int PRESET_INDEX_CACHE_PAGES = 4;
+// Number of journal entries after which the preset list should be compacted
+const int PRESET_JOURNAL_MAX_ENTRIES = 16;
+
+enum PresetJournalOperation {
+    PRESET_JOURNAL_INSERT = 1,
+    PRESET_JOURNAL_DELETE = 2
+};
+
+struct PresetIndexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    // Size and hash of the preset list the index was built from
+    uint32_t sourceSize;
+    uint32_t sourceHash;
+};
+
+// One record per preset, ordered by preset position in the list
+struct PresetIndexRecord {
+    char filename[PRESET_INDEX_FILENAME_SIZE];
+    char uuid[PRESET_INDEX_UUID_SIZE];
+};
+
+// One record per preset, ordered by hash of the UUID for binary search.
+// Only the hash is stored so the records to sort fit into RAM for large lists,
+// the UUID itself is compared with the record at position.
+struct PresetIndexUUIDRecord {
+    uint32_t uuidHash;
+    uint16_t position;
+    uint16_t reserved;
+};
+
+// The journal is only valid for the preset list it was started on
+struct PresetJournalHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t sourceSize;
+    uint32_t sourceHash;
+};
+
+struct PresetJournalEntry {
+    uint8_t operation;
+    uint8_t reserved;
+    uint16_t position;
+    PresetIndexRecord record;
+    // Detects entries which have not been written completely
+    uint32_t checksum;
+};
+
+class SparkPresetIndex {
+    // On-flash index of the custom presets
+    // ------------------------------------
+    // The preset list is translated into a binary file with two sections of
+    // fixed size records: one in list order (lookup by bank/preset) and one
+    // sorted by UUID hash (binary search). Only a few pages are cached in RAM.
+    // Changes are appended to a journal and applied on top of the index
+    // until the preset list is compacted.
+
+private:
+    struct CachePage {
+        int section = -1;
+        int page = -1;
+        unsigned long lastUsed = 0;
+        byte data[PRESET_INDEX_PAGE_SIZE];
+    };
+
+    string indexFileName = "/PresetIndex.bin";
+    const uint32_t indexMagic = 0x58444950; // "PIDX"
+    const uint16_t indexVersion = 2;
+    string journalFileName = "/PresetList.journal";
+    const uint32_t journalMagic = 0x4C4E4A50; // "PJNL"
+    const uint16_t journalVersion = 1;
+
+    File indexFile;
+    PresetIndexHeader header_ = {};
+    bool isOpen_ = false;
+    // Number of presets including journal changes
+    int count_ = 0;
+    vector<PresetJournalEntry> journal;
+
+    CachePage cache[PRESET_INDEX_CACHE_PAGES];
+    unsigned long cacheTick = 0;
+
+    static uint32_t hashBytes(const byte *data, size_t size, uint32_t hash = 2166136261u);
+    static uint32_t hashFile(File &file, uint32_t &size, int &lines);
+    // Reads a line of the preset list, false if it does not fit into the buffer
+    static bool readLine(File &file, char *line, size_t size);
+    static bool parseLine(char *line, char *filename, char *uuid);
+    static uint32_t hashUUID(const char *uuid);
+    static void copyField(char *dest, const char *src, int size);
+
+    bool isIndexCurrent(uint32_t sourceSize, uint32_t sourceHash);
+    bool writeIndex(File &listFile, bool withUUIDs, uint32_t sourceSize, uint32_t sourceHash, int sourceLines);
+    bool open(bool withJournal);
+    void invalidateCache();
+
+    static string tmpFileName(const char *fileName);
+
+    void loadJournal();
+    bool appendJournal(PresetJournalEntry &entry);
+    int mapJournalPosition(int position, int firstEntry) const;
+
+    int recordSize(int section) const;
+    uint32_t sectionOffset(int section) const;
+    bool readRecord(int section, int num, void *record);
+
+public:
+    SparkPresetIndex();
+    virtual ~SparkPresetIndex();
+
+    // (Re-)builds the index from the preset list file if it is outdated.
+    // If withUUIDs is false, the list only contains filenames.
+    bool build(const char *listFileName, bool withUUIDs = true);
+    void close();
+    // Directory of the index and the journal, default is the root of the file system
+    void setDirectory(const string &directory);
+
+    const int numberOfPresets() const { return count_; }
+    const bool isJournalFull() const { return journal.size() >= PRESET_JOURNAL_MAX_ENTRIES; }
+
+    // Position is the zero based index of the preset in the preset list
+    bool getRecord(int position, PresetIndexRecord &record);
+    // Returns the position of the preset with the given UUID, -1 if not found
+    int findUUID(const string &uuid);
+
+    // Journaled changes, each one is a single append to the journal file
+    bool insert(int position, const string &filename, const string &uuid);
+    bool remove(int position);
+
+    // Writes the preset list (filenames only, with bank separators) and the UUID list
+    // with all journal changes applied, removes the journal and rebuilds the index
+    bool compact(const char *listFileName, const char *uuidListFileName, int presetsPerBank);
+};
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * SparkSoakTest.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#include "SparkSoakTest.h"
+
+#ifdef SOAK_TEST
+
+#include "SparkAmpSimulator.h"
+#include "SparkDataControl.h"
+#include "SparkHeapAudit.h"
+#include "SparkLatencyTrace.h"
+#include "SparkPresetControl.h"
+
+// Looper commands cycled through by the test
+static const LooperCommand looperCommands[] = {
+    SPK_LOOPER_CMD_PLAY, SPK_LOOPER_CMD_STOP, SPK_LOOPER_CMD_DUB, SPK_LOOPER_CMD_STOP_DUB,
+    SPK_LOOPER_CMD_UNDO, SPK_LOOPER_CMD_REDO, SPK_LOOPER_CMD_DELETE};
+static const int numberOfLooperCommands = sizeof(looperCommands) / sizeof(looperCommands[0]);
+
+SparkSoakTest &SparkSoakTest::getInstance() {
+    static SparkSoakTest INSTANCE;
+    return INSTANCE;
+}
+
+void SparkSoakTest::begin() {
+    SparkAmpSimulator &simulator = SparkAmpSimulator::getInstance();
+    SimulatedAmpConfig config = simulator.config();
+    config.latency = ampLatency;
+    simulator.configure(config);
+
+    startTimestamp_ = millis();
+    lastSampleTimestamp_ = startTimestamp_;
+    isStarted_ = true;
+    Serial.println("Soak test started");
+    Serial.println("soak,time_ms,actions,timeouts,free_heap,min_free_heap,largest_block,allocations,"
+                   "allocations_per_100,timeouts_per_100,completed,pending_acks,command_capacity,pending_notifications,receive_dropped,p50_us,p99_us");
+}
+
+bool SparkSoakTest::startAction(SparkDataControl &dc, SoakAction action) {
+    SparkPresetControl &presetControl = SparkPresetControl::getInstance();
+
+    TRACE_BUTTON_PRESS();
+    switch (action) {
+    case SOAK_ACTION_BANK_AND_PRESET:
+        presetControl.increaseBank();
+        // fall through
+    case SOAK_ACTION_PRESET:
+        presetStep_ = presetStep_ % PRESETS_PER_BANK + 1;
+        return dc.switchPreset(presetStep_, false);
+    case SOAK_ACTION_FX_TOGGLE:
+        fxStep_ = (fxStep_ + 1) % Preset::numberOfPedals;
+        return dc.toggleEffect(fxStep_);
+    case SOAK_ACTION_LOOPER:
+        looperStep_ = (looperStep_ + 1) % numberOfLooperCommands;
+        return dc.sparkLooperCommand(looperCommands[looperStep_]);
+    case SOAK_ACTION_TUNER:
+        // Switched on here, switched off after tunerDuration
+        if (isTunerOn_) {
+            isTunerOn_ = false;
+            SparkDataControl::switchSubMode(subModeBeforeTuner_);
+        } else {
+            isTunerOn_ = true;
+            tunerStart_ = millis();
+            subModeBeforeTuner_ = dc.subMode();
+            SparkDataControl::switchSubMode(SUB_MODE_TUNER);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SparkSoakTest::update(SparkDataControl &dc) {
+    if (!isStarted_) {
+        return;
+    }
+    unsigned long now = millis();
+    if (now - lastSampleTimestamp_ >= sampleInterval) {
+        takeSample();
+    }
+    if (isFailed_ || !dc.isAmpConnected() || dc.isInitBoot()) {
+        return;
+    }
+
+    SparkLatencyTrace &trace = SparkLatencyTrace::getInstance();
+    if (isActionInFlight_) {
+        if (trace.completedActions() != completedActions_) {
+            completedActions_ = trace.completedActions();
+            latencies_.add(trace.lastLatency());
+        } else if (now - actionStart_ >= actionTimeout) {
+            timeouts_++;
+        } else {
+            return;
+        }
+        isActionInFlight_ = false;
+    }
+
+    SoakAction action;
+    if (isTunerOn_) {
+        // Tuner output is streamed in the meantime
+        if (now - tunerStart_ < tunerDuration) {
+            return;
+        }
+        action = SOAK_ACTION_TUNER;
+    } else {
+        action = (SoakAction)nextAction_;
+        nextAction_ = (nextAction_ + 1) % SOAK_ACTION_COUNT;
+    }
+
+    actionStart_ = now;
+    if (startAction(dc, action)) {
+        actions_++;
+        isActionInFlight_ = true;
+    } else {
+        skipped_++;
+    }
+}
+
+void SparkSoakTest::takeSample() {
+    unsigned long now = millis();
+    SoakSample sample;
+    sample.timestamp = now - startTimestamp_;
+    sample.actions = actions_;
+    sample.timeouts = timeouts_;
+    sample.freeHeap = ESP.getFreeHeap();
+    sample.minFreeHeap = ESP.getMinFreeHeap();
+    sample.largestFreeBlock = ESP.getMaxAllocHeap();
+#ifdef AUDIT_HEAP_ALLOCATIONS
+    sample.allocations = SparkHeapAudit::getInstance().totalAllocations();
+#endif
+    unsigned long intervalActions = sample.actions - lastSample_.actions;
+    if (intervalActions > 0) {
+        sample.allocationsPer100Actions = (sample.allocations - lastSample_.allocations) * 100 / intervalActions;
+        sample.timeoutsPer100Actions = (sample.timeouts - lastSample_.timeouts) * 100 / intervalActions;
+    }
+    sample.completedActions = latencies_.count();
+    sample.pendingAcks = SparkDataControl::pendingLooperAcks.size();
+    sample.commandCapacity = SparkDataControl::currentCommand.capacity();
+    sample.pendingNotifications = SparkAmpSimulator::getInstance().pendingNotifications();
+    sample.receiveDropped = SparkDataControl::receiveBuffer.dropped();
+    sample.latencyP50 = latencies_.percentile(50);
+    sample.latencyP99 = latencies_.percentile(99);
+    latencies_.reset();
+
+    printSample(sample);
+    if (sample.timestamp >= warmupTime) {
+        if (!hasBaseline_) {
+            baseline_ = sample;
+            hasBaseline_ = true;
+            Serial.println("Soak test: baseline taken");
+        } else if (!isFailed_) {
+            const char *reason = checkDrift(sample);
+            if (reason != nullptr) {
+                isFailed_ = true;
+                Serial.printf("Soak test FAILED after %lu actions (%lu s): %s\n", actions_, sample.timestamp / 1000, reason);
+            }
+        }
+    }
+    lastSample_ = sample;
+    lastSampleTimestamp_ = now;
+}
+
+const char *SparkSoakTest::checkDrift(const SoakSample &sample) const {
+    if (sample.freeHeap + maxHeapLoss < baseline_.freeHeap) {
+        return "free heap decreased";
+    }
+    if (sample.minFreeHeap + maxHeapLoss < baseline_.minFreeHeap) {
+        return "heap high-water increased";
+    }
+    if (sample.largestFreeBlock + maxLargestBlockLoss < baseline_.largestFreeBlock) {
+        return "largest free block decreased (fragmentation)";
+    }
+    if (sample.actions > lastSample_.actions && sample.completedActions == 0) {
+        // Percentiles of an empty interval are 0, so the latency check does not catch this
+        return "no action completed (amp does not answer)";
+    }
+    if (sample.timeoutsPer100Actions > baseline_.timeoutsPer100Actions + maxTimeoutIncrease) {
+        return "timeouts per action increased";
+    }
+    if (sample.allocationsPer100Actions > baseline_.allocationsPer100Actions + maxAllocationIncrease) {
+        return "allocations per action increased";
+    }
+    if (sample.pendingAcks > maxPendingAcks) {
+        return "pending acks are growing";
+    }
+    if (sample.commandCapacity > baseline_.commandCapacity) {
+        return "command buffer is growing";
+    }
+    if (sample.pendingNotifications > maxPendingNotifications) {
+        return "notifications of the amp are not processed";
+    }
+    if (sample.receiveDropped > baseline_.receiveDropped) {
+        return "receive buffer overflow";
+    }
+    if (sample.latencyP99 > baseline_.latencyP99 * maxLatencyFactor + latencyTolerance) {
+        return "p99 latency increased";
+    }
+    return nullptr;
+}
+
+void SparkSoakTest::printSample(const SoakSample &sample) {
+    Serial.printf("soak,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%d,%d,%d,%lu,%lu,%lu\n",
+                  sample.timestamp, sample.actions, sample.timeouts, (unsigned long)sample.freeHeap,
+                  (unsigned long)sample.minFreeHeap, (unsigned long)sample.largestFreeBlock, sample.allocations,
+                  (unsigned long)sample.allocationsPer100Actions, (unsigned long)sample.timeoutsPer100Actions,
+                  (unsigned long)sample.completedActions, (int)sample.pendingAcks, (int)sample.commandCapacity,
+                  (int)sample.pendingNotifications, sample.receiveDropped, (unsigned long)sample.latencyP50,
+                  (unsigned long)sample.latencyP99);
+}
+
+void SparkSoakTest::report() {
+    Serial.printf("Soak test %s: %lu actions, %lu skipped, %lu timeouts in %lu s\n",
+                  isFailed_ ? "FAILED" : "running", actions_, skipped_, timeouts_, (millis() - startTimestamp_) / 1000);
+    if (hasBaseline_) {
+        Serial.print("Baseline: ");
+        printSample(baseline_);
+    }
+    Serial.print("Last:     ");
+    printSample(lastSample_);
+}
+
+#endif
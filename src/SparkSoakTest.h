@@ -0,0 +1,139 @@
+/*
+ * SparkSoakTest.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_SOAK_TEST_H
+#define SPARK_SOAK_TEST_H
+
+#include "Config_Definitions.h"
+#include "DurationHistogram.h"
+#include <Arduino.h>
+#include <stdint.h>
+
+using namespace std;
+
+class SparkDataControl;
+
+enum SoakAction {
+    SOAK_ACTION_PRESET,
+    SOAK_ACTION_BANK_AND_PRESET,
+    SOAK_ACTION_FX_TOGGLE,
+    SOAK_ACTION_LOOPER,
+    SOAK_ACTION_TUNER,
+    SOAK_ACTION_COUNT
+};
+
+// State of the firmware at one point of the soak test
+struct SoakSample {
+    unsigned long timestamp = 0; // ms since start of the test
+    unsigned long actions = 0;
+    unsigned long timeouts = 0;
+    uint32_t freeHeap = 0;
+    uint32_t minFreeHeap = 0;
+    uint32_t largestFreeBlock = 0;
+    unsigned long allocations = 0; // only with AUDIT_HEAP_ALLOCATIONS
+    uint32_t allocationsPer100Actions = 0; // since the last sample
+    uint32_t timeoutsPer100Actions = 0;    // since the last sample
+    uint32_t completedActions = 0;         // since the last sample, with a latency
+    size_t pendingAcks = 0;
+    size_t commandCapacity = 0;
+    size_t pendingNotifications = 0;
+    unsigned long receiveDropped = 0;
+    uint32_t latencyP50 = 0; // us, actions since the last sample
+    uint32_t latencyP99 = 0;
+};
+
+class SparkSoakTest {
+    // Soak test
+    // ---------
+    // When SOAK_TEST is defined, the main loop drives SparkDataControl against the simulated
+    // amp with a continuous mix of actions: preset switches (HW and custom banks), effect
+    // toggles, looper commands and tuner on/off with tuner output streaming in between.
+    // The next action starts when the previous one has been acknowledged (latency trace).
+    // Every sampleInterval the heap (free, minimum free, largest free block), allocations,
+    // container sizes and the latency percentiles are sampled and printed as CSV line.
+    // The first sample after warmupTime is the baseline, the test fails if a later sample
+    // drifts from it by more than the limits below, if the capacity of the command buffer grows
+    // or if actions were started in an interval but none completed (amp stopped answering).
+    // Command 'k' on Serial prints the status.
+
+public:
+    static SparkSoakTest &getInstance();
+
+    SparkSoakTest(const SparkSoakTest &) = delete;
+    SparkSoakTest &operator=(const SparkSoakTest &) = delete;
+
+    // Configures the simulated amp for fast round trips
+    void begin();
+    // Starts the next action and takes samples, to be called in the main loop
+    void update(SparkDataControl &dc);
+    void report();
+
+    bool isFailed() const { return isFailed_; }
+    unsigned long actions() const { return actions_; }
+
+    static const unsigned long warmupTime = 60000;
+    static const unsigned long sampleInterval = 60000;
+    static const unsigned long actionTimeout = 2000;
+    static const unsigned long tunerDuration = 500;
+    // Simulated amp latency during the test in ms
+    static const unsigned long ampLatency = 2;
+
+    // Drift limits compared to the baseline
+    static const uint32_t maxHeapLoss = 4096;
+    static const uint32_t maxLargestBlockLoss = 8192;
+    static const size_t maxPendingAcks = 16;
+    static const size_t maxPendingNotifications = 64;
+    static const uint32_t maxLatencyFactor = 2;
+    static const uint32_t latencyTolerance = 10000; // us
+    static const uint32_t maxAllocationIncrease = 100; // per 100 actions
+    static const uint32_t maxTimeoutIncrease = 1;      // per 100 actions
+
+private:
+    SparkSoakTest() {}
+
+    // Returns false if the action did not send anything
+    bool startAction(SparkDataControl &dc, SoakAction action);
+    void takeSample();
+    // Checks the sample against the baseline, returns the reason of the failure or nullptr
+    const char *checkDrift(const SoakSample &sample) const;
+    void printSample(const SoakSample &sample);
+
+    unsigned long startTimestamp_ = 0;
+    unsigned long lastSampleTimestamp_ = 0;
+    bool isStarted_ = false;
+    bool isFailed_ = false;
+    bool hasBaseline_ = false;
+    SoakSample baseline_;
+    SoakSample lastSample_;
+
+    bool isActionInFlight_ = false;
+    unsigned long actionStart_ = 0;
+    unsigned long completedActions_ = 0;
+    int nextAction_ = 0;
+    int presetStep_ = 0;
+    int fxStep_ = 0;
+    int looperStep_ = 0;
+    bool isTunerOn_ = false;
+    SubMode subModeBeforeTuner_ = SUB_MODE_PRESET;
+    unsigned long tunerStart_ = 0;
+
+    unsigned long actions_ = 0;
+    unsigned long skipped_ = 0;
+    unsigned long timeouts_ = 0;
+    // Latency of the actions since the last sample
+    DurationHistogram latencies_;
+};
+
+#ifdef SOAK_TEST
+#define SOAK_TEST_BEGIN() SparkSoakTest::getInstance().begin()
+#define SOAK_TEST_UPDATE(dc) SparkSoakTest::getInstance().update(dc)
+#else
+#define SOAK_TEST_BEGIN()
+#define SOAK_TEST_UPDATE(dc)
+#endif
+
+#endif
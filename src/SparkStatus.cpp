@@ -31,6 +31,13 @@ void SparkStatus::resetAcknowledgments() {
     acknowledgments_.clear();
 }
 
+void SparkStatus::updateTuner(byte note, float offset) {
+    float scaledOffset = offset * tunerOffsetScale;
+    uint32_t offsetValue = scaledOffset < 0 ? 0 : (scaledOffset > 0xFFFF ? 0xFFFF : (uint32_t)(scaledOffset + 0.5));
+    uint32_t updateCount = (tunerUpdateCount() + 1) & 0xFF;
+    tunerSlot_.store(((uint32_t)note << 24) | (updateCount << 16) | offsetValue);
+}
+
 void SparkStatus::resetVolumeUpdateFlag() {
     isVolumeChanged_ = false;
 }
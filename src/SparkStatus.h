@@ -2,6 +2,7 @@
 #define SPARKCURRENTSTATUS_H
 
 #include "SparkTypes.h"
+#include <atomic>
 
 enum MessageType {
     MSG_TYPE_NONE,
@@ -47,7 +48,7 @@ public:
     SparkStatus &operator=(const SparkStatus &) = delete;
 
     // Preset related methods to make information public
-    const Preset currentPreset() const { return currentPreset_; }
+    const Preset &currentPreset() const { return currentPreset_; }
     Preset &currentPreset() { return currentPreset_; }
 
     const int currentPresetNumber() const { return currentPresetNumber_; }
@@ -62,10 +63,10 @@ public:
     const boolean isLooperSettingUpdated() const { return isLooperSettingUpdated_; }
     boolean &isLooperSettingUpdated() { return isLooperSettingUpdated_; }
 
-    const LooperSetting currentLooperSetting() const { return looperSetting_; }
+    const LooperSetting &currentLooperSetting() const { return looperSetting_; }
     LooperSetting &currentLooperSetting() { return looperSetting_; }
 
-    const Pedal currentEffect() const { return currentEffect_; }
+    const Pedal &currentEffect() const { return currentEffect_; }
     Pedal &currentEffect() { return currentEffect_; }
 
     const boolean isEffectUpdated() const { return isEffectUpdated_; }
@@ -83,10 +84,10 @@ public:
     const byte lastMessageNum() const { return lastMessageNum_; }
     byte &lastMessageNum() { return lastMessageNum_; }
 
-    const string ampName() const { return ampName_; }
+    const string &ampName() const { return ampName_; }
     string &ampName() { return ampName_; }
 
-    const string ampSerialNumber() const { return ampSerialNumber_; }
+    const string &ampSerialNumber() const { return ampSerialNumber_; }
     string &ampSerialNumber() { return ampSerialNumber_; }
 
     const BatteryLevel ampBatteryLevel() const { return ampBatteryLevel_; }
@@ -108,22 +109,26 @@ public:
     float &measure() { return measure_; }
 
     const string noteString() const {
-        if (note_ == 0x0e)
+        byte currentNote = note();
+        if (currentNote == 0x0e)
             return " ";
-        return notes[note_ % 12];
+        return notes[currentNote % 12];
     }
 
-    byte &note() { return note_; }
-
-    const float noteOffset() const { return noteOffset_; }
-    float &noteOffset() { return noteOffset_; }
+    // Tuner values are written from the BLE callback and read in the main loop.
+    // Note, offset and an update counter are packed into one atomic value for that.
+    void updateTuner(byte note, float offset);
+    const byte note() const { return tunerSlot_.load() >> 24; }
+    const float noteOffset() const { return (tunerSlot_.load() & 0xFFFF) / tunerOffsetScale; }
+    // Incremented with each tuner update, used to detect new values
+    const uint8_t tunerUpdateCount() const { return (tunerSlot_.load() >> 16) & 0xFF; }
 
     const vector<byte> hwChecksums() const { return hwChecksums_; }
     vector<byte> &hwChecksums() { return hwChecksums_; }
 
-    const int noteOffsetCents() const { return (noteOffset_ * 100) - 50; }
+    const int noteOffsetCents() const { return (noteOffset() * 100) - 50; }
 
-    const vector<AckData> acknowledgments() const { return acknowledgments_; }
+    const vector<AckData> &acknowledgments() const { return acknowledgments_; }
     vector<AckData> &acknowledgments() { return acknowledgments_; }
 
     void resetPresetNumberUpdateFlag();
@@ -147,8 +152,9 @@ private:
     string ampName_ = "";
     float measure_;
 
-    byte note_;
-    float noteOffset_;
+    // Bits 31-24: note, 23-16: update counter, 15-0: offset (0.0 - 1.0) scaled by tunerOffsetScale
+    atomic<uint32_t> tunerSlot_{0};
+    static constexpr float tunerOffsetScale = 10000.0;
     string notes[12] = {"C ", "C#", "D ", "D#", "E ", "F ", "F#", "G ", "G#", "A ", "A#", "B "};
 
     // In case a preset was received from Spark, it is saved here. Can then be read by main program
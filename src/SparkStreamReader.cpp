@@ -7,23 +7,152 @@
 
 #include "SparkStreamReader.h"
 
-SparkStreamReader::SparkStreamReader() : message{}, unstructuredData{}, msgData{}, msgPos(0) {
+const byte SparkStreamReader::endMarker;
+
+SparkStreamReader::SparkStreamReader() : message{}, unstructuredData{}, msgData(nullptr), msgPos(0) {
 }
 
 string SparkStreamReader::getJson() {
+    if (!hasJson()) {
+        return "";
+    }
+    StringBuilder sb;
+    writeJson(sb);
     return sb.getJson();
 }
 
+bool SparkStreamReader::hasJson() const {
+    switch (statusObject.lastMessageType()) {
+    case MSG_TYPE_PRESET:
+    case MSG_TYPE_LOOPER_SETTING:
+    case MSG_TYPE_FX_PARAM:
+    case MSG_TYPE_FX_CHANGE:
+    case MSG_TYPE_FX_ONOFF:
+    case MSG_TYPE_HWPRESET:
+    case MSG_TYPE_HWCHECKSUM:
+    case MSG_TYPE_LOOPER_STATUS:
+    case MSG_TYPE_TAP_TEMPO:
+    case MSG_TYPE_MEASURE:
+    case MSG_TYPE_TUNER_OUTPUT:
+    case MSG_TYPE_TUNER_ON:
+    case MSG_TYPE_TUNER_OFF:
+    case MSG_TYPE_AMP_SERIAL:
+    case MSG_TYPE_INPUT_VOLUME:
+    case MSG_TYPE_AMP_NAME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SparkStreamReader::writeJson(Print &out) {
+    StringBuilder sb(out);
+    writeJson(sb);
+}
+
+void SparkStreamReader::writeJson(StringBuilder &sb) {
+    // Messages are only decoded into structured data,
+    // the string representation is built when requested
+    switch (statusObject.lastMessageType()) {
+    case MSG_TYPE_PRESET:
+        statusObject.currentPreset().writeJson(sb);
+        return;
+    case MSG_TYPE_LOOPER_SETTING:
+        statusObject.currentLooperSetting().writeJson(sb);
+        return;
+    default:
+        break;
+    }
+    sb.startStr();
+    switch (statusObject.lastMessageType()) {
+    case MSG_TYPE_FX_PARAM:
+        sb.addStr("Effect", lastEffect_);
+        sb.addSeparator();
+        sb.addInt("Parameter", lastParameter_);
+        sb.addSeparator();
+        sb.addFloat("Value", lastValue_);
+        break;
+    case MSG_TYPE_FX_CHANGE:
+        sb.addStr("OldEffect", lastEffect_);
+        sb.addSeparator();
+        sb.addNewline();
+        sb.addStr("NewEffect", lastNewEffect_);
+        break;
+    case MSG_TYPE_FX_ONOFF:
+        sb.addStr("Effect", statusObject.currentEffect().name);
+        sb.addSeparator();
+        sb.addBool("IsOn", statusObject.currentEffect().isOn);
+        break;
+    case MSG_TYPE_HWPRESET:
+        sb.addInt(lastHWPresetStored_ ? "NewStoredPreset" : "New HW Preset number", lastHWPresetNumber_);
+        break;
+    case MSG_TYPE_HWCHECKSUM: {
+        const vector<byte> &checksums = statusObject.hwChecksums();
+        for (int i = 0; i < checksums.size(); i++) {
+            string title = "Checksum Preset " + to_string(i + 1);
+            sb.addStr(title.c_str(), SparkHelper::intToHex(checksums[i]));
+            if (i < checksums.size() - 1) {
+                sb.addSeparator();
+            }
+        }
+        break;
+    }
+    case MSG_TYPE_LOOPER_STATUS:
+        sb.addInt("BPM", lastLooperStatus_[0]);
+        sb.addSeparator();
+        sb.addInt("Count", lastLooperStatus_[1]);
+        sb.addSeparator();
+        sb.addInt("Bars", lastLooperStatus_[2]);
+        sb.addSeparator();
+        sb.addInt("Loops", lastLooperStatus_[3]);
+        sb.addSeparator();
+        sb.addStr("Unknown OnOff1", SparkHelper::intToHex(lastLooperStatus_[4]));
+        sb.addSeparator();
+        sb.addStr("Unknown OnOff2", SparkHelper::intToHex(lastLooperStatus_[5]));
+        break;
+    case MSG_TYPE_TAP_TEMPO:
+        sb.addFloat("BPM", lastValue_);
+        break;
+    case MSG_TYPE_MEASURE:
+        sb.addFloat("Measure", statusObject.measure());
+        break;
+    case MSG_TYPE_TUNER_OUTPUT:
+        sb.addInt("Note", statusObject.note());
+        sb.addSeparator();
+        sb.addFloat("Offset", statusObject.noteOffset());
+        break;
+    case MSG_TYPE_TUNER_ON:
+    case MSG_TYPE_TUNER_OFF:
+        sb.addBool("Tuner mode", statusObject.lastMessageType() == MSG_TYPE_TUNER_ON);
+        break;
+    case MSG_TYPE_AMP_SERIAL:
+        sb.addStr("Serial Number", statusObject.ampSerialNumber());
+        break;
+    case MSG_TYPE_INPUT_VOLUME:
+        sb.addFloat("Input Volume", statusObject.inputVolume());
+        break;
+    case MSG_TYPE_AMP_NAME:
+        sb.addStr("Amp Name", statusObject.ampName());
+        break;
+    default:
+        // No string representation for this message, see hasJson()
+        break;
+    }
+    sb.endStr();
+}
+
 void SparkStreamReader::setMessage(const vector<ByteVector> &msg_) {
     unstructuredData = msg_;
     message.clear();
 }
 
 byte SparkStreamReader::readByte() {
-    byte aByte;
-    aByte = msgData[msgPos];
-    msgPos += 1;
-    return aByte;
+    // Reading beyond the payload of a truncated message returns 0
+    if (msgPos >= (int)msgData->size()) {
+        isReadPastEnd_ = true;
+        return 0;
+    }
+    return (*msgData)[msgPos++];
 }
 
 string SparkStreamReader::readPrefixedString() {
@@ -33,7 +162,7 @@ string SparkStreamReader::readPrefixedString() {
     int realStrLength = readByte() - 0xa0;
     string aStr = "";
     // reading string
-    for (int i = 0; i < realStrLength; i++) {
+    for (int i = 0; i < realStrLength && !isReadPastEnd_; i++) {
         aStr += char(readByte());
     }
     return aStr;
@@ -53,7 +182,7 @@ string SparkStreamReader::readString() {
     }
 
     string aStr = "";
-    for (int i = 0; i < strLength; i++) {
+    for (int i = 0; i < strLength && !isReadPastEnd_; i++) {
         aStr += char(readByte());
     }
     return aStr;
@@ -101,16 +230,10 @@ void SparkStreamReader::readEffectParameter() {
     byte param = readByte();
     float val = readFloat();
 
-    // Build string representations
-    sb.startStr();
-    sb.addStr("Effect", effect);
-    sb.addSeparator();
-    sb.addInt("Parameter", param);
-    sb.addSeparator();
-    sb.addFloat("Value", val);
-    sb.endStr();
-
     // Set values
+    lastEffect_ = effect;
+    lastParameter_ = param;
+    lastValue_ = val;
     statusObject.lastMessageType() = MSG_TYPE_FX_PARAM;
 }
 
@@ -118,16 +241,11 @@ void SparkStreamReader::readEffect() {
     // Read object
     string effect1 = readPrefixedString();
     string effect2 = readPrefixedString();
-
-    // Build string representations
-    sb.startStr();
-    sb.addStr("OldEffect", effect1);
-    sb.addSeparator();
-    sb.addNewline();
-    sb.addStr("NewEffect", effect2);
-    sb.endStr();
+    checkEffect(effect2);
 
     // Set values
+    lastEffect_ = effect1;
+    lastNewEffect_ = effect2;
     statusObject.lastMessageType() = MSG_TYPE_FX_CHANGE;
 }
 
@@ -136,12 +254,9 @@ void SparkStreamReader::readHardwarePreset() {
     readByte();
     byte presetNum = readByte() + 1;
 
-    // Build string representations
-    sb.startStr();
-    sb.addInt("New HW Preset number", presetNum);
-    sb.endStr();
-
     // Set values
+    lastHWPresetNumber_ = presetNum;
+    lastHWPresetStored_ = false;
     if (presetNum != statusObject.currentPresetNumber()) {
         statusObject.isPresetNumberUpdated() = true;
     }
@@ -152,7 +267,6 @@ void SparkStreamReader::readHardwarePreset() {
 void SparkStreamReader::readHWChecksums(byte subCmd) {
 
     vector<byte> checksums;
-    sb.startStr();
 
     // determine number of HW presets based on amp type (subCmd)
     int numberOfPresets;
@@ -167,12 +281,7 @@ void SparkStreamReader::readHWChecksums(byte subCmd) {
     for (int i = 0; i < numberOfPresets; i++) {
         int sum = readInt();
         checksums.push_back(sum);
-        sb.addStr("Checksum Preset " + to_string(i + 1), SparkHelper::intToHex(sum));
-        if (i < numberOfPresets - 1) {
-            sb.addSeparator();
-        }
     }
-    sb.endStr();
 
     statusObject.hwChecksums() = checksums;
     statusObject.lastMessageType() = MSG_TYPE_HWCHECKSUM;
@@ -183,12 +292,9 @@ void SparkStreamReader::readStoreHardwarePreset() {
     readByte();
     byte presetNum = readByte() + 1;
 
-    // Build string representations
-    sb.startStr();
-    sb.addInt("NewStoredPreset", presetNum);
-    sb.endStr();
-
     // Set values
+    lastHWPresetNumber_ = presetNum;
+    lastHWPresetStored_ = true;
     statusObject.lastMessageType() = MSG_TYPE_HWPRESET;
 }
 
@@ -199,28 +305,41 @@ void SparkStreamReader::readEffectOnOff() {
 
     statusObject.currentEffect().name = effect;
     statusObject.currentEffect().isOn = isOn;
-    // Build string representations
-    sb.startStr();
-    sb.addStr("Effect", effect);
-    sb.addSeparator();
-    sb.addBool("IsOn", isOn);
-    sb.endStr();
+    checkEffect(statusObject.currentEffect().name);
 
     // Set values
     statusObject.lastMessageType() = MSG_TYPE_FX_ONOFF;
     statusObject.isEffectUpdated() = true;
 }
 
+void SparkStreamReader::checkEffect(const EffectName &effect, FxType expectedType) {
+    if (!effect.isKnown()) {
+        LOG_INFO("WARNING: Unknown effect %s, not in effect catalog\n", effect.c_str());
+        return;
+    }
+    if (expectedType != INDEX_FX_INVALID && effect.fxType() != expectedType) {
+        DEBUG_PRINTF("Effect %s at unexpected position %d\n", effect.c_str(), expectedType);
+    }
+}
+
+void SparkStreamReader::checkParameters(const EffectName &effect, int numParameters) {
+    if (effect.isKnown() && numParameters > effect.numParameters()) {
+        LOG_INFO("WARNING: Effect %s has %d parameters, %d in effect catalog\n", effect.c_str(), numParameters,
+                 effect.numParameters());
+    }
+}
+
 void SparkStreamReader::readPreset() {
     // Read object (Preset main data)
     // DEBUG_PRINTF("Free memory before reading preset: %d\n", xPortGetFreeHeapSize());
 
     /*DEBUG_PRINTLN("Parsing message:");
-    DEBUG_PRINTVECTOR(msgData);
+    DEBUG_PRINTVECTOR(*msgData);
     DEBUG_PRINTLN();
     */
 
-    Preset &currentPreset = statusObject.currentPreset();
+    // Parsed into a copy, so a truncated preset does not replace the current one
+    Preset currentPreset;
 
     readByte();
     byte preset = readByte();
@@ -244,53 +363,28 @@ void SparkStreamReader::readPreset() {
     float bpm = readFloat();
     // DEBUG_PRINTF("Read BPM: %f\n", bpm);
     currentPreset.bpm = bpm;
-    // Build string representations
-    // DEBUG_PRINTF("Free memory before adds: %d\n", xPortGetFreeHeapSize());
-    sb.startStr();
-    sb.addInt("PresetNumber", preset);
-    sb.addSeparator();
-    sb.addStr("UUID", uuid);
-    sb.addSeparator();
-    sb.addNewline();
-    sb.addStr("Name", name);
-    sb.addSeparator();
-    sb.addStr("Version", version);
-    sb.addSeparator();
-    sb.addStr("Description", descr);
-    sb.addSeparator();
-    sb.addStr("Icon", icon);
-    sb.addSeparator();
-    sb.addFloat("BPM", bpm, "python");
-    sb.addSeparator();
-    sb.addNewline();
-    // DEBUG_PRINTF("Free memory after adds: %d\n", xPortGetFreeHeapSize());
-    //  Read Pedal data (including string representations)
+    //  Read Pedal data
 
     // !!! number of pedals not used currently, assumed constant as 7 !!!
     // int num_effects = readByte() - 0x90;
     // DEBUG_PRINTF("Read Number of effects: %d\n", num_effects);
-    sb.addPython("\"Pedals\": [");
-    sb.addNewline();
     currentPreset.pedals = {};
     int numberOfPedals = currentPreset.numberOfPedals;
+    int ignoredParameters = 0;
     for (int i = 0; i < numberOfPedals; i++) { // Fixed to 7, but could maybe also be derived from num_effects?
         Pedal currentPedal = {};
         // DEBUG_PRINTF("Reading Pedal %d:\n", i);
         string eStr = readString();
         // DEBUG_PRINTF("  Pedal name: %s\n", eStr.c_str());
         currentPedal.name = eStr;
+        checkEffect(currentPedal.name, (FxType)i);
         boolean eOnOff = readOnOff();
         // DEBUG_PRINTF("  Pedal state: %s\n", eOnOff);
         currentPedal.isOn = eOnOff;
-        sb.addPython("{");
-        sb.addStr("Name", eStr);
-        sb.addSeparator();
-        sb.addBool("IsOn", eOnOff);
-        sb.addSeparator();
-        int numOfParameters = readByte() - char(0x90);
+        int numOfParameters = readByte() - 0x90;
+        checkParameters(currentPedal.name, numOfParameters);
         // DEBUG_PRINTF("  Number of Parameters: %d\n", numOfParameters);
         // DEBUG_PRINTF("Free memory before parameters: %d\n", xPortGetFreeHeapSize());
-        sb.addPython("\"Parameters\":[");
         // Read parameters of current pedal
         currentPedal.parameters = {};
         for (int p = 0; p < numOfParameters; p++) {
@@ -307,38 +401,26 @@ void SparkStreamReader::readPreset() {
             currentParameter.number = num;
             currentParameter.special = spec;
             currentParameter.value = val;
-            // sb.addInt("Parameter", num, "python");
-            // sb.addStr("Special", SparkHelper::intToHex(spec), "python");
-            // sb.addFloat("Value", val, "python");
-            sb.addFloatPure(val, "python");
-            if (p < numOfParameters - 1) {
-                sb.addSeparator();
+            if (!currentPedal.parameters.push_back(currentParameter)) {
+                ignoredParameters++;
             }
-            currentPedal.parameters.push_back(currentParameter);
             // DEBUG_PRINTF("Free memory after reading preset: %d\n", xPortGetFreeHeapSize());
         }
 
-        sb.addPython("]");
-        // deleteIndent();
-        sb.addPython("}");
-        if (i < numberOfPedals - 1) {
-            sb.addSeparator();
-            sb.addNewline();
-        }
         currentPreset.pedals.push_back(currentPedal);
     }
-    sb.addPython("],");
-    sb.addNewline();
     byte chksum = readByte();
     currentPreset.checksum = chksum;
-    sb.addStr("Checksum", SparkHelper::intToHex(chksum));
-    sb.addNewline();
-    sb.endStr();
-    currentPreset.text = sb.getText();
-    currentPreset.raw = sb.getRaw();
-    currentPreset.json = sb.getJson();
     currentPreset.isEmpty = false;
 
+    if (ignoredParameters > 0) {
+        LOG_ERROR("ERROR: Preset has %d parameters more than supported, ignored\n", ignoredParameters);
+    }
+    if (isReadPastEnd_) {
+        LOG_ERROR("ERROR: Preset message is truncated, ignoring\n");
+        return;
+    }
+    statusObject.currentPreset() = currentPreset;
     statusObject.isPresetUpdated() = true;
     statusObject.lastMessageType() = MSG_TYPE_PRESET;
 }
@@ -346,7 +428,7 @@ void SparkStreamReader::readPreset() {
 void SparkStreamReader::readLooperSettings() {
 
     DEBUG_PRINT("Reading looper settings:");
-    DEBUG_PRINTVECTOR(msgData);
+    DEBUG_PRINTVECTOR(*msgData);
     DEBUG_PRINTLN();
 
     int bpm = readByte();
@@ -363,23 +445,6 @@ void SparkStreamReader::readLooperSettings() {
     bool unknownOnOff = readOnOff();
     unsigned int maxDuration = readInt16();
 
-    // Build string representations
-    sb.startStr();
-    sb.addInt("BPM", bpm);
-    sb.addSeparator();
-    sb.addStr("Count", countStr);
-    sb.addSeparator();
-    sb.addInt("Bars", bars);
-    sb.addSeparator();
-    sb.addBool("Free", freeIndicator);
-    sb.addSeparator();
-    sb.addBool("Click", click);
-    sb.addSeparator();
-    sb.addBool("Unknown switch", unknownOnOff);
-    sb.addSeparator();
-    sb.addInt("Max duration", maxDuration);
-    sb.endStr();
-
     LooperSetting &looperSetting = statusObject.currentLooperSetting();
     looperSetting.bpm = bpm;
     looperSetting.countStr = countStr;
@@ -390,10 +455,6 @@ void SparkStreamReader::readLooperSettings() {
     looperSetting.unknownOnOff = unknownOnOff;
     looperSetting.maxDuration = maxDuration;
 
-    looperSetting.json = sb.getJson();
-    looperSetting.text = sb.getText();
-    looperSetting.raw = sb.getRaw();
-
     statusObject.isLooperSettingUpdated() = true;
     statusObject.lastMessageType() = MSG_TYPE_LOOPER_SETTING;
 }
@@ -402,7 +463,7 @@ void SparkStreamReader::readLooperCommand() {
 
     statusObject.lastLooperCommand() = readByte();
     DEBUG_PRINT("Received looper command: ");
-    DEBUG_PRINTVECTOR(msgData);
+    DEBUG_PRINTVECTOR(*msgData);
     DEBUG_PRINTLN();
     statusObject.lastMessageType() = MSG_TYPE_LOOPER_COMMAND;
 }
@@ -417,29 +478,14 @@ void SparkStreamReader::readLooperStatus() {
     bool unknownOnOff1 = readByte();
     bool unknownOnOff2 = readByte();
 
-    sb.startStr();
-    sb.addInt("BPM", bpm);
-    sb.addSeparator();
-    sb.addInt("Count", count);
-    sb.addSeparator();
-    sb.addInt("Bars", bars);
-    sb.addSeparator();
-    sb.addInt("Loops", numberOfLoops);
-    sb.addSeparator();
-    sb.addStr("Unknown OnOff1", SparkHelper::intToHex(unknownOnOff1));
-    sb.addSeparator();
-    sb.addStr("Unknown OnOff2", SparkHelper::intToHex(unknownOnOff2));
-    sb.endStr();
-
+    lastLooperStatus_ = {bpm, count, bars, numberOfLoops, unknownOnOff1, unknownOnOff2};
     statusObject.lastMessageType() = MSG_TYPE_LOOPER_STATUS;
 }
 
 void SparkStreamReader::readTapTempo() {
     float bpm = readFloat();
 
-    sb.startStr();
-    sb.addFloat("BPM", bpm, "python");
-    sb.endStr();
+    lastValue_ = bpm;
     statusObject.lastMessageType() = MSG_TYPE_TAP_TEMPO;
 }
 
@@ -447,34 +493,55 @@ void SparkStreamReader::readMeasure() {
     float measure = readFloat();
     statusObject.measure() = measure;
 
-    sb.startStr();
-    sb.addFloat("Measure", measure, "python");
-    sb.endStr();
     statusObject.lastMessageType() = MSG_TYPE_MEASURE;
 }
 
 void SparkStreamReader::readTuner() {
     byte note = readByte();
     float offset = readFloat();
-    statusObject.note() = note;
-    statusObject.noteOffset() = offset;
+    statusObject.updateTuner(note, offset);
 
-    sb.startStr();
-    sb.addInt("Note", note);
-    sb.addFloat("Offset", offset, "python");
-    sb.endStr();
     statusObject.lastMessageType() = MSG_TYPE_TUNER_OUTPUT;
 }
 
+bool SparkStreamReader::readTunerFrame(const uint8_t *data, size_t length, byte &note, float &offset) {
+    // Skip 01FE header if present
+    if (length > 16 && data[0] == 0x01 && data[1] == 0xFE) {
+        data += 16;
+        length -= 16;
+    }
+    // F0 01 <seq> <chk> 03 64 <7 bit payload> F7
+    if (length != tunerFrameLength || data[0] != 0xF0 || data[1] != 0x01
+        || data[4] != 0x03 || data[5] != 0x64 || data[length - 1] != endMarker) {
+        return false;
+    }
+    // Corrupted frames are left to processBlock(), which counts them
+    if (calculateChecksum(data + 6, length - 7) != data[3]) {
+        return false;
+    }
+    // Payload: bit 8 mask, note, float prefix (CA) and 4 bytes float
+    const uint8_t *payload = data + 6;
+    byte bit8 = payload[0];
+    byte values[6];
+    for (int i = 0; i < 6; i++) {
+        values[i] = payload[i + 1];
+        if (bit8 & (1 << i)) {
+            values[i] |= 0x80;
+        }
+    }
+    if (values[1] != 0xCA) {
+        return false;
+    }
+    note = values[0];
+    uint32_t floatBits = ((uint32_t)values[2] << 24) | ((uint32_t)values[3] << 16) | ((uint32_t)values[4] << 8) | values[5];
+    memcpy(&offset, &floatBits, sizeof(offset));
+    return true;
+}
+
 void SparkStreamReader::readTunerOnOff() {
     // Read object
     boolean isOn = readOnOff();
 
-    // Build string representations
-    sb.startStr();
-    sb.addBool("Tuner mode", isOn);
-    sb.endStr();
-
     // Set values
     if (isOn) {
         statusObject.lastMessageType() = MSG_TYPE_TUNER_ON;
@@ -541,11 +608,6 @@ void SparkStreamReader::readSerialNumber() {
     // Serial number seems to come with additional F7 character at the end
     serialNumber = serialNumber.substr(0, serialNumber.length() - 1);
 
-    // Build string representations
-    sb.startStr();
-    sb.addStr("Serial Number", serialNumber);
-    sb.endStr();
-
     // Set values
     statusObject.lastMessageType() = MSG_TYPE_AMP_SERIAL;
     statusObject.ampSerialNumber() = serialNumber;
@@ -554,10 +616,6 @@ void SparkStreamReader::readSerialNumber() {
 void SparkStreamReader::readInputVolume() {
     // Read object
     float volume = readFloat();
-    // Build string representations
-    sb.startStr();
-    sb.addFloat("Input Volume", volume);
-    sb.endStr();
 
     // Set values
     statusObject.lastMessageType() = MSG_TYPE_INPUT_VOLUME;
@@ -567,16 +625,27 @@ void SparkStreamReader::readInputVolume() {
 
 boolean SparkStreamReader::structureData(bool processHeader) {
 
-    ByteVector blockContent;
-    blockContent.clear();
+    // All temporary data is taken from the arena, only the resulting messages are kept
     message.clear();
 
-    for (auto block : unstructuredData) {
+    size_t headerSize = processHeader ? 16 : 0;
+    int contentSize = 0;
+    for (const ByteVector &block : unstructuredData) {
+        contentSize += block.size() - headerSize;
+    }
+    ScratchByteVector blockContent;
+    blockContent.reserve(contentSize);
+    int corruptBlocks = 0;
+
+    for (const ByteVector &block : unstructuredData) {
 
         // DEBUG_PRINTVECTOR(block);
 
         int blockLength;
         if (processHeader) {
+            if (block.size() <= headerSize) {
+                continue;
+            }
             blockLength = block[6];
         } else {
             blockLength = block.size();
@@ -585,107 +654,78 @@ boolean SparkStreamReader::structureData(bool processHeader) {
         // DEBUG_PRINTF("Read block size %d, %d\n", blockLength, dataSize);
         if (dataSize != blockLength) {
             DEBUG_PRINTF("Data is of size %d and reports %d\n", dataSize, blockLength);
-            Serial.println("Corrupt block:");
-            for (auto by : block) {
-                Serial.print(SparkHelper::intToHex(by).c_str());
-            }
-            Serial.println();
-        }
-        // DEBUG_PRINTLN("Sizes match");
-        ByteVector chunk;
-        if (processHeader) {
-            // Cut away header
-            chunk.assign(block.begin() + 16, block.end());
-        } else {
-            chunk.assign(block.begin(), block.end());
+            corruptBlocks++;
         }
-
-        for (auto chunkByte : chunk) {
-            blockContent.push_back(chunkByte);
-        } // FOR chunkByte
-
-        // DEBUG_PRINTLN("Pushed chunk bytes to block content");
+        // Cut away header
+        blockContent.insert(blockContent.end(), block.begin() + headerSize, block.end());
     } // FOR block
-    DEBUG_PRINTLN();
-    // DEBUG_PRINTLN("...Processed");
+    if (corruptBlocks > 0) {
+        LOG_ERROR("ERROR: %d of %d blocks of the message have a wrong size\n", corruptBlocks, (int)unstructuredData.size());
+    }
 
-    if (blockContent[0] != 0xF0 || blockContent[1] != 0x01) {
-        Serial.println("Invalid block start, ignoring all data");
+    if (blockContent.size() < 2 || blockContent[0] != 0xF0 || blockContent[1] != 0x01) {
+        LOG_ERROR("ERROR: Invalid block start, ignoring all data\n");
         return false;
     }
 
-    // DEBUG_PRINTLN("Data seems correct");
-    //  and split them into chunks now, splitting on each f7
-    vector<ByteVector> chunks;
-    chunks.clear();
-    ByteVector chunkTemp = {};
-    for (byte by : blockContent) {
-        chunkTemp.push_back(by);
-        if (by == 0xf7) {
-            chunks.push_back(chunkTemp);
-            chunkTemp = {};
+    // Split content into chunks on each F7 and convert them to 8 bit.
+    // Multi-chunk messages (cmd/subCmd of 1,1 or 3,1) are collapsed into a single message
+    ScratchByteVector data8bit;
+    ScratchByteVector concatData;
+    data8bit.reserve(contentSize);
+    concatData.reserve(contentSize);
+    int chunkStart = 0;
+    int contentLength = blockContent.size();
+    for (int pos = 0; pos < contentLength; pos++) {
+        if (blockContent[pos] != endMarker) {
+            continue;
+        }
+        const byte *chunk = &blockContent[chunkStart];
+        size_t chunkLength = pos - chunkStart + 1;
+        chunkStart = pos + 1;
+        if (chunkLength < minChunkLength || chunk[0] != 0xF0 || chunk[1] != 0x01) {
+            rejectedChunks_++;
+            continue;
         }
-    }
 
-    vector<CmdData> chunk_8bit = {};
-    for (auto chunk : chunks) {
         statusObject.lastMessageNum() = chunk[2];
         byte thisCmd = chunk[4];
         byte thisSubCmd = chunk[5];
-        ByteVector data7bit = {};
-        data7bit.assign(chunk.begin() + 6, chunk.end() - 1);
+        // payload is between the 6 bytes prefix and F7
+        data8bit.clear();
+        convertDataTo8bit(chunk + 6, chunkLength - 7, data8bit);
 
-        // DEBUG_PRINTLN("Converted to 8bit");
-        CmdData currData;
+        MessageData currData;
         currData.cmd = thisCmd;
         currData.subcmd = thisSubCmd;
-        currData.data = convertDataTo8bit(data7bit);
-
-        chunk_8bit.push_back(currData);
-
-        // now check for mult-chunk messages and collapse their data into a single message
-        // multi-chunk messages are cmd/subCmd of 1,1 or 3,1
-
-        message.clear();
-        ByteVector concatData;
-        concatData.clear();
-        for (CmdData chunkData : chunk_8bit) {
-            thisCmd = chunkData.cmd;
-            thisSubCmd = chunkData.subcmd;
-            ByteVector thisData = chunkData.data;
-            if ((thisCmd == 0x01 || thisCmd == 0x03) && thisSubCmd == 0x01) {
-                // DEBUG_PRINTLN("Multi message");
-                // found a multi-message
-                int numChunks = thisData[0];
-                int thisChunk = thisData[1];
-                ByteVector thisDataSuffix;
-                thisDataSuffix.assign(thisData.begin() + 3, thisData.end());
-                for (auto by : thisDataSuffix) {
-                    concatData.push_back(by);
-                }
-                // if at last chunk of multi-chunk
-                if (thisChunk == numChunks - 1) {
-                    // DEBUG_PRINTLN("Last chunk to process");
-                    currData.cmd = thisCmd;
-                    currData.subcmd = thisSubCmd;
-                    currData.data = concatData;
-
-                    message.push_back(currData);
-                    concatData = {};
-                }
-            } else {
-                // copy old one
-                message.push_back(chunkData);
-            } // else
-        } // For all in 8-bit vector
+        if ((thisCmd == 0x01 || thisCmd == 0x03) && thisSubCmd == 0x01) {
+            // found a multi-message
+            if (data8bit.size() < 3) {
+                rejectedChunks_++;
+                continue;
+            }
+            int numChunks = data8bit[0];
+            int thisChunk = data8bit[1];
+            concatData.insert(concatData.end(), data8bit.begin() + 3, data8bit.end());
+            // if at last chunk of multi-chunk
+            if (thisChunk == numChunks - 1) {
+                currData.data.assign(concatData.begin(), concatData.end());
+                message.push_back(currData);
+                concatData.clear();
+            }
+        } else {
+            currData.data.assign(data8bit.begin(), data8bit.end());
+            message.push_back(currData);
+        }
     } // for all chunks
 
     return true;
 }
 
 void SparkStreamReader::setInterpreter(const ByteVector &_msg) {
-    msgData = _msg;
+    msgData = &_msg;
     msgPos = 0;
+    isReadPastEnd_ = false;
 }
 
 int SparkStreamReader::runInterpreter(byte _cmd, byte _subCmd) {
@@ -714,7 +754,7 @@ int SparkStreamReader::runInterpreter(byte _cmd, byte _subCmd) {
             break;
         default:
             DEBUG_PRINTF("%02x %02x - not handled: ", _cmd, _subCmd);
-            DEBUG_PRINTVECTOR(msgData);
+            DEBUG_PRINTVECTOR(*msgData);
             DEBUG_PRINTLN();
             break;
         }
@@ -840,7 +880,7 @@ int SparkStreamReader::runInterpreter(byte _cmd, byte _subCmd) {
             break;
         default:
             DEBUG_PRINTF("%02x %02x - not handled: ", _cmd, _subCmd);
-            DEBUG_PRINTVECTOR(msgData);
+            DEBUG_PRINTVECTOR(*msgData);
             DEBUG_PRINTLN();
             break;
         }
@@ -861,7 +901,7 @@ int SparkStreamReader::runInterpreter(byte _cmd, byte _subCmd) {
         // unprocessed command (likely the initial ones sent from the app
         DEBUG_PRINTF("Unprocessed: %02x, %02x - ", _cmd,
                      _subCmd);
-        DEBUG_PRINTVECTOR(msgData);
+        DEBUG_PRINTVECTOR(*msgData);
         DEBUG_PRINTLN();
     }
 
@@ -870,7 +910,8 @@ int SparkStreamReader::runInterpreter(byte _cmd, byte _subCmd) {
 
 tuple<bool, byte, byte> SparkStreamReader::needsAck(const ByteVector &blk) {
 
-    if (blk.size() < 22) { // Block is too short, does not need acknowledgement
+    // Block is too short or a fragment without 01FE header, does not need acknowledgement
+    if (blk.size() < 22 || blk[0] != 0x01 || blk[1] != 0xFE) {
         return tuple<bool, byte, byte>(false, 0, 0);
     }
     byte direction[2] = {blk[4], blk[5]};
@@ -891,9 +932,18 @@ tuple<bool, byte, byte> SparkStreamReader::needsAck(const ByteVector &blk) {
     return tuple<bool, byte, byte>(false, 0, 0);
 }
 
+bool SparkStreamReader::getCorruptedMessageAndEmpty(AckData &message) {
+    if (!hasCorruptedMessage_) {
+        return false;
+    }
+    message = corruptedMessage_;
+    hasCorruptedMessage_ = false;
+    return true;
+}
+
 AckData SparkStreamReader::getLastAckAndEmpty() {
     AckData lastAck;
-    vector<AckData> acknowledgments = statusObject.acknowledgments();
+    const vector<AckData> &acknowledgments = statusObject.acknowledgments();
     if (acknowledgments.size() > 0) {
         lastAck = acknowledgments.back();
         statusObject.resetAcknowledgments();
@@ -906,63 +956,150 @@ void SparkStreamReader::preProcessBlock(ByteVector &blk) {
     // Special behavior: When receiving messages from Spark APP, blocks might be split into two.
     // This will reassemble the block by appending to the previous one.
 
-    // Iterate through block and split into F001/F7 chunks into response.
+    // Split block into F001/F7 chunks in response. Bytes outside of chunks (corrupted or
+    // truncated data) are skipped up to the next F001, so the stream resynchronizes there.
+    auto segmentStart = blk.begin();
 
-    // If nothing in response yet or if last read byte was a F7, add block
-    if (response.size() == 0 || lastReadByte == endMarker) {
-        if (blockIsStarted(blk)) {
-            response.push_back(blk);
-            lastReadByte = blk.back();
+    // Complete the last chunk if it was not finished by the previous block
+    if (response.size() > 0 && lastReadByte != endMarker) {
+        auto it = find_if(segmentStart, blk.end(), [](byte b) { return b == endMarker || b == 0xF0; });
+        if (it != blk.end() && *it == 0xF0) {
+            // Next chunk starts before the last one was finished, the last one is truncated
+            rejectLastChunk();
         } else {
-            DEBUG_PRINTLN("Incomplete fragment found, ignoring.");
+            auto segmentEnd = (it != blk.end()) ? it + 1 : blk.end();
+            ByteVector &currentChunk = response.back();
+            currentChunk.insert(currentChunk.end(), segmentStart, segmentEnd);
+            lastReadByte = currentChunk.back();
+            segmentStart = segmentEnd;
+            if (currentChunk.size() > maxChunkLength) {
+                rejectLastChunk();
+            } else if (lastReadByte == endMarker) {
+                finishChunk();
+            }
         }
-        return;
     }
 
-    auto it = blk.begin();
-    ByteVector segment = {};
-    ByteVector currentChunk = {};
-
-    // Search blk for each occurrence of F7 and append to response
-    while (it != blk.end()) {
-        it = find(blk.begin(), blk.end(), endMarker);
-        if (it != blk.end()) {
-            segment.assign(blk.begin(), it + 1);
-            blk.assign(it + 1, blk.end());
-            if (lastReadByte != endMarker) {
-                currentChunk = response.back();
-                currentChunk.insert(currentChunk.end(), segment.begin(), segment.end());
-                response.pop_back();
-                response.push_back(currentChunk);
-                currentChunk = {};
-            } else {
-                response.push_back(segment);
-            }
-            lastReadByte = response.back().back();
+    while (segmentStart != blk.end()) {
+        auto chunkStart = segmentStart;
+        while (chunkStart != blk.end() && !(*chunkStart == 0xF0 && (chunkStart + 1 == blk.end() || *(chunkStart + 1) == 0x01))) {
+            chunkStart++;
+        }
+        if (chunkStart != segmentStart) {
+            DEBUG_PRINTLN("Data outside of chunk found, ignoring.");
+            skippedBytes_ += chunkStart - segmentStart;
+            resyncs_++;
+        }
+        if (chunkStart == blk.end()) {
+            break;
+        }
+        // A remainder without F7 is completed by the next block
+        auto it = find(chunkStart, blk.end(), endMarker);
+        auto segmentEnd = (it != blk.end()) ? it + 1 : blk.end();
+        ByteVector &chunk = addChunk();
+        chunk.assign(chunkStart, segmentEnd);
+        lastReadByte = chunk.back();
+        segmentStart = segmentEnd;
+        if (lastReadByte == endMarker) {
+            finishChunk();
         }
     }
-    // If a remainder is left in blk, append to previous block
-    if (blk.size() > 0) {
-
-        if (lastReadByte != endMarker) {
-            currentChunk = response.back();
-            currentChunk.insert(currentChunk.end(), blk.begin(), blk.end());
-            response.pop_back();
-            response.push_back(currentChunk);
-            currentChunk = {};
-        } else {
-            response.push_back(blk);
+
+    if (response.size() > maxChunksPerMessage) {
+        DEBUG_PRINTLN("Too many chunks without end of message, ignoring.");
+        rejectedChunks_ += response.size();
+        releaseChunks(0, response.size());
+        lastReadByte = endMarker;
+    }
+}
+
+ByteVector &SparkStreamReader::addChunk() {
+    if (spareChunks_.empty()) {
+        response.emplace_back();
+    } else {
+        response.push_back(move(spareChunks_.back()));
+        spareChunks_.pop_back();
+        response.back().clear();
+    }
+    return response.back();
+}
+
+void SparkStreamReader::releaseChunks(size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) {
+        spareChunks_.push_back(move(response[i]));
+    }
+    response.erase(response.begin() + first, response.begin() + last);
+}
+
+void SparkStreamReader::rejectLastChunk() {
+    DEBUG_PRINTLN("Invalid chunk found, ignoring.");
+    releaseChunks(response.size() - 1, response.size());
+    rejectedChunks_++;
+    lastReadByte = endMarker;
+}
+
+void SparkStreamReader::finishChunk() {
+    const ByteVector &chunk = response.back();
+    if (!isValidBlockWithoutHeader(chunk)) {
+        rejectLastChunk();
+        return;
+    }
+    if (calculateChecksum(chunk.data() + 6, chunk.size() - 7) != chunk[3]) {
+        DEBUG_PRINTF("Checksum error in chunk %02x %02x, ignoring.\n", chunk[4], chunk[5]);
+        checksumErrors_++;
+        // The header might be corrupted as well, it is only used to request the message again
+        corruptedMessage_.msgNum = chunk[2];
+        corruptedMessage_.cmd = chunk[4];
+        corruptedMessage_.subcmd = chunk[5];
+        hasCorruptedMessage_ = true;
+        rejectLastChunk();
+        return;
+    }
+    // Multi-chunk messages (01 01 / 03 01), 7 bit payload starts with number of chunks and chunk index
+    if ((chunk[4] == 0x01 || chunk[4] == 0x03) && chunk[5] == 0x01) {
+        if (chunk.size() < minMultiChunkLength) {
+            rejectLastChunk();
+            return;
         }
-        lastReadByte = response.back().back();
+        resyncMultiChunk(chunk[8]);
     }
 }
 
-bool SparkStreamReader::blockIsStarted(ByteVector &blk) {
-    if (blk.size() < 2)
-        return false;
-    bool newStart = (blk[0] == 0xF0 && blk[1] == 0x01);
+bool SparkStreamReader::isMultiChunk(const ByteVector &chunk) {
+    return chunk.size() >= minMultiChunkLength && (chunk[4] == 0x01 || chunk[4] == 0x03) && chunk[5] == 0x01;
+}
+
+void SparkStreamReader::resyncMultiChunk(int thisChunk) {
+    // Chunks of a multi-chunk message arrive in order, a gap means that chunks have been dropped
+    size_t last = response.size() - 1;
+    if (thisChunk == 0) {
+        // Chunks of an earlier message which has not been completed
+        size_t first = last;
+        while (first > 0 && isMultiChunk(response[first - 1])) {
+            first--;
+        }
+        if (first < last) {
+            DEBUG_PRINTLN("Incomplete multi-chunk message found, ignoring.");
+            rejectedChunks_ += last - first;
+            releaseChunks(first, last);
+            resyncs_++;
+        }
+        return;
+    }
+    if (last > 0 && isMultiChunk(response[last - 1]) && response[last - 1][8] == thisChunk - 1) {
+        return;
+    }
+    // Previous chunk is missing, the rest of the message is ignored until the next first chunk
+    rejectLastChunk();
+    resyncs_++;
+}
 
-    return newStart;
+byte SparkStreamReader::calculateChecksum(const byte *payload, size_t length) {
+    byte checksum = 0x00;
+    for (size_t i = 0; i < length; i++) {
+        checksum ^= payload[i];
+    }
+    return checksum;
 }
 
 MessageProcessStatus SparkStreamReader::processBlock(ByteVector &blk) {
@@ -981,7 +1118,7 @@ MessageProcessStatus SparkStreamReader::processBlock(ByteVector &blk) {
     // 2. Build command (response) vector by splitting blocks into F001...F7 blocks
 
     // Remove 01FE header
-    if (blk[0] == 0x01 && blk[1] == 0xFE && blk.size() > 16) {
+    if (blk.size() > 16 && blk[0] == 0x01 && blk[1] == 0xFE) {
         // Block starts with 01FE and is long enough
         // Read meta data of block
         int blkLength = blk[6];
@@ -998,31 +1135,22 @@ MessageProcessStatus SparkStreamReader::processBlock(ByteVector &blk) {
     // Cut blk into chunks and append to response
     preProcessBlock(blk);
 
-    if (response.size() == 0) {
+    // Wait for the rest of the chunk, complete chunks in response have been validated
+    if (response.size() == 0 || lastReadByte != endMarker) {
         return retValue;
     }
 
     // Check if last block is final and which command
-    ByteVector currentBlock = response.back();
-    byte seq = currentBlock[2];
+    const ByteVector &currentBlock = response.back();
     byte cmd = currentBlock[4];
     byte subCmd = currentBlock[5];
 
-    if (!(isValidBlockWithoutHeader(currentBlock))) {
-        /*
-        DEBUG_PRINTLN("Block not ready for processing, skipping further processing.");
-        DEBUG_PRINTVECTOR(currentBlock);
-        DEBUG_PRINTLN();
-        */
-        return retValue;
-    }
-
     // Check if currentBlock is last block of command
-    // If we don't have a 01 or 03 command with 01/10/38 sub command, we are ready to process
-    if ((cmd != 0x01 && cmd != 0x03) || (subCmd != 01 && subCmd != 10 && subCmd != 38)) {
+    // Only presets (01 01 / 03 01) are sent in multiple chunks, like in structureData()
+    if ((cmd != 0x01 && cmd != 0x03) || subCmd != 0x01) {
         msgLastBlock = true;
     }
-    // Multi-chunk message
+    // Multi-chunk message, chunks are in order (see finishChunk())
     else {
         int numChunks = currentBlock[7];
         int thisChunk = currentBlock[8];
@@ -1034,16 +1162,21 @@ MessageProcessStatus SparkStreamReader::processBlock(ByteVector &blk) {
     // Process data if the block just analyzed was the last
     if (msgLastBlock) {
         msgLastBlock = false;
-        setMessage(response);
+        // Complete message is handed over without copying
+        unstructuredData.swap(response);
+        message.clear();
         DEBUG_PRINT("Message received: ");
-        for (auto chunk : response) {
+        for (const auto &chunk : unstructuredData) {
             DEBUG_PRINTVECTOR(chunk);
             DEBUG_PRINTLN();
         }
 
         readMessage(false);
-        response.clear();
-        lastReadByte = 0x00;
+        // Scratch memory used for parsing is not needed anymore
+        SparkArena::getInstance().reset();
+        // Chunks of the previous message after the swap
+        releaseChunks(0, response.size());
+        lastReadByte = endMarker;
         retValue = MSG_PROCESS_RES_COMPLETE;
     } // msgLastBlock
 
@@ -1059,18 +1192,32 @@ MessageProcessStatus SparkStreamReader::processBlock(ByteVector &blk) {
 }
 
 void SparkStreamReader::interpretData() {
-    for (auto msgData : message) {
-        int thisCmd = msgData.cmd;
-        int thisSubCmd = msgData.subcmd;
-        ByteVector thisData = msgData.data;
-
-        setInterpreter(thisData);
-        runInterpreter(thisCmd, thisSubCmd);
+    for (const MessageData &cmdData : message) {
+        setInterpreter(cmdData.data);
+#ifdef DEBUG
+        unsigned long startTime = micros();
+#endif
+        runInterpreter(cmdData.cmd, cmdData.subcmd);
+        if (isReadPastEnd_) {
+            DEBUG_PRINTF("Message %02x %02x is truncated\n", cmdData.cmd, cmdData.subcmd);
+            truncatedMessages_++;
+        }
+#ifdef DEBUG
+        // Average decoding time, string representations are not built anymore while decoding
+        decodeTimeTotal_ += micros() - startTime;
+        decodeCount_++;
+        if (decodeCount_ % 100 == 0) {
+            SparkArena &arena = SparkArena::getInstance();
+            DEBUG_PRINTF("Decoded %lu messages, average %lu us per message\n", decodeCount_, decodeTimeTotal_ / decodeCount_);
+            DEBUG_PRINTF("Parse arena: max used %d of %d bytes, %lu heap fallbacks. Max heap block: %d\n",
+                         (int)arena.highWaterMark(), (int)SparkArena::arenaSize, arena.fallbackCount(), ESP.getMaxAllocHeap());
+        }
+#endif
     }
     // message.clear();
 }
 
-vector<CmdData> SparkStreamReader::readMessage(bool processHeader) {
+const vector<MessageData> &SparkStreamReader::readMessage(bool processHeader) {
     if (structureData(processHeader)) {
         interpretData();
     }
@@ -1080,11 +1227,11 @@ vector<CmdData> SparkStreamReader::readMessage(bool processHeader) {
 bool SparkStreamReader::isValidBlockWithoutHeader(const ByteVector &blk) {
 
     // Checks done:
-    // 1. Block has a length of at least 3
+    // 1. Block has a length of at least minChunkLength (prefix of 6 bytes and F7)
     // 2. Block starts with F0 01
     // 3. Block ends with F7
 
-    if (blk.size() < 3)
+    if (blk.size() < minChunkLength)
         return false;
     if (blk[0] != 0xF0 || blk[1] != 0x01)
         return false;
@@ -1131,42 +1278,30 @@ unsigned int SparkStreamReader::readInt16() {
 
 void SparkStreamReader::clearMessageBuffer() {
     DEBUG_PRINTLN("Clearing response buffer.");
-    response.clear();
+    releaseChunks(0, response.size());
+    lastReadByte = endMarker;
 }
 
-ByteVector SparkStreamReader::convertDataTo8bit(ByteVector input) {
-    int chunkLength = input.size();
-    // DEBUG_PRINT("Chunk_len:");
-    // DEBUG_PRINTLN(chunkLength);
+void SparkStreamReader::convertDataTo8bit(const byte *input, int chunkLength, ScratchByteVector &data8bit) {
+    // Each sequence of up to 8 bytes starts with a byte holding bit 8 of the following bytes
     int numOfSequences = int((chunkLength + 7) / 8);
-    ByteVector data8bit = {};
 
     for (int thisSequence = 0; thisSequence < numOfSequences; thisSequence++) {
         int seqLength = min(8, chunkLength - (thisSequence * 8));
-        ByteVector seq = {};
         byte bit8 = input[thisSequence * 8];
         for (int ind = 0; ind < seqLength - 1; ind++) {
             byte dat = input[thisSequence * 8 + ind + 1];
             if ((bit8 & (1 << ind)) == (1 << ind)) {
                 dat |= 0x80;
             }
-            seq.push_back(dat);
-        }
-        for (auto by : seq) {
-            data8bit.push_back(by);
+            data8bit.push_back(dat);
         }
     }
-    return data8bit;
 }
 
 void SparkStreamReader::readAmpName() {
     string ampName = readPrefixedString();
 
-    // Build string representations
-    sb.startStr();
-    sb.addStr("Amp Name", ampName);
-    sb.endStr();
-
     // Set values
     statusObject.lastMessageType() = MSG_TYPE_AMP_NAME;
     statusObject.ampName() = ampName;
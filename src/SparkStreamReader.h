@@ -8,11 +8,13 @@
 #ifndef SPARK_STREAM_READER_H // include guard
 #define SPARK_STREAM_READER_H
 
+#include <array>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "Config_Definitions.h"
+#include "SparkArena.h"
 #include "SparkHelper.h"
 #include "SparkStatus.h"
 #include "SparkTypes.h"
@@ -30,24 +32,59 @@ enum MessageProcessStatus {
 class SparkStreamReader {
     // Parser for Spark messages (from App or Amp)
     // -------------------------------------------
+    friend class SparkBenchmarkWorkloads;
 
 private:
-    StringBuilder sb;
     SparkStatus &statusObject = SparkStatus::getInstance();
     // Vector containing struct of cmd, sub_cmd, and payload
-    vector<CmdData> message = {};
+    vector<MessageData> message = {};
     // Unstructured input data, needs to go through structureData first
     vector<ByteVector> unstructuredData = {};
 
-    // payload of a CmdData object to be interpreted. msgPos is pointing at the next byte to read
-    ByteVector msgData;
+    // payload of a MessageData object to be interpreted. msgPos is pointing at the next byte to read
+    const ByteVector *msgData;
     int msgPos;
     // indicator if a block received is the last one
     bool msgLastBlock = false;
     vector<ByteVector> response;
-
-    byte lastReadByte;
-    const byte endMarker = 0xF7;
+    // Buffers of dropped or processed chunks, reused for the next chunks
+    vector<ByteVector> spareChunks_;
+
+    byte lastReadByte = 0xF7;
+    static const byte endMarker = 0xF7;
+    // Shortest chunk: F0 01 <seq> <chk> <cmd> <sub> F7, multi chunks also hold number and index
+    static const size_t minChunkLength = 7;
+    static const size_t minMultiChunkLength = 10;
+    // Limits for reassembly, longer chunks or messages can only be corrupted data
+    static const size_t maxChunkLength = 256;
+    static const size_t maxChunksPerMessage = 64;
+    // Set when the interpreter reads beyond the payload of the current message
+    bool isReadPastEnd_ = false;
+    unsigned long rejectedChunks_ = 0;
+    unsigned long skippedBytes_ = 0;
+    unsigned long truncatedMessages_ = 0;
+    unsigned long checksumErrors_ = 0;
+    unsigned long resyncs_ = 0;
+    // Header of the last chunk dropped for a checksum error, until it is fetched
+    bool hasCorruptedMessage_ = false;
+    AckData corruptedMessage_;
+    // Tuner output frame without header: 6 bytes prefix, 7 bytes payload, end marker
+    static const int tunerFrameLength = 14;
+
+    // Decoded values not kept in SparkStatus, only needed to render the last message on request
+    EffectName lastEffect_;
+    EffectName lastNewEffect_;
+    byte lastParameter_ = 0;
+    float lastValue_ = 0.0;
+    int lastHWPresetNumber_ = 0;
+    bool lastHWPresetStored_ = false;
+    // BPM, count, bars, loops and two unknown values
+    array<int, 6> lastLooperStatus_ = {};
+
+#ifdef DEBUG
+    unsigned long decodeTimeTotal_ = 0;
+    unsigned long decodeCount_ = 0;
+#endif
 
     // Functions to process calls based on identified cmd/sub_cmd.
     void readAmpName();
@@ -69,15 +106,31 @@ private:
     void readAmpStatus();
     void readSerialNumber();
     void readInputVolume();
+    // Reports effects which are not part of the effect catalog
+    void checkEffect(const EffectName &effect, FxType expectedType = INDEX_FX_INVALID);
+    // Reports known effects with more parameters than listed in the effect catalog
+    void checkParameters(const EffectName &effect, int numParameters);
 
     void preProcessBlock(ByteVector &blk);
-    bool blockIsStarted(ByteVector &blk);
+    // Appends an empty chunk to response, the buffer of a spare chunk is reused if there is one
+    ByteVector &addChunk();
+    // Removes the chunks [first, last) from response and keeps their buffers as spare chunks
+    void releaseChunks(size_t first, size_t last);
+    // Drops the last chunk of response, e.g. if it is corrupted
+    void rejectLastChunk();
+    // Checks format and checksum of the last chunk of response once it has been completed
+    void finishChunk();
+    // Drops chunks of multi-chunk messages which are missing previous chunks
+    void resyncMultiChunk(int thisChunk);
+    static bool isMultiChunk(const ByteVector &chunk);
+    // XOR of the 7 bit payload, see SparkMessage::calculateChecksum()
+    static byte calculateChecksum(const byte *payload, size_t length);
 
     // Functions to structure and process input data (high level)
-    vector<CmdData> readMessage(bool processHeader = true);
+    const vector<MessageData> &readMessage(bool processHeader = true);
     boolean structureData(bool processHeader = true);
     void interpretData();
-    ByteVector convertDataTo8bit(ByteVector input);
+    void convertDataTo8bit(const byte *input, int chunkLength, ScratchByteVector &data8bit);
     void setInterpreter(const ByteVector &_msg);
     int runInterpreter(byte _cmd, byte _sub_cmd);
 
@@ -97,14 +150,33 @@ public:
 
     // setting the messag so it can be structured and interpreted
     void setMessage(const vector<ByteVector> &msg_);
-    const vector<CmdData> lastMessage() const { return message; }
+    const vector<MessageData> &lastMessage() const { return message; }
 
+    // Fast path for tuner output (03 64), decodes note and offset directly from the received data
+    // without allocations. Returns false if the data is not exactly one tuner frame.
+    static bool readTunerFrame(const uint8_t *data, size_t length, byte &note, float &offset);
+
+    // String representation of the last decoded message, built on request
     string getJson();
+    // True if the last decoded message has a JSON representation
+    bool hasJson() const;
+    // Writes the JSON representation directly, e.g. to the log
+    void writeJson(Print &out);
+    void writeJson(StringBuilder &sb);
 
     tuple<boolean, byte, byte> needsAck(const ByteVector &block);
     MessageProcessStatus processBlock(ByteVector &block);
     AckData getLastAckAndEmpty();
+    // Returns true and the header of the chunk if a chunk has been dropped for a checksum error
+    bool getCorruptedMessageAndEmpty(AckData &message);
     void clearMessageBuffer();
+
+    // Corrupted or truncated input, counted instead of logged so garbage stays cheap
+    unsigned long rejectedChunks() const { return rejectedChunks_; }
+    unsigned long skippedBytes() const { return skippedBytes_; }
+    unsigned long truncatedMessages() const { return truncatedMessages_; }
+    unsigned long checksumErrors() const { return checksumErrors_; }
+    unsigned long resyncs() const { return resyncs_; }
 };
 
 #endif
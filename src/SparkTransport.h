@@ -0,0 +1,55 @@
+/*
+ * SparkTransport.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: stangreg
+ */
+
+#ifndef SPARK_TRANSPORT_H
+#define SPARK_TRANSPORT_H
+
+#include "SparkTypes.h"
+#include <Arduino.h>
+
+using namespace std;
+
+class SparkTransport {
+    // Connection to the Spark amp (APP mode) or to the Spark app (AMP mode)
+    // ---------------------------------------------------------------------
+    // Blocks are sent with send(). Received data is handed to the receive callback
+    // as it arrives, usually from the task of the Bluetooth stack, so the callback
+    // must not block. Connection changes are reported to the connection callback.
+    // send() is synchronous: SparkDataControl sends one block at a time from the main
+    // loop and the next one when the amp answers, so there is nothing to queue.
+
+public:
+    typedef void (*ReceiveCallback)(const uint8_t *data, size_t length);
+    typedef void (*ConnectionCallback)(bool isConnected);
+
+    virtual ~SparkTransport() {}
+
+    virtual bool isConnected() const = 0;
+    // Sends a block to the other side, returns false if it could not be sent
+    virtual bool send(const BlockData &block) = 0;
+
+    void setReceiveCallback(ReceiveCallback callback) { receiveCallback_ = callback; }
+    void setConnectionCallback(ConnectionCallback callback) { connectionCallback_ = callback; }
+
+protected:
+    void dataReceived(const uint8_t *data, size_t length) {
+        if (receiveCallback_) {
+            receiveCallback_(data, length);
+        }
+    }
+    void connectionChanged(bool isConnected) {
+        if (connectionCallback_) {
+            connectionCallback_(isConnected);
+        }
+    }
+
+private:
+    ReceiveCallback receiveCallback_ = nullptr;
+    ConnectionCallback connectionCallback_ = nullptr;
+};
+
+#endif
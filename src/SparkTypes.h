@@ -9,6 +9,9 @@
 #define SPARK_TYPES_H
 
 #include "Config_Definitions.h"
+#include "InlineVector.h"
+#include "SparkEffectCatalog.h"
+#include "SparkEffects.h"
 #include "SparkHelper.h"
 #include "StringBuilder.h"
 #include <Arduino.h>
@@ -59,25 +62,53 @@ struct KeyboardMapping {
 
 struct Parameter {
 
-    int number = 0;
-    string special = "";
+    uint8_t number = 0;
+    uint8_t special = 0;
     float value = 0.0;
 };
 
+// Effect name, stored as ID of the interned effect names
+class EffectName {
+
+public:
+    EffectName() {}
+    EffectName(const string &name) : id_(SparkEffects::intern(name)) {}
+    EffectName(const char *name) : id_(SparkEffects::intern(name)) {}
+
+    const uint16_t id() const { return id_; }
+    const string &str() const { return SparkEffects::name(id_); }
+    const char *c_str() const { return str().c_str(); }
+    operator const string &() const { return str(); }
+    // Catalog information, see SparkEffects
+    bool isKnown() const { return SparkEffects::isKnown(id_); }
+    FxType fxType() const { return SparkEffects::fxType(id_); }
+    int numParameters() const { return SparkEffects::numParameters(id_); }
+
+    bool operator==(const EffectName &other) const { return id_ == other.id_; }
+    bool operator!=(const EffectName &other) const { return id_ != other.id_; }
+
+private:
+    uint16_t id_ = SparkEffects::noEffect;
+};
+
+// Maximum number of parameters of a single effect (reverb has 8), taken from the effect catalog
+const int MAX_PEDAL_PARAMETERS = MAX_KNOWN_EFFECT_PARAMETERS;
+
 struct Pedal {
 
-    string name = "";
+    EffectName name;
     boolean isOn = false;
-    vector<Parameter> parameters;
+    InlineVector<Parameter, MAX_PEDAL_PARAMETERS> parameters;
 };
 
 struct Preset {
 
     boolean isEmpty = true;
     static const int numberOfPedals = 7;
+    // Typical length of the JSON representation
+    static const int jsonReserveSize = 1024;
 
     Preset() {
-        json = raw = text = "";
         uuid = name = "";
         version = description = icon = "";
         bpm = 0.0;
@@ -95,10 +126,68 @@ struct Preset {
         return false;
     }
 
-    string json;
-    // Raw and text might not be filled (when read from the stored presets).
-    string raw;
-    string text;
+    // JSON representation is built on demand, same format as the preset files
+    string getJson() const {
+        StringBuilder sb(jsonReserveSize);
+        writeJson(sb);
+        return sb.getJson();
+    }
+
+    // Writes the JSON representation directly, e.g. to a file or Serial
+    void writeJson(Print &out) const {
+        StringBuilder sb(out);
+        writeJson(sb);
+    }
+
+    void writeJson(StringBuilder &sb) const {
+        sb.startStr();
+        sb.addInt("PresetNumber", presetNumber);
+        sb.addSeparator();
+        sb.addStr("UUID", uuid);
+        sb.addSeparator();
+        sb.addNewline();
+        sb.addStr("Name", name);
+        sb.addSeparator();
+        sb.addStr("Version", version);
+        sb.addSeparator();
+        sb.addStr("Description", description);
+        sb.addSeparator();
+        sb.addStr("Icon", icon);
+        sb.addSeparator();
+        sb.addFloat("BPM", bpm);
+        sb.addSeparator();
+        sb.addNewline();
+        sb.addPython("\"Pedals\": [");
+        sb.addNewline();
+        int numOfPedals = pedals.size();
+        for (int i = 0; i < numOfPedals; i++) {
+            const Pedal &pedal = pedals[i];
+            sb.addPython("{");
+            sb.addStr("Name", pedal.name);
+            sb.addSeparator();
+            sb.addBool("IsOn", pedal.isOn);
+            sb.addSeparator();
+            sb.addPython("\"Parameters\":[");
+            int numOfParameters = pedal.parameters.size();
+            for (int p = 0; p < numOfParameters; p++) {
+                sb.addFloatPure(pedal.parameters[p].value);
+                if (p < numOfParameters - 1) {
+                    sb.addSeparator();
+                }
+            }
+            sb.addPython("]");
+            sb.addPython("}");
+            if (i < numOfPedals - 1) {
+                sb.addSeparator();
+                sb.addNewline();
+            }
+        }
+        sb.addPython("],");
+        sb.addNewline();
+        sb.addStr("Checksum", SparkHelper::intToHex(checksum));
+        sb.addNewline();
+        sb.endStr();
+    }
 
     int presetNumber = -1;
     string uuid;
@@ -107,18 +196,24 @@ struct Preset {
     string description;
     string icon;
     float bpm;
-    vector<Pedal> pedals;
+    InlineVector<Pedal, numberOfPedals> pedals;
     byte checksum;
 };
 
+// Largest block sent in one write, see SparkMessage::maxBlockSizeToSpark()
+const int MAX_BLOCK_SIZE = 0xAD;
+using BlockData = InlineVector<byte, MAX_BLOCK_SIZE>;
+
+// Block of an outgoing message. The block is stored inline, so building
+// and sending a message does not allocate memory per block.
 struct CmdData {
     byte msgNum = 0x00;
     byte cmd = 0x00;
     byte subcmd = 0x00;
-    ByteVector data = {};
+    BlockData data;
     byte detail = 0;
 
-    string toString() {
+    string toString() const {
         string cmdStr;
         cmdStr = "[" + SparkHelper::intToHex(cmd) + "], [" + SparkHelper::intToHex(subcmd) + "], [" + SparkHelper::intToHex(detail) + "], [";
         for (byte by : data) {
@@ -129,6 +224,14 @@ struct CmdData {
     }
 };
 
+// Message received from the Spark. Payloads of multi-chunk messages
+// (e.g. presets) exceed the block size, so they are kept in a ByteVector.
+struct MessageData {
+    byte cmd = 0x00;
+    byte subcmd = 0x00;
+    ByteVector data = {};
+};
+
 struct AckData {
     byte msgNum = 0x00;
     byte cmd = 0x00;
@@ -154,10 +257,6 @@ struct LooperSetting {
     bool unknownOnOff = false;
     unsigned int maxDuration = 60000;
 
-    string json = "";
-    string text = "";
-    string raw = "";
-
     void reset() {
         bpm = 120;
         count = 0x04;
@@ -208,6 +307,16 @@ struct LooperSetting {
 
     string getJson() const {
         StringBuilder sb;
+        writeJson(sb);
+        return sb.getJson();
+    }
+
+    void writeJson(Print &out) const {
+        StringBuilder sb(out);
+        writeJson(sb);
+    }
+
+    void writeJson(StringBuilder &sb) const {
         sb.startStr();
         sb.addInt("BPM", bpm);
         sb.addSeparator();
@@ -223,8 +332,6 @@ struct LooperSetting {
         sb.addSeparator();
         sb.addInt("Max duration", maxDuration);
         sb.endStr();
-
-        return sb.getJson();
     }
 };
 
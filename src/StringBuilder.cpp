@@ -1,99 +1,79 @@
 #include "StringBuilder.h"
 
+void StringBuilder::writeIndent() {
+    for (int i = 0; i < indent; i++) {
+        out.write('\t');
+    }
+}
+
+void StringBuilder::writeTitle(const char *aTitle) {
+    writeIndent();
+    out.write('"');
+    out.write(aTitle);
+    out.write("\": ");
+}
+
 void StringBuilder::startStr() {
-    text = "";
-    json = "{";
-    raw = "";
-    // dict={};
-    indent = "";
+    json.clear();
+    indent = 0;
+    out.write('{');
 }
 
 void StringBuilder::endStr() {
-    json += "}";
+    out.write('}');
 }
 
 void StringBuilder::addIndent() {
-    indent += "\t";
+    indent++;
 }
 
 void StringBuilder::deleteIndent() {
-    indent.resize(indent.size() - 1);
+    if (indent > 0) {
+        indent--;
+    }
 }
 
 void StringBuilder::addSeparator() {
-    json += ", ";
+    out.write(", ");
 }
 
 void StringBuilder::addNewline() {
-    json += "\n";
+    out.write('\n');
 }
 
-void StringBuilder::addPython(string python_str) {
-    json += indent + python_str; // + "\n";
+void StringBuilder::addPython(const char *python_str) {
+    writeIndent();
+    out.write(python_str);
 }
 
-void StringBuilder::addStr(const string &aTitle, const string &aStr, string nature) {
-    raw += aStr;
-    raw += " ";
-    char stringAdd[200] = "";
-    int size = sizeof stringAdd;
-    snprintf(stringAdd, size, "%s%-20s: %s \n", indent.c_str(), aTitle.c_str(), aStr.c_str());
-    text += stringAdd;
-    if (nature != "python") {
-        json += indent + "\"" + aTitle + "\": \"" + aStr + "\"";
-    }
+void StringBuilder::addStr(const char *aTitle, const string &aStr) {
+    writeTitle(aTitle);
+    out.write('"');
+    out.write(aStr.c_str(), aStr.length());
+    out.write('"');
 }
 
-void StringBuilder::addInt(const string &aTitle, int anInt, string nature) {
-    char stringAdd[100] = "";
+void StringBuilder::addInt(const char *aTitle, int anInt) {
+    char stringAdd[12] = "";
     int size = sizeof stringAdd;
-    snprintf(stringAdd, size, "%d ", anInt);
-    raw += stringAdd;
-    snprintf(stringAdd, size, "%s%-20s: %d\n", indent.c_str(), aTitle.c_str(), anInt);
-    text += stringAdd;
-    if (nature != "python") {
-        snprintf(stringAdd, size, "%s\"%s\": %d", indent.c_str(), aTitle.c_str(), anInt);
-        json += stringAdd;
-    }
+    snprintf(stringAdd, size, "%d", anInt);
+    writeTitle(aTitle);
+    out.write(stringAdd);
 }
 
-void StringBuilder::addFloat(const string &aTitle, float aFloat, string nature) {
-
-    char stringAdd[100] = "";
-    int size = sizeof stringAdd;
-    snprintf(stringAdd, size, "%2.4f ", aFloat);
-    raw += stringAdd;
-    snprintf(stringAdd, size, "%s%-20s: %2.4f\n", indent.c_str(), aTitle.c_str(), aFloat);
-    text += stringAdd;
-    if (nature != "python") {
-        snprintf(stringAdd, size, "%s%2.4f", indent.c_str(), aFloat);
-        json += stringAdd;
-    } else {
-        snprintf(stringAdd, size, "%s\"%s\": %2.4f", indent.c_str(), aTitle.c_str(), aFloat);
-        json += stringAdd;
-    }
+void StringBuilder::addFloat(const char *aTitle, float aFloat) {
+    writeTitle(aTitle);
+    addFloatPure(aFloat);
 }
 
-void StringBuilder::addFloatPure(float aFloat, string nature) {
-    char stringAdd[100] = "";
+void StringBuilder::addFloatPure(float aFloat) {
+    char stringAdd[24] = "";
     int size = sizeof stringAdd;
-    snprintf(stringAdd, size, "%2.4f ", aFloat);
-    raw += stringAdd;
-    snprintf(stringAdd, size, "%2.4f ", aFloat);
-    text += stringAdd;
     snprintf(stringAdd, size, "%2.4f", aFloat);
-    json += stringAdd;
+    out.write(stringAdd);
 }
 
-void StringBuilder::addBool(const string &aTitle, bool aBool, string nature) {
-    char stringAdd[100] = "";
-    int size = sizeof stringAdd;
-    snprintf(stringAdd, size, "%s ", aBool ? "true" : "false");
-    raw += stringAdd;
-    snprintf(stringAdd, size, "%s%s: %-20s\n", indent.c_str(), aTitle.c_str(), aBool ? "true" : "false");
-    text += stringAdd;
-    if (nature != "python") {
-        snprintf(stringAdd, size, "%s\"%s\": %s", indent.c_str(), aTitle.c_str(), aBool ? "true" : "false");
-        json += stringAdd;
-    }
+void StringBuilder::addBool(const char *aTitle, bool aBool) {
+    writeTitle(aTitle);
+    out.write(aBool ? "true" : "false");
 }
@@ -1,19 +1,51 @@
 #ifndef STRINGBUILDER_H
 #define STRINGBUILDER_H
 
+#include <Arduino.h>
 #include <string>
 
 using namespace std;
 
+// Print target appending to a string, used as growable buffer
+class StringSink : public Print {
+
+    string &buffer_;
+
+public:
+    StringSink(string &buffer) : buffer_(buffer) {}
+
+    size_t write(uint8_t c) override {
+        buffer_ += (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t size) override {
+        buffer_.append((const char *)data, size);
+        return size;
+    }
+    using Print::write;
+};
+
 class StringBuilder {
 
-    // String representations of processed data
-    string raw;
-    string text;
-    string indent;
+    // JSON representation of processed data, written to a Print target (e.g. Serial or a File).
+    // Without target, the JSON is collected in an internal buffer (see getJson()).
     string json;
+    StringSink buffer{json};
+    Print &out;
+    int indent = 0;
+
+    void writeIndent();
+    void writeTitle(const char *aTitle);
 
 public:
+    // Collects into the internal buffer, reserveSize is a hint for the expected length
+    StringBuilder(size_t reserveSize = 0) : out(buffer) { json.reserve(reserveSize); }
+    // Writes directly to the target without keeping the JSON
+    StringBuilder(Print &target) : out(target) {}
+
+    StringBuilder(const StringBuilder &) = delete;
+    StringBuilder &operator=(const StringBuilder &) = delete;
+
     // Functions to create string representations of processed data
     void startStr();
     void endStr();
@@ -21,16 +53,15 @@ public:
     void deleteIndent();
     void addSeparator();
     void addNewline();
-    void addPython(string pythonStr);
-    void addStr(const string &aTitle, const string &aStr, string nature = "all");
-    void addInt(const string &aTitle, int anInt, string nature = "all");
-    void addFloat(const string &aTitle, float aFloat, string nature = "all");
-    void addFloatPure(float aFloat, string nature = "all");
-    void addBool(const string &aTitle, bool aBool, string nature = "all");
-
-    const string getJson() const { return json; }
-    const string getRaw() const { return raw; }
-    const string getText() const { return text; }
+    void addPython(const char *pythonStr);
+    void addStr(const char *aTitle, const string &aStr);
+    void addInt(const char *aTitle, int anInt);
+    void addFloat(const char *aTitle, float aFloat);
+    void addFloatPure(float aFloat);
+    void addBool(const char *aTitle, bool aBool);
+
+    // Empty when writing to a target
+    const string &getJson() const { return json; }
 };
 
-#endif
\ No newline at end of file
+#endif